@@ -46,6 +46,8 @@ Revision History:
 #include "sat/tactic/sat2goal.h"
 #include "cmd_context/extra_cmds/proof_cmds.h"
 #include "solver/simplifier_solver.h"
+#include "solver/query_cache_solver.h"
+#include "solver/solver_binary.h"
 
 
 extern "C" {
@@ -142,6 +144,18 @@ extern "C" {
         m_solver->assert_expr(e, t);
     }
 
+    void Z3_solver_ref::push() {
+        m_scope_lim.push_back(m_solver->get_num_assertions());
+        m_solver->push();
+        if (m_pp) m_pp->push();
+    }
+
+    void Z3_solver_ref::pop(unsigned n) {
+        m_solver->pop(n);
+        if (m_pp) m_pp->pop(n);
+        m_scope_lim.shrink(m_scope_lim.size() - std::min(n, m_scope_lim.size()));
+    }
+
     static void init_solver_core(Z3_context c, Z3_solver _s) {
         Z3_solver_ref * s = to_solver(_s);
         bool proofs_enabled = true, models_enabled = true, unsat_core_enabled = false;
@@ -150,12 +164,14 @@ extern "C" {
         if (!s->m_solver_factory)
             s->m_solver_factory = mk_smt_solver_factory();
         s->m_solver = (*(s->m_solver_factory))(mk_c(c)->m(), p, proofs_enabled, models_enabled, unsat_core_enabled, s->m_logic);
+        s->m_scope_lim.reset();
         
         param_descrs r;
         s->m_solver->collect_param_descrs(r);
         context_params::collect_solver_param_descrs(r);
         p.validate(r);
         s->m_solver->updt_params(p);
+        s->m_solver = mk_query_cache_solver(s->m_solver.get());
     }
 
     static void init_solver(Z3_context c, Z3_solver s) {
@@ -394,6 +410,34 @@ extern "C" {
         Z3_CATCH;
     }
 
+    void Z3_API Z3_solver_from_binary(Z3_context c, Z3_solver s, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_solver_from_binary(c, s, file_name);
+        RESET_ERROR_CODE();
+        std::ifstream is(file_name, std::ios::binary);
+        if (!is) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        std::string data((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+        init_solver(c, s);
+        ast_manager& m = mk_c(c)->m();
+        ast_binary_reader in(m, data.data(), data.size());
+        expr_ref_vector fmls(m);
+        unsigned_vector scope_lim;
+        binary2assertions(in, fmls, scope_lim);
+        Z3_solver_ref* r = to_solver(s);
+        unsigned i = 0;
+        for (unsigned lim : scope_lim) {
+            for (; i < lim; ++i)
+                r->assert_expr(fmls.get(i));
+            r->push();
+        }
+        for (; i < fmls.size(); ++i)
+            r->assert_expr(fmls.get(i));
+        Z3_CATCH;
+    }
+
     Z3_string Z3_API Z3_solver_get_help(Z3_context c, Z3_solver s) {
         Z3_TRY;
         LOG_Z3_solver_get_help(c, s);
@@ -453,6 +497,11 @@ extern "C" {
             }
             params.validate(r);
             to_solver_ref(s)->updt_params(params);
+            // a query cache that is enabled after the solver was created
+            // can only wrap it while it has no assertions.
+            solver* s0 = to_solver_ref(s);
+            if (s0->get_num_assertions() == 0 && s0->get_scope_level() == 0)
+                to_solver(s)->m_solver = mk_query_cache_solver(s0);
         }
         auto& solver = *to_solver(s);        
         solver.m_params.append(params);
@@ -486,8 +535,7 @@ extern "C" {
         LOG_Z3_solver_push(c, s);
         RESET_ERROR_CODE();
         init_solver(c, s);
-        to_solver_ref(s)->push();
-        if (to_solver(s)->m_pp) to_solver(s)->m_pp->push();
+        to_solver(s)->push();
         Z3_CATCH;
     }
 
@@ -504,10 +552,8 @@ extern "C" {
             SET_ERROR_CODE(Z3_IOB, nullptr);
             return;
         }
-        if (n > 0) {
-            to_solver_ref(s)->pop(n);
-            if (to_solver(s)->m_pp) to_solver(s)->m_pp->pop(n);
-        }
+        if (n > 0)
+            to_solver(s)->pop(n);
         Z3_CATCH;
     }
 
@@ -526,6 +572,7 @@ extern "C" {
         } scoped_max_memory;
         to_solver(s)->m_solver = nullptr;
         to_solver(s)->m_cmd_context = nullptr;
+        to_solver(s)->m_scope_lim.reset();
         if (to_solver(s)->m_pp) to_solver(s)->m_pp->reset();
         Z3_CATCH;
     }
@@ -824,6 +871,22 @@ extern "C" {
         Z3_CATCH_RETURN("");
     }
 
+    void Z3_API Z3_solver_to_binary(Z3_context c, Z3_solver s, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_solver_to_binary(c, s, file_name);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        ast_binary_writer out(mk_c(c)->m());
+        solver2binary(*to_solver_ref(s), to_solver(s)->m_scope_lim, out);
+        std::ofstream os(file_name, std::ios::binary);
+        if (!os) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        os.write(out.data().data(), out.data().size());
+        Z3_CATCH;
+    }
+
     Z3_string Z3_API Z3_solver_to_dimacs_string(Z3_context c, Z3_solver s, bool include_names) {
         Z3_TRY;
         LOG_Z3_solver_to_string(c, s);
@@ -48,6 +48,7 @@ struct Z3_solver_ref : public api::object {
     scoped_ptr<cmd_context>    m_cmd_context;
     mutex                      m_mux;
     event_handler*             m_eh;
+    unsigned_vector            m_scope_lim;   // number of assertions when each scope was pushed
 
     Z3_solver_ref(api::context& c, solver_factory * f): 
         api::object(c), m_solver_factory(f), m_solver(nullptr), m_logic(symbol::null), m_eh(nullptr) {}
@@ -57,6 +58,8 @@ struct Z3_solver_ref : public api::object {
 
     void assert_expr(expr* e);
     void assert_expr(expr* e, expr* t);
+    void push();
+    void pop(unsigned n);
     void set_eh(event_handler* eh);
     void set_cancel();
 
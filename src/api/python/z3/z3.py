@@ -7872,6 +7872,14 @@ class Solver(Z3PPObject):
         """Parse assertions from a string"""
         Z3_solver_from_string(self.ctx.ref(), self.solver, s)
 
+    def from_binary(self, filename):
+        """Load assertions from a file written by to_binary"""
+        Z3_solver_from_binary(self.ctx.ref(), self.solver, filename)
+
+    def to_binary(self, filename):
+        """Save assertions to a file in a compact binary format"""
+        Z3_solver_to_binary(self.ctx.ref(), self.solver, filename)
+
     def cube(self, vars=None):
         """Get set of cubes
         The method takes an optional set of variables that restrict which
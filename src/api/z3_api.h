@@ -7241,6 +7241,20 @@ extern "C" {
     */
     void Z3_API Z3_solver_from_string(Z3_context c, Z3_solver s, Z3_string str);
 
+    /**
+       \brief load solver assertions from a file written by #Z3_solver_to_binary.
+
+       The file must be written by a Z3 build with the same theories.
+       The assertions are added in the scopes they were saved in, on top
+       of the current scopes of \c s.
+
+       \sa Z3_solver_to_binary
+       \sa Z3_solver_from_file
+
+       def_API('Z3_solver_from_binary', VOID, (_in(CONTEXT), _in(SOLVER), _in(STRING)))
+    */
+    void Z3_API Z3_solver_from_binary(Z3_context c, Z3_solver s, Z3_string file_name);
+
     /**
        \brief Return the set of asserted formulas on the solver.
 
@@ -7654,6 +7668,20 @@ extern "C" {
     */
     Z3_string Z3_API Z3_solver_to_string(Z3_context c, Z3_solver s);
 
+    /**
+       \brief Save the solver assertions to a file in a compact binary format.
+
+       Shared sub-terms are written once, which makes the file smaller and
+       faster to load than the SMT-LIB2 text produced by #Z3_solver_to_string.
+       The scopes of the solver are saved with its assertions.
+       Assertions that use datatypes are not supported and raise an error.
+
+       \sa Z3_solver_from_binary
+
+       def_API('Z3_solver_to_binary', VOID, (_in(CONTEXT), _in(SOLVER), _in(STRING)))
+    */
+    void Z3_API Z3_solver_to_binary(Z3_context c, Z3_solver s, Z3_string file_name);
+
     /**
        \brief Convert a solver into a DIMACS formatted string.
        \sa Z3_goal_to_dimacs_string for requirements.
@@ -82,6 +82,7 @@ app * arith_decl_plugin::mk_numeral(algebraic_numbers::manager& m, algebraic_num
         if (is_int) {
             m_manager->raise_exception("invalid irrational value passed as an integer");
         }
+        ast_manager::plugin_lock lock(*m_manager);
         unsigned idx = aw().mk_id(val);
         parameter p(idx, true);
         SASSERT(p.is_external());
@@ -427,6 +428,7 @@ app * arith_decl_plugin::mk_numeral(rational const & val, bool is_int) {
     if (val.is_unsigned()) {
         unsigned u_val = val.get_unsigned();
         if (u_val < MAX_SMALL_NUM_TO_CACHE) {
+            ast_manager::plugin_lock lock(*m_manager);
             if (is_int && !m_convert_int_numerals_to_real) {
                 app * r = m_small_ints.get(u_val, 0);
                 if (r == nullptr) {
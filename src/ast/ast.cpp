@@ -1301,6 +1301,12 @@ void ast_manager::update_fresh_id(ast_manager const& m) {
     m_fresh_id = std::max(m_fresh_id, m.m_fresh_id);
 }
 
+unsigned ast_manager::next_fresh_id() {
+    if (m_concurrent)
+        return std::atomic_ref<unsigned>(m_fresh_id).fetch_add(1, std::memory_order_relaxed);
+    return m_fresh_id++;
+}
+
 
 void ast_manager::init() {
     m_int_real_coercions = true;
@@ -1353,6 +1359,7 @@ static void mark_array_ref(ast_mark& mark, unsigned sz, parameter const * a) {
 
 ast_manager::~ast_manager() {
     SASSERT(is_format_manager() || !m_family_manager.has_family(symbol("format")));
+    set_concurrent(false);
 
     dec_ref(m_bool_sort);
     dec_ref(m_proof_sort);
@@ -1655,6 +1662,8 @@ static void track_id(ast_manager& m, ast* n, unsigned id) {
 #endif
 
 ast * ast_manager::register_node_core(ast * n) {
+    if (m_concurrent)
+        return register_node_concurrent(n);
     unsigned h = get_node_hash(n);
     n->m_hash = h;
 #ifdef Z3DEBUG
@@ -1672,7 +1681,7 @@ ast * ast_manager::register_node_core(ast * n) {
             throw ast_exception(std::format("Recycling of declaration for the same name '{}' and domain, but different range type is not permitted",
                                              to_func_decl(r)->get_name().str()));
         }
-        deallocate_node(n, ::get_node_size(n));
+        m_alloc.deallocate(::get_node_size(n), n);
         return r;
     }
     else {
@@ -1681,8 +1690,11 @@ ast * ast_manager::register_node_core(ast * n) {
     }
 
     n->m_id = is_decl(n) ? m_decl_id_gen.mk() : m_expr_id_gen.mk();        
+    init_node(n);
+    return n;
+}
 
-
+void ast_manager::init_node(ast * n) {
         //    TRACE(ast, tout << (s_count++) << " Object " << n->m_id << " was created.\n";);
     TRACE(mk_var_bug, tout << "mk_ast: " << n->m_id << "\n";);
     // increment reference counters
@@ -1763,10 +1775,322 @@ ast * ast_manager::register_node_core(ast * n) {
         inc_array_ref(to_quantifier(n)->get_num_no_patterns(), to_quantifier(n)->get_no_patterns());
         break;
     }
-    return n;
 }
 
 
+/**
+   \brief State of a manager in concurrent mode.
+
+   The table of nodes that exist when the mode is entered is only read. New nodes
+   are hash-consed in stripes that are selected by hash code and have their own lock.
+
+   A node whose reference count drops to zero is queued in its stripe together with
+   the current epoch. Registered threads record the epoch of their last checkpoint.
+   A queued node can be reclaimed when every registered thread has passed a checkpoint
+   after the node was released, and after the last time hash-consing returned a
+   released node of the stripe, since the thread that found it may not have referenced
+   it yet. Released nodes of the main table are reclaimed when the mode is left.
+*/
+struct ast_manager::concurrent_state {
+    static const unsigned num_stripes       = 64;
+    static const unsigned reclaim_threshold = 4096;
+
+    struct stripe {
+        mutex                                            m_lock;
+        chashtable<ast*, obj_ptr_hash<ast>, ast_eq_proc> m_table;
+        svector<std::pair<ast*, uint64_t>>               m_released;
+        ptr_vector<ast>                                  m_deferred;
+        uint64_t                                         m_hit_epoch = 0;
+        stripe(): m_table({}, {}, 1024, 256) {}
+    };
+
+    stripe                 m_stripes[num_stripes];
+    mutex                  m_lock;            // id generation, registered threads, polymorphic roots
+    recursive_mutex        m_plugin_lock;
+    std::atomic<uint64_t>  m_epoch { 1 };
+    std::atomic<unsigned>  m_num_released { 0 };
+    unsigned               m_next_reclaim = reclaim_threshold;
+    bool                   m_reclaiming = false;
+    svector<uint64_t>      m_thread_epochs;   // UINT64_MAX marks an unused slot
+
+    stripe & get_stripe(unsigned h) { return m_stripes[(h >> 26) & (num_stripes - 1)]; }
+};
+
+namespace {
+    struct concurrent_thread_slot {
+        ast_manager const * m_manager = nullptr;
+        unsigned            m_idx = 0;
+    };
+    thread_local concurrent_thread_slot g_thread_slot;
+}
+
+ast * ast_manager::register_node_concurrent(ast * n) {
+    n->m_concurrent_node = true;
+    unsigned h = get_node_hash(n);
+    n->m_hash = h;
+    ast * r;
+    if (ast * const * e = m_ast_table.find_core(n))
+        r = *e;
+    else {
+        concurrent_state & st = *m_concurrent_state;
+        auto & s = st.get_stripe(h);
+        lock_guard lock(s.m_lock);
+        r = s.m_table.insert_if_not_there(n);
+        if (r == n) {
+            {
+                lock_guard id_lock(st.m_lock);
+                n->m_id = is_decl(n) ? m_decl_id_gen.mk() : m_expr_id_gen.mk();
+            }
+            // other threads find the node only after it is initialized
+            init_node(n);
+            return n;
+        }
+        if (std::atomic_ref<unsigned>(r->m_ref_count).load() == 0)
+            s.m_hit_epoch = st.m_epoch.load();
+    }
+    SASSERT(r->m_hash == h);
+    bool range_mismatch = is_func_decl(r) && to_func_decl(r)->get_range() != to_func_decl(n)->get_range();
+    deallocate_node(n, ::get_node_size(n));
+    if (range_mismatch) {
+        throw ast_exception(std::format("Recycling of declaration for the same name '{}' and domain, but different range type is not permitted",
+                                         to_func_decl(r)->get_name().str()));
+    }
+    return r;
+}
+
+void ast_manager::concurrent_dec_ref(ast * n) {
+    if (n->dec_ref_atomic() != 0)
+        return;
+    concurrent_state & st = *m_concurrent_state;
+    auto & s = st.get_stripe(n->hash());
+    {
+        lock_guard lock(s.m_lock);
+        s.m_released.push_back({ n, st.m_epoch.load() });
+    }
+    ++st.m_num_released;
+}
+
+void ast_manager::register_concurrent_thread() {
+    if (!m_concurrent)
+        return;
+    SASSERT(!g_thread_slot.m_manager);
+    concurrent_state & st = *m_concurrent_state;
+    lock_guard lock(st.m_lock);
+    unsigned idx = 0;
+    while (idx < st.m_thread_epochs.size() && st.m_thread_epochs[idx] != UINT64_MAX)
+        ++idx;
+    if (idx == st.m_thread_epochs.size())
+        st.m_thread_epochs.push_back(0);
+    st.m_thread_epochs[idx] = st.m_epoch.load();
+    g_thread_slot.m_manager = this;
+    g_thread_slot.m_idx = idx;
+}
+
+void ast_manager::unregister_concurrent_thread() {
+    if (g_thread_slot.m_manager != this)
+        return;
+    if (m_concurrent_state) {
+        lock_guard lock(m_concurrent_state->m_lock);
+        m_concurrent_state->m_thread_epochs[g_thread_slot.m_idx] = UINT64_MAX;
+    }
+    g_thread_slot.m_manager = nullptr;
+}
+
+void ast_manager::concurrent_checkpoint() {
+    if (!m_concurrent || g_thread_slot.m_manager != this)
+        return;
+    concurrent_state & st = *m_concurrent_state;
+    uint64_t safe = UINT64_MAX;
+    {
+        lock_guard lock(st.m_lock);
+        st.m_thread_epochs[g_thread_slot.m_idx] = ++st.m_epoch;
+        if (st.m_reclaiming || st.m_num_released < st.m_next_reclaim)
+            return;
+        for (uint64_t e : st.m_thread_epochs)
+            safe = std::min(safe, e);
+        st.m_reclaiming = true;
+    }
+    // Children of reclaimed nodes can be reclaimed at the next checkpoint.
+    // Otherwise wait until more nodes have been released.
+    bool progress = concurrent_reclaim(safe) > 0;
+    lock_guard lock(st.m_lock);
+    st.m_next_reclaim = st.m_num_released + (progress ? 0 : concurrent_state::reclaim_threshold);
+    st.m_reclaiming = false;
+}
+
+/**
+   \brief Reclaim the released nodes of the striped tables that no registered thread
+   can still use, that is, nodes released before epoch safe. Return the number of
+   reclaimed nodes. Children of reclaimed nodes are released and reclaimed by a later pass.
+*/
+unsigned ast_manager::concurrent_reclaim(uint64_t safe) {
+    concurrent_state & st = *m_concurrent_state;
+    ptr_vector<ast> dead;
+    unsigned num_removed = 0;
+    for (auto & s : st.m_stripes) {
+        lock_guard lock(s.m_lock);
+        if (s.m_released.empty() || s.m_hit_epoch >= safe)
+            continue;
+        // a node may have been released several times; its last release counts.
+        auto & released = s.m_released;
+        std::sort(released.begin(), released.end());
+        unsigned i = 0, j = 0, sz = released.size();
+        while (i < sz) {
+            auto [n, epoch] = released[i++];
+            for (; i < sz && released[i].first == n; ++i)
+                epoch = released[i].second;
+            if (epoch >= safe)
+                released[j++] = { n, epoch };
+            else if (std::atomic_ref<unsigned>(n->m_ref_count).load() != 0)
+                continue;
+            else if (ast * const * e = s.m_table.find_core(n); e && *e == n) {
+                s.m_table.erase(n);
+                dead.push_back(n);
+            }
+            else
+                s.m_deferred.push_back(n);
+        }
+        num_removed += sz - j;
+        released.shrink(j);
+        auto & deferred = s.m_deferred;
+        std::sort(deferred.begin(), deferred.end());
+        deferred.shrink(static_cast<unsigned>(std::unique(deferred.begin(), deferred.end()) - deferred.begin()));
+    }
+    st.m_num_released -= num_removed;
+    for (ast * n : dead)
+        concurrent_delete_node(n);
+    TRACE(ast, tout << "reclaimed " << dead.size() << " nodes in concurrent mode\n";);
+    return dead.size();
+}
+
+/**
+   \brief Delete a node that was removed from its stripe and is not used by any thread.
+   Unlike delete_node, the children are released rather than deleted here.
+*/
+void ast_manager::concurrent_delete_node(ast * n) {
+    concurrent_state & st = *m_concurrent_state;
+#ifdef RECYCLE_FREE_AST_INDICES
+    if (!m_debug_ref_count) {
+        lock_guard lock(st.m_lock);
+        if (is_decl(n))
+            m_decl_id_gen.recycle(n->m_id);
+        else
+            m_expr_id_gen.recycle(n->m_id);
+    }
+#endif
+    switch (n->get_kind()) {
+    case AST_SORT:
+        if (to_sort(n)->m_info != nullptr) {
+            sort_info * info = to_sort(n)->get_info();
+            info->del_eh(*this);
+            dealloc(info);
+        }
+        break;
+    case AST_FUNC_DECL: {
+        func_decl * f = to_func_decl(n);
+        if (f->is_polymorphic()) {
+            lock_guard lock(st.m_lock);
+            m_poly_roots.erase(f);
+        }
+        if (f->m_info != nullptr) {
+            func_decl_info * info = f->get_info();
+            info->del_eh(*this);
+            dealloc(info);
+        }
+        dec_array_ref(f->get_arity(), f->get_domain());
+        dec_ref(f->get_range());
+        break;
+    }
+    case AST_APP: {
+        app * a = to_app(n);
+        dec_ref(a->get_decl());
+        dec_array_ref(a->get_num_args(), a->get_args());
+        break;
+    }
+    case AST_VAR:
+        dec_ref(to_var(n)->get_sort());
+        break;
+    case AST_QUANTIFIER: {
+        quantifier * q = to_quantifier(n);
+        dec_array_ref(q->get_num_decls(), q->get_decl_sorts());
+        dec_ref(q->get_expr());
+        dec_ref(q->get_sort());
+        dec_array_ref(q->get_num_patterns(), q->get_patterns());
+        dec_array_ref(q->get_num_no_patterns(), q->get_no_patterns());
+        break;
+    }
+    }
+    deallocate_node(n, ::get_node_size(n));
+}
+
+bool ast_manager::concurrent_contains(ast * n) const {
+    auto & s = m_concurrent_state->get_stripe(n->hash());
+    lock_guard lock(s.m_lock);
+    ast * const * e = s.m_table.find_core(n);
+    return e && *e == n;
+}
+
+unsigned ast_manager::num_concurrent_asts() const {
+    unsigned r = 0;
+    for (auto & s : m_concurrent_state->m_stripes) {
+        lock_guard lock(s.m_lock);
+        r += s.m_table.size();
+    }
+    return r;
+}
+
+void ast_manager::insert_poly_root(func_decl * g, func_decl * f) {
+    if (m_concurrent) {
+        lock_guard lock(m_concurrent_state->m_lock);
+        m_poly_roots.insert(g, f);
+    }
+    else
+        m_poly_roots.insert(g, f);
+}
+
+ast_manager::plugin_lock::plugin_lock(ast_manager & m):
+    m_mutex(m.m_concurrent ? &m.m_concurrent_state->m_plugin_lock : nullptr) {
+    if (m_mutex)
+        m_mutex->lock();
+}
+
+void ast_manager::set_concurrent(bool f) {
+    if (m_concurrent == f)
+        return;
+    if (f) {
+        m_concurrent_state = alloc(concurrent_state);
+        m_concurrent = true;
+        return;
+    }
+    m_concurrent = false;
+    // nodes created in concurrent mode move to the main table.
+    ptr_vector<ast> released;
+    for (auto & s : m_concurrent_state->m_stripes) {
+        for (ast * n : s.m_table)
+            m_ast_table.insert(n);
+        for (auto const & [n, epoch] : s.m_released)
+            released.push_back(n);
+        released.append(s.m_deferred);
+    }
+    dealloc(m_concurrent_state);
+    m_concurrent_state = nullptr;
+    // A node may have been released several times and nodes can be released
+    // as a side-effect of deleting other nodes. Pin each candidate once
+    // so that the cascade triggered by dec_ref does not free a pending node.
+    ptr_addr_hashtable<ast> pending;
+    ptr_vector<ast> todo;
+    for (ast * n : released) {
+        if (!pending.contains(n)) {
+            pending.insert(n);
+            todo.push_back(n);
+            n->inc_ref();
+        }
+    }
+    for (ast * n : todo)
+        dec_ref(n);
+    TRACE(ast, tout << "reclaimed " << todo.size() << " candidate nodes after concurrent mode\n";);
+}
+
 void ast_manager::delete_node(ast * n) {
     TRACE(delete_node_bug, tout << mk_ll_pp(n, *this) << "\n";);
 
@@ -1839,6 +2163,7 @@ void ast_manager::delete_node(ast * n) {
 
 sort * ast_manager::mk_sort(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters) {
     decl_plugin * p = get_plugin(fid);
+    plugin_lock lock(*this);
     if (p)
         return p->mk_sort(k, num_parameters, parameters);
     return nullptr;
@@ -1847,6 +2172,7 @@ sort * ast_manager::mk_sort(family_id fid, decl_kind k, unsigned num_parameters,
 func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters,
                                       unsigned arity, sort * const * domain, sort * range) {
     decl_plugin * p = get_plugin(fid);
+    plugin_lock lock(*this);
     if (p)
         return p->mk_func_decl(k, num_parameters, parameters, arity, domain, range);
     return nullptr;
@@ -1855,6 +2181,7 @@ func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_p
 func_decl * ast_manager::mk_func_decl(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters,
                                       unsigned num_args, expr * const * args, sort * range) {
     decl_plugin * p = get_plugin(fid);
+    plugin_lock lock(*this);
     if (p)
         return p->mk_func_decl(k, num_parameters, parameters, num_args, args, range);
     return nullptr;
@@ -1935,6 +2262,7 @@ sort * ast_manager::substitute(sort* s, unsigned n, sort * const * src, sort * c
 
 sort * ast_manager::mk_uninterpreted_sort(symbol const & name, unsigned num_parameters, parameter const * parameters) {
     user_sort_plugin * plugin = get_user_sort_plugin();
+    plugin_lock lock(*this);
     decl_kind kind = plugin->register_name(name);
     return plugin->mk_sort(kind, num_parameters, parameters);
 }
@@ -1972,7 +2300,7 @@ func_decl * ast_manager::mk_func_decl(symbol const & name, unsigned arity, sort
     func_decl* new_node = new (mem) func_decl(name, arity, domain, range, info);
     new_node = register_node(new_node);
     if (is_polymorphic_root) 
-        m_poly_roots.insert(new_node, new_node);
+        insert_poly_root(new_node, new_node);
     return new_node;
 }
 
@@ -2246,7 +2574,7 @@ func_decl * ast_manager::mk_fresh_func_decl(symbol const & prefix, symbol const
     func_decl_info* infop = skolem ? &info : nullptr;
     func_decl * d;
     if (prefix == symbol::null && suffix == symbol::null) {
-        d = mk_func_decl(symbol(m_fresh_id), arity, domain, range, infop);
+        d = mk_func_decl(symbol(next_fresh_id()), arity, domain, range, infop);
     }
     else {
         string_buffer<64> buffer;
@@ -2257,10 +2585,9 @@ func_decl * ast_manager::mk_fresh_func_decl(symbol const & prefix, symbol const
         buffer << "!";
         if (suffix != symbol::null)
             buffer << suffix << "!";
-        buffer << m_fresh_id;
+        buffer << next_fresh_id();
         d = mk_func_decl(symbol(buffer.c_str()), arity, domain, range, infop);
     }
-    m_fresh_id++;
     SASSERT(!skolem || d->get_info());
     SASSERT(skolem == d->is_skolem());
     return d;
@@ -2276,15 +2603,13 @@ bool ast_manager::is_parametric_function(func_decl* f, func_decl *& g) const {
 
 sort * ast_manager::mk_fresh_sort(char const * prefix) {
     string_buffer<32> buffer;
-    buffer << prefix << "!" << m_fresh_id;
-    m_fresh_id++;
+    buffer << prefix << "!" << next_fresh_id();
     return mk_uninterpreted_sort(symbol(buffer.c_str()));
 }
 
 symbol ast_manager::mk_fresh_var_name(char const * prefix) {
     string_buffer<32> buffer;
-    buffer << (prefix ? prefix : "var") << "!" << m_fresh_id;
-    m_fresh_id++;
+    buffer << (prefix ? prefix : "var") << "!" << next_fresh_id();
     return symbol(buffer.c_str());
 }
 
@@ -2700,7 +3025,7 @@ bool ast_manager::has_type_var(unsigned n, sort* const* domain, sort* range) con
 func_decl* ast_manager::instantiate_polymorphic(func_decl* f, unsigned arity, sort * const* domain, sort * range) {
     SASSERT(f->is_polymorphic());
     func_decl* g = mk_func_decl(f->get_name(), arity, domain, range, f->get_info());
-    m_poly_roots.insert(g, f);
+    insert_poly_root(g, f);
     // SASSERT(g->is_polymorphic());
     return g;
 }
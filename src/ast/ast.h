@@ -48,6 +48,8 @@ Revision History:
 #include "util/dependency.h"
 #include "util/rlimit.h"
 #include "util/manage_warnings.h"
+#include "util/mutex.h"
+#include <atomic>
 #include <variant>
 #include <span>
 #include <initializer_list>
@@ -475,6 +477,8 @@ protected:
     //    shared_occs used one of the public marks.
     //  - This was a constant source of assertion violations.
     unsigned m_mark_shared_occs:1;
+    // The node was created in concurrent mode and is not owned by the small object allocator.
+    unsigned m_concurrent_node:1;
     friend class shared_occs_mark;
     void mark_so(bool flag) { m_mark_shared_occs = flag; }
     void reset_mark_so() { m_mark_shared_occs = false; }
@@ -497,7 +501,18 @@ protected:
         --m_ref_count;
     }
 
-    ast(ast_kind k): m_kind(k), m_mark1(false), m_mark2(false), m_mark_shared_occs(false) {
+    // Reference counting used when the owning manager is in concurrent mode.
+    // The counter is updated atomically so that several threads may share the node.
+    void inc_ref_atomic() {
+        std::atomic_ref<unsigned>(m_ref_count).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    unsigned dec_ref_atomic() {
+        SASSERT(m_ref_count > 0);
+        return std::atomic_ref<unsigned>(m_ref_count).fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+
+    ast(ast_kind k): m_kind(k), m_mark1(false), m_mark2(false), m_mark_shared_occs(false), m_concurrent_node(false) {
         DEBUG_CODE({
             m_mark1_owner = 0;
             m_mark2_owner = 0;
@@ -1497,7 +1512,7 @@ public:
 
     void update_fresh_id(ast_manager const& other);
 
-    unsigned mk_fresh_id() { return ++m_fresh_id; }
+    unsigned mk_fresh_id() { return next_fresh_id() + 1; }
 
 protected:
     reslimit                  m_limit;
@@ -1527,6 +1542,12 @@ protected:
     bool slow_not_contains(ast const * n);
 #endif
     ast_manager *             m_format_manager; // hack for isolating format objects in a different manager.
+    // Concurrent (shared) mode: new nodes are hash-consed in striped tables,
+    // reference counts are updated atomically, and released nodes are reclaimed
+    // once all registered threads have passed a checkpoint. See set_concurrent.
+    struct concurrent_state;
+    bool                      m_concurrent = false;
+    concurrent_state *        m_concurrent_state = nullptr;
     symbol                    m_lambda_def = symbol(":lambda-def");
     obj_map<func_decl, func_decl*> m_poly_roots;
 
@@ -1638,25 +1659,70 @@ public:
 
     bool are_distinct(expr * a, expr * b) const;
 
-    bool contains(ast * a) const { return m_ast_table.contains(a); }
+    bool contains(ast * a) const { return m_ast_table.contains(a) || (m_concurrent && concurrent_contains(a)); }
    
-    unsigned get_num_asts() const { return m_ast_table.size(); }
+    unsigned get_num_asts() const { return m_ast_table.size() + (m_concurrent ? num_concurrent_asts() : 0); }
 
     void debug_ref_count() { m_debug_ref_count = true; }
 
     void inc_ref(ast* n) {
-        if (n) 
+        if (!n)
+            return;
+        if (m_concurrent)
+            n->inc_ref_atomic();
+        else
             n->inc_ref();
     }
     
     void dec_ref(ast* n) {
-        if (n) {
+        if (!n)
+            return;
+        if (m_concurrent) 
+            concurrent_dec_ref(n);
+        else {
             n->dec_ref();
             if (n->get_ref_count() == 0)
                 delete_node(n);
         }
     }
 
+    /**
+       \brief Enable or disable concurrent mode.
+
+       In concurrent mode several threads may create and reference terms over
+       this manager at the same time, so that workers can share the input formula
+       instead of copying it with ast_translation. The nodes that exist when the
+       mode is entered are looked up without locks; new nodes go to hash tables
+       that are striped by hash code. Theory plugins serialize their caches with
+       plugin_lock. Marks and polymorphic declarations are not synchronized.
+
+       Threads that use the manager in concurrent mode should register with
+       scoped_concurrent_thread and call concurrent_checkpoint() at points where
+       all terms they still use are referenced. Nodes created in the mode whose
+       reference count drops to zero are reclaimed once every registered thread
+       has passed a checkpoint. Other released nodes are reclaimed when the mode
+       is disabled, which must happen when no other thread accesses the manager.
+    */
+    void set_concurrent(bool f);
+
+    bool is_concurrent() const { return m_concurrent; }
+
+    void register_concurrent_thread();
+
+    void unregister_concurrent_thread();
+
+    void concurrent_checkpoint();
+
+    /**
+       \brief Serialize access to the caches of theory plugins while the manager is in concurrent mode.
+    */
+    class plugin_lock {
+        recursive_mutex * m_mutex;
+    public:
+        plugin_lock(ast_manager & m);
+        ~plugin_lock() { if (m_mutex) m_mutex->unlock(); }
+    };
+
     template<typename T>
     void inc_array_ref(std::span<T * const> a) {
         for(auto elem : a) {
@@ -1702,13 +1768,36 @@ protected:
     void delete_node(ast * n);
 
     void * allocate_node(unsigned size) {
+        if (m_concurrent)
+            return memory::allocate(size);
         return m_alloc.allocate(size);
     }
 
     void deallocate_node(ast * n, unsigned sz) {
-        m_alloc.deallocate(sz, n);
+        if (n->m_concurrent_node)
+            memory::deallocate(n);
+        else
+            m_alloc.deallocate(sz, n);
     }
 
+    void init_node(ast * n);
+
+    ast * register_node_concurrent(ast * n);
+
+    void concurrent_dec_ref(ast * n);
+
+    unsigned concurrent_reclaim(uint64_t safe);
+
+    void concurrent_delete_node(ast * n);
+
+    bool concurrent_contains(ast * n) const;
+
+    unsigned num_concurrent_asts() const;
+
+    void insert_poly_root(func_decl * g, func_decl * f);
+
+    unsigned next_fresh_id();
+
 public:
     void check_sort(func_decl const * decl, unsigned num_args, expr * const * args) const;
     void check_sorts_core(ast const * n) const;
@@ -2448,6 +2537,16 @@ private:
     }
 };
 
+/**
+   \brief Register the current thread with a manager in concurrent mode.
+*/
+class scoped_concurrent_thread {
+    ast_manager & m;
+public:
+    scoped_concurrent_thread(ast_manager & m): m(m) { m.register_concurrent_thread(); }
+    ~scoped_concurrent_thread() { m.unregister_concurrent_thread(); }
+};
+
 typedef ast_manager::expr_array expr_array;
 typedef ast_manager::expr_dependency expr_dependency;
 typedef ast_manager::expr_dependency_array expr_dependency_array;
@@ -0,0 +1,680 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.cpp
+
+Abstract:
+
+    Compact binary serialization of ASTs.
+
+--*/
+
+#include "ast/ast_binary.h"
+#include "util/zstring.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    char const  magic[] = "Z3AST";
+    unsigned const version = 1;
+
+    enum tag : unsigned char {
+        TAG_REF,
+        TAG_NULL,
+        TAG_USORT,
+        TAG_SORT,
+        TAG_UFUNC_DECL,
+        TAG_FUNC_DECL,
+        TAG_APP,
+        TAG_VAR,
+        TAG_QUANTIFIER,
+        TAG_RESET
+    };
+
+    enum symbol_tag : unsigned {
+        SYM_NULL,
+        SYM_NUM,
+        SYM_NEW,
+        SYM_REF
+    };
+
+    enum decl_flag : unsigned {
+        F_LEFT_ASSOC   = 1 << 0,
+        F_RIGHT_ASSOC  = 1 << 1,
+        F_FLAT_ASSOC   = 1 << 2,
+        F_COMMUTATIVE  = 1 << 3,
+        F_CHAINABLE    = 1 << 4,
+        F_PAIRWISE     = 1 << 5,
+        F_INJECTIVE    = 1 << 6,
+        F_IDEMPOTENT   = 1 << 7,
+        F_SKOLEM       = 1 << 8
+    };
+
+    [[noreturn]] void throw_invalid() {
+        throw default_exception("invalid binary AST stream");
+    }
+}
+
+// ------------------------------------
+// ast_binary_writer
+
+ast_binary_writer::ast_binary_writer(ast_manager& m):
+    m(m),
+    m_pinned(m) {
+    m_out.append(magic, sizeof(magic) - 1);
+    write_unsigned(version);
+}
+
+void ast_binary_writer::write_unsigned(uint64_t n) {
+    while (n >= 0x80) {
+        write_byte(static_cast<unsigned char>(n | 0x80));
+        n >>= 7;
+    }
+    write_byte(static_cast<unsigned char>(n));
+}
+
+void ast_binary_writer::write_int(int64_t n) {
+    write_unsigned((static_cast<uint64_t>(n) << 1) ^ static_cast<uint64_t>(n >> 63));
+}
+
+void ast_binary_writer::write_double(double d) {
+    char buffer[sizeof(double)];
+    memcpy(buffer, &d, sizeof(double));
+    m_out.append(buffer, sizeof(double));
+}
+
+void ast_binary_writer::write_string(std::string_view s) {
+    write_unsigned(s.size());
+    m_out.append(s.data(), s.size());
+}
+
+void ast_binary_writer::write_symbol(symbol const& s) {
+    unsigned idx;
+    if (s.is_null())
+        write_unsigned(SYM_NULL);
+    else if (s.is_numerical()) {
+        write_unsigned(SYM_NUM);
+        write_unsigned(s.get_num());
+    }
+    else if (m_symbols.find(s, idx))
+        write_unsigned(SYM_REF + idx);
+    else {
+        m_symbols.insert(s, m_symbols.size());
+        write_unsigned(SYM_NEW);
+        write_string(s.str());
+    }
+}
+
+void ast_binary_writer::write_rational(rational const& r) {
+    if (r.is_int64()) {
+        write_byte(0);
+        write_int(r.get_int64());
+    }
+    else {
+        write_byte(1);
+        write_string(r.to_string());
+    }
+}
+
+void ast_binary_writer::write_parameter(parameter const& p) {
+    write_byte(static_cast<unsigned char>(p.get_kind()));
+    switch (p.get_kind()) {
+    case parameter::PARAM_INT:
+        write_int(p.get_int());
+        break;
+    case parameter::PARAM_AST:
+        write_unsigned(m_ids[p.get_ast()]);
+        break;
+    case parameter::PARAM_SYMBOL:
+        write_symbol(p.get_symbol());
+        break;
+    case parameter::PARAM_ZSTRING: {
+        zstring const& s = p.get_zstring();
+        write_unsigned(s.length());
+        for (unsigned i = 0; i < s.length(); ++i)
+            write_unsigned(s[i]);
+        break;
+    }
+    case parameter::PARAM_RATIONAL:
+        write_rational(p.get_rational());
+        break;
+    case parameter::PARAM_DOUBLE:
+        write_double(p.get_double());
+        break;
+    default:
+        throw default_exception("binary AST serialization does not support external parameters");
+    }
+}
+
+void ast_binary_writer::write_params(decl* d) {
+    write_unsigned(d->get_num_parameters());
+    for (parameter const& p : d->parameters())
+        write_parameter(p);
+}
+
+void ast_binary_writer::write_definition(ast* n) {
+    switch (n->get_kind()) {
+    case AST_SORT: {
+        sort* s = to_sort(n);
+        sort_info* si = s->get_info();
+        if (!si) {
+            write_byte(TAG_USORT);
+            write_symbol(s->get_name());
+            break;
+        }
+        write_byte(TAG_SORT);
+        write_symbol(s->get_name());
+        write_symbol(si->get_family_id() == null_family_id ? symbol::null : m.get_family_name(si->get_family_id()));
+        write_int(si->get_decl_kind());
+        sort_size const& sz = si->get_num_elements();
+        write_byte(sz.is_infinite() ? 0 : sz.is_very_big() ? 1 : 2);
+        if (sz.is_finite())
+            write_unsigned(sz.size());
+        write_byte(s->private_parameters() ? 1 : 0);
+        write_params(s);
+        break;
+    }
+    case AST_FUNC_DECL: {
+        func_decl* f = to_func_decl(n);
+        func_decl_info* fi = f->get_info();
+        if (!fi) {
+            write_byte(TAG_UFUNC_DECL);
+            write_symbol(f->get_name());
+        }
+        else {
+            write_byte(TAG_FUNC_DECL);
+            write_symbol(f->get_name());
+            write_symbol(fi->get_family_id() == null_family_id ? symbol::null : m.get_family_name(fi->get_family_id()));
+            write_int(fi->get_decl_kind());
+            unsigned flags = 0;
+            if (fi->is_left_associative()) flags |= F_LEFT_ASSOC;
+            if (fi->is_right_associative()) flags |= F_RIGHT_ASSOC;
+            if (fi->is_flat_associative()) flags |= F_FLAT_ASSOC;
+            if (fi->is_commutative()) flags |= F_COMMUTATIVE;
+            if (fi->is_chainable()) flags |= F_CHAINABLE;
+            if (fi->is_pairwise()) flags |= F_PAIRWISE;
+            if (fi->is_injective()) flags |= F_INJECTIVE;
+            if (fi->is_idempotent()) flags |= F_IDEMPOTENT;
+            if (fi->is_skolem()) flags |= F_SKOLEM;
+            write_unsigned(flags);
+            write_params(f);
+        }
+        write_unsigned(f->get_arity());
+        for (sort* s : *f)
+            write_unsigned(m_ids[s]);
+        write_unsigned(m_ids[f->get_range()]);
+        break;
+    }
+    case AST_APP: {
+        app* a = to_app(n);
+        write_byte(TAG_APP);
+        write_unsigned(m_ids[a->get_decl()]);
+        write_unsigned(a->get_num_args());
+        for (expr* arg : *a)
+            write_unsigned(m_ids[arg]);
+        break;
+    }
+    case AST_VAR:
+        write_byte(TAG_VAR);
+        write_unsigned(to_var(n)->get_idx());
+        write_unsigned(m_ids[to_var(n)->get_sort()]);
+        break;
+    case AST_QUANTIFIER: {
+        quantifier* q = to_quantifier(n);
+        write_byte(TAG_QUANTIFIER);
+        write_byte(static_cast<unsigned char>(q->get_kind()));
+        write_unsigned(q->get_num_decls());
+        for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+            write_unsigned(m_ids[q->get_decl_sort(i)]);
+            write_symbol(q->get_decl_name(i));
+        }
+        write_unsigned(m_ids[q->get_expr()]);
+        write_int(q->get_weight());
+        write_symbol(q->get_qid());
+        write_symbol(q->get_skid());
+        write_unsigned(q->get_num_patterns());
+        for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+            write_unsigned(m_ids[q->get_pattern(i)]);
+        write_unsigned(q->get_num_no_patterns());
+        for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+            write_unsigned(m_ids[q->get_no_pattern(i)]);
+        break;
+    }
+    default:
+        UNREACHABLE();
+    }
+}
+
+void ast_binary_writer::define(ast* n) {
+    m_todo.push_back(n);
+    while (!m_todo.empty()) {
+        ast* t = m_todo.back();
+        if (m_ids.contains(t)) {
+            m_todo.pop_back();
+            continue;
+        }
+        unsigned sz = m_todo.size();
+        auto visit = [&](ast* c) {
+            if (!m_ids.contains(c))
+                m_todo.push_back(c);
+        };
+        auto visit_params = [&](decl* d) {
+            for (parameter const& p : d->parameters())
+                if (p.is_ast())
+                    visit(p.get_ast());
+        };
+        switch (t->get_kind()) {
+        case AST_SORT:
+            visit_params(to_sort(t));
+            break;
+        case AST_FUNC_DECL:
+            visit_params(to_func_decl(t));
+            for (sort* s : *to_func_decl(t))
+                visit(s);
+            visit(to_func_decl(t)->get_range());
+            break;
+        case AST_APP:
+            visit(to_app(t)->get_decl());
+            for (expr* arg : *to_app(t))
+                visit(arg);
+            break;
+        case AST_VAR:
+            visit(to_var(t)->get_sort());
+            break;
+        case AST_QUANTIFIER: {
+            quantifier* q = to_quantifier(t);
+            for (unsigned i = 0; i < q->get_num_decls(); ++i)
+                visit(q->get_decl_sort(i));
+            visit(q->get_expr());
+            for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                visit(q->get_pattern(i));
+            for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                visit(q->get_no_pattern(i));
+            break;
+        }
+        default:
+            UNREACHABLE();
+        }
+        if (m_todo.size() > sz)
+            continue;
+        m_todo.pop_back();
+        write_definition(t);
+        m_ids.insert(t, m_pinned.size());
+        m_pinned.push_back(t);
+    }
+}
+
+void ast_binary_writer::reset() {
+    m_ids.reset();
+    m_pinned.reset();
+    m_reset_pending = true;
+}
+
+void ast_binary_writer::write_ast(ast* n) {
+    if (m_reset_pending) {
+        write_byte(TAG_RESET);
+        m_reset_pending = false;
+    }
+    if (!n) {
+        write_byte(TAG_NULL);
+        return;
+    }
+    define(n);
+    write_byte(TAG_REF);
+    write_unsigned(m_ids[n]);
+}
+
+void ast_binary_writer::write_exprs(unsigned n, expr* const* es) {
+    write_unsigned(n);
+    for (unsigned i = 0; i < n; ++i)
+        write_ast(es[i]);
+}
+
+void ast_binary_writer::flush(std::ostream& out) {
+    out.write(m_out.data(), m_out.size());
+    m_out.clear();
+}
+
+// ------------------------------------
+// ast_binary_reader
+
+ast_binary_reader::ast_binary_reader(ast_manager& m, char const* data, size_t size):
+    m(m),
+    m_pos(data),
+    m_end(data + size),
+    m_asts(m) {
+    read_header();
+}
+
+ast_binary_reader::ast_binary_reader(ast_manager& m, std::istream& in):
+    m(m),
+    m_pos(nullptr),
+    m_end(nullptr),
+    m_in(&in),
+    m_asts(m) {
+    read_header();
+}
+
+void ast_binary_reader::read_header() {
+    for (unsigned i = 0; i + 1 < sizeof(magic); ++i)
+        if (at_end() || read_byte() != static_cast<unsigned char>(magic[i]))
+            throw default_exception("not a binary AST stream");
+    if (read_unsigned() != version)
+        throw default_exception("unsupported binary AST stream version");
+}
+
+bool ast_binary_reader::fill() {
+    if (!m_in)
+        return false;
+    m_buffer.resize(1 << 16);
+    m_in->read(m_buffer.data(), m_buffer.size());
+    m_buffer.resize(static_cast<size_t>(m_in->gcount()));
+    m_pos = m_buffer.data();
+    m_end = m_pos + m_buffer.size();
+    return m_pos != m_end;
+}
+
+unsigned char ast_binary_reader::read_byte() {
+    if (m_pos == m_end && !fill())
+        throw_invalid();
+    return static_cast<unsigned char>(*m_pos++);
+}
+
+uint64_t ast_binary_reader::read_unsigned() {
+    uint64_t r = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        unsigned char b = read_byte();
+        r |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if (!(b & 0x80))
+            return r;
+    }
+    throw_invalid();
+}
+
+int64_t ast_binary_reader::read_int() {
+    uint64_t n = read_unsigned();
+    return static_cast<int64_t>(n >> 1) ^ -static_cast<int64_t>(n & 1);
+}
+
+double ast_binary_reader::read_double() {
+    char buffer[sizeof(double)];
+    for (unsigned i = 0; i < sizeof(double); ++i)
+        buffer[i] = static_cast<char>(read_byte());
+    double d;
+    memcpy(&d, buffer, sizeof(double));
+    return d;
+}
+
+std::string_view ast_binary_reader::read_string() {
+    uint64_t len = read_unsigned();
+    if (static_cast<uint64_t>(m_end - m_pos) >= len) {
+        std::string_view r(m_pos, len);
+        m_pos += len;
+        return r;
+    }
+    if (!m_in)
+        throw_invalid();
+    m_string.clear();
+    while (m_string.size() < len) {
+        if (m_pos == m_end && !fill())
+            throw_invalid();
+        size_t n = std::min(static_cast<size_t>(m_end - m_pos), static_cast<size_t>(len - m_string.size()));
+        m_string.append(m_pos, n);
+        m_pos += n;
+    }
+    return m_string;
+}
+
+symbol ast_binary_reader::read_symbol() {
+    uint64_t t = read_unsigned();
+    switch (t) {
+    case SYM_NULL:
+        return symbol::null;
+    case SYM_NUM:
+        return symbol(static_cast<unsigned>(read_unsigned()));
+    case SYM_NEW: {
+        symbol s{ std::string(read_string()) };
+        m_symbols.push_back(s);
+        return s;
+    }
+    default:
+        if (t - SYM_REF >= m_symbols.size())
+            throw_invalid();
+        return m_symbols[static_cast<unsigned>(t - SYM_REF)];
+    }
+}
+
+rational ast_binary_reader::read_rational() {
+    if (read_byte() == 0)
+        return rational(read_int(), rational::i64());
+    return rational(std::string(read_string()).c_str());
+}
+
+ast* ast_binary_reader::get_ast(uint64_t idx) {
+    if (idx >= m_asts.size())
+        throw_invalid();
+    return m_asts.get(static_cast<unsigned>(idx));
+}
+
+void ast_binary_reader::read_parameter(vector<parameter>& ps) {
+    switch (read_byte()) {
+    case parameter::PARAM_INT:
+        ps.push_back(parameter(static_cast<int>(read_int())));
+        break;
+    case parameter::PARAM_AST:
+        ps.push_back(parameter(get_ast(read_unsigned())));
+        break;
+    case parameter::PARAM_SYMBOL:
+        ps.push_back(parameter(read_symbol()));
+        break;
+    case parameter::PARAM_ZSTRING: {
+        unsigned_vector chars;
+        uint64_t len = read_unsigned();
+        for (uint64_t i = 0; i < len; ++i)
+            chars.push_back(static_cast<unsigned>(read_unsigned()));
+        ps.push_back(parameter(zstring(chars.size(), chars.data())));
+        break;
+    }
+    case parameter::PARAM_RATIONAL:
+        ps.push_back(parameter(read_rational()));
+        break;
+    case parameter::PARAM_DOUBLE:
+        ps.push_back(parameter(read_double()));
+        break;
+    default:
+        throw_invalid();
+    }
+}
+
+void ast_binary_reader::read_params(vector<parameter>& ps) {
+    uint64_t n = read_unsigned();
+    for (uint64_t i = 0; i < n; ++i)
+        read_parameter(ps);
+}
+
+void ast_binary_reader::read_definition(unsigned char t) {
+    auto get_family = [&](symbol const& s) {
+        if (s.is_null())
+            return null_family_id;
+        family_id fid = m.get_family_id(s);
+        if (fid == null_family_id)
+            throw default_exception("binary AST stream uses unknown theory " + s.str());
+        return fid;
+    };
+    switch (t) {
+    case TAG_USORT:
+        m_asts.push_back(m.mk_uninterpreted_sort(read_symbol()));
+        break;
+    case TAG_SORT: {
+        symbol name = read_symbol();
+        family_id fid = get_family(read_symbol());
+        decl_kind k = static_cast<decl_kind>(read_int());
+        sort_size sz;
+        switch (read_byte()) {
+        case 0: sz = sort_size::mk_infinite(); break;
+        case 1: sz = sort_size::mk_very_big(); break;
+        default: sz = sort_size::mk_finite(read_unsigned()); break;
+        }
+        bool private_params = read_byte() != 0;
+        vector<parameter> ps;
+        read_params(ps);
+        m_asts.push_back(m.mk_sort(name, sort_info(fid, k, sz, ps.size(), ps.data(), private_params)));
+        break;
+    }
+    case TAG_UFUNC_DECL:
+    case TAG_FUNC_DECL: {
+        symbol name = read_symbol();
+        func_decl_info fi;
+        vector<parameter> ps;
+        if (t == TAG_FUNC_DECL) {
+            family_id fid = get_family(read_symbol());
+            decl_kind k = static_cast<decl_kind>(read_int());
+            uint64_t flags = read_unsigned();
+            read_params(ps);
+            fi = func_decl_info(fid, k, ps.size(), ps.data());
+            fi.set_left_associative(flags & F_LEFT_ASSOC);
+            fi.set_right_associative(flags & F_RIGHT_ASSOC);
+            fi.set_flat_associative(flags & F_FLAT_ASSOC);
+            fi.set_commutative(flags & F_COMMUTATIVE);
+            fi.set_chainable(flags & F_CHAINABLE);
+            fi.set_pairwise(flags & F_PAIRWISE);
+            fi.set_injective(flags & F_INJECTIVE);
+            fi.set_idempotent(flags & F_IDEMPOTENT);
+            fi.set_skolem(flags & F_SKOLEM);
+        }
+        ptr_buffer<sort> domain;
+        uint64_t arity = read_unsigned();
+        for (uint64_t i = 0; i < arity; ++i) {
+            ast* s = get_ast(read_unsigned());
+            if (!is_sort(s))
+                throw_invalid();
+            domain.push_back(to_sort(s));
+        }
+        ast* range = get_ast(read_unsigned());
+        if (!is_sort(range))
+            throw_invalid();
+        if (t == TAG_UFUNC_DECL)
+            m_asts.push_back(m.mk_func_decl(name, domain.size(), domain.data(), to_sort(range)));
+        else
+            m_asts.push_back(m.mk_func_decl(name, domain.size(), domain.data(), to_sort(range), fi));
+        break;
+    }
+    case TAG_APP: {
+        ast* f = get_ast(read_unsigned());
+        if (!is_func_decl(f))
+            throw_invalid();
+        ptr_buffer<expr> args;
+        uint64_t n = read_unsigned();
+        for (uint64_t i = 0; i < n; ++i) {
+            ast* a = get_ast(read_unsigned());
+            if (!is_expr(a))
+                throw_invalid();
+            args.push_back(to_expr(a));
+        }
+        m_asts.push_back(m.mk_app(to_func_decl(f), args.size(), args.data()));
+        break;
+    }
+    case TAG_VAR: {
+        unsigned idx = static_cast<unsigned>(read_unsigned());
+        ast* s = get_ast(read_unsigned());
+        if (!is_sort(s))
+            throw_invalid();
+        m_asts.push_back(m.mk_var(idx, to_sort(s)));
+        break;
+    }
+    case TAG_RESET:
+        m_asts.reset();
+        break;
+    case TAG_QUANTIFIER: {
+        quantifier_kind k = static_cast<quantifier_kind>(read_byte());
+        uint64_t num_decls = read_unsigned();
+        ptr_buffer<sort> sorts;
+        buffer<symbol> names;
+        for (uint64_t i = 0; i < num_decls; ++i) {
+            ast* s = get_ast(read_unsigned());
+            if (!is_sort(s))
+                throw_invalid();
+            sorts.push_back(to_sort(s));
+            names.push_back(read_symbol());
+        }
+        ast* body = get_ast(read_unsigned());
+        if (!is_expr(body) || num_decls == 0)
+            throw_invalid();
+        int weight = static_cast<int>(read_int());
+        symbol qid = read_symbol();
+        symbol skid = read_symbol();
+        ptr_buffer<expr> patterns, no_patterns;
+        for (auto* pats : { &patterns, &no_patterns }) {
+            uint64_t n = read_unsigned();
+            for (uint64_t i = 0; i < n; ++i) {
+                ast* p = get_ast(read_unsigned());
+                if (!is_expr(p))
+                    throw_invalid();
+                pats->push_back(to_expr(p));
+            }
+        }
+        quantifier* q;
+        if (k == lambda_k)
+            q = m.mk_lambda(sorts.size(), sorts.data(), names.data(), to_expr(body));
+        else if (k == forall_k || k == exists_k)
+            q = m.mk_quantifier(k, sorts.size(), sorts.data(), names.data(), to_expr(body), weight, qid, skid,
+                                patterns.size(), patterns.data(), no_patterns.size(), no_patterns.data());
+        else
+            throw_invalid();
+        m_asts.push_back(q);
+        break;
+    }
+    default:
+        throw_invalid();
+    }
+}
+
+ast* ast_binary_reader::read_ast() {
+    while (true) {
+        unsigned char t = read_byte();
+        if (t == TAG_REF)
+            return get_ast(read_unsigned());
+        if (t == TAG_NULL)
+            return nullptr;
+        read_definition(t);
+    }
+}
+
+expr* ast_binary_reader::read_expr() {
+    ast* a = read_ast();
+    if (!a)
+        return nullptr;
+    if (!is_expr(a))
+        throw_invalid();
+    return to_expr(a);
+}
+
+sort* ast_binary_reader::read_sort() {
+    ast* a = read_ast();
+    if (!a)
+        return nullptr;
+    if (!is_sort(a))
+        throw_invalid();
+    return to_sort(a);
+}
+
+func_decl* ast_binary_reader::read_func_decl() {
+    ast* a = read_ast();
+    if (!a)
+        return nullptr;
+    if (!is_func_decl(a))
+        throw_invalid();
+    return to_func_decl(a);
+}
+
+void ast_binary_reader::read_exprs(expr_ref_vector& es) {
+    uint64_t n = read_unsigned();
+    for (uint64_t i = 0; i < n; ++i) {
+        expr* e = read_expr();
+        if (!e)
+            throw_invalid();
+        es.push_back(e);
+    }
+}
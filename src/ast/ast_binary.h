@@ -0,0 +1,143 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.h
+
+Abstract:
+
+    Compact binary serialization of ASTs.
+
+    The stream is a DAG: every sort, declaration and expression is
+    defined once, in post-order, and later occurrences refer to it by
+    its position in a table that is shared by all values written to
+    the stream. Symbols are interned in the same way.
+    Numbers use a variable-length encoding.
+
+    Sorts and declarations are identified by family name and decl kind,
+    similar to ast_translation, so the decl kinds must agree between
+    the writer and the reader. Datatypes must be declared in the
+    reading manager before their sorts and constructors can be read.
+
+    The writer pins every AST it defined, so that later references stay
+    valid. Long running writers, such as proof logs, call reset between
+    values: the tables are released and ASTs that are written again are
+    defined again. The reader drops its table at the same point.
+
+    The reader works either on a memory buffer, without copying it,
+    or on an input stream that it reads in chunks.
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "util/obj_hashtable.h"
+#include "util/map.h"
+#include "util/rational.h"
+#include <istream>
+#include <ostream>
+#include <string>
+
+class ast_binary_writer {
+    ast_manager&            m;
+    std::string             m_out;
+    obj_map<ast, unsigned>  m_ids;
+    ast_ref_vector          m_pinned;
+    map<symbol, unsigned, symbol_hash_proc, symbol_eq_proc> m_symbols;
+    ptr_vector<ast>         m_todo;
+    bool                    m_reset_pending = false;
+
+    void write_byte(unsigned char b) { m_out.push_back(static_cast<char>(b)); }
+    void write_parameter(parameter const& p);
+    void write_params(decl* d);
+    void write_definition(ast* n);
+    void define(ast* n);
+
+public:
+    ast_binary_writer(ast_manager& m);
+
+    void write_unsigned(uint64_t n);
+    void write_int(int64_t n);
+    void write_double(double d);
+    void write_symbol(symbol const& s);
+    void write_rational(rational const& r);
+    void write_string(std::string_view s);
+
+    /**
+       \brief Write a reference to n, preceded by the definitions of
+       the sub-terms of n that were not written before.
+       n may be null.
+    */
+    void write_ast(ast* n);
+
+    void write_exprs(unsigned n, expr* const* es);
+    void write_exprs(expr_ref_vector const& es) { write_exprs(es.size(), es.data()); }
+
+    std::string const& data() const { return m_out; }
+
+    /**
+       \brief Number of ASTs that are defined in the stream, and pinned,
+       since the writer was created or last reset.
+    */
+    unsigned num_defined() const { return m_pinned.size(); }
+
+    /**
+       \brief Release the defined ASTs. The next AST reference tells the
+       reader to drop its table as well, later references define the
+       ASTs they use again. Symbols are still shared.
+    */
+    void reset();
+
+    /**
+       \brief Move the bytes written so far to out.
+       The tables are kept, so later values may refer to ASTs that were
+       already flushed. This allows streaming a long sequence of values
+       without buffering the whole stream.
+    */
+    void flush(std::ostream& out);
+};
+
+class ast_binary_reader {
+    ast_manager&            m;
+    char const*             m_pos;
+    char const*             m_end;
+    std::istream*           m_in = nullptr;
+    std::string             m_buffer;      // current chunk of m_in
+    std::string             m_string;      // strings that cross a chunk boundary
+    ast_ref_vector          m_asts;
+    svector<symbol>         m_symbols;
+
+    bool fill();
+    void read_header();
+    unsigned char read_byte();
+    void read_parameter(vector<parameter>& ps);
+    void read_params(vector<parameter>& ps);
+    void read_definition(unsigned char tag);
+    ast* get_ast(uint64_t idx);
+
+public:
+    ast_binary_reader(ast_manager& m, char const* data, size_t size);
+    ast_binary_reader(ast_manager& m, std::istream& in);
+
+    bool at_end() { return m_pos == m_end && !fill(); }
+
+    uint64_t read_unsigned();
+    int64_t read_int();
+    double read_double();
+    symbol read_symbol();
+    rational read_rational();
+    // the result is valid until the next string is read
+    std::string_view read_string();
+
+    /**
+       \brief Read the next AST reference, processing the definitions that
+       precede it. Returns null if a null reference was written.
+    */
+    ast* read_ast();
+    expr* read_expr();
+    sort* read_sort();
+    func_decl* read_func_decl();
+
+    void read_exprs(expr_ref_vector& es);
+};
@@ -130,6 +130,13 @@ void ast_translation::mk_sort(sort * s, frame & fr) {
         new_s = m_to_manager.mk_uninterpreted_sort(s->get_name());
         SASSERT(m_result_stack.size() == fr.m_rpos);
     }
+    else if (si->get_family_id() == user_sort_family_id) {
+        // the decl kind of a user sort is its position in the name table of
+        // the source manager, the target may have registered names in a different order.
+        buffer<parameter> ps;
+        copy_params(s, fr.m_rpos, ps);
+        new_s = m_to_manager.mk_uninterpreted_sort(s->get_name(), ps.size(), ps.data());
+    }
     else {
         buffer<parameter> ps;
         copy_params(s, fr.m_rpos, ps);
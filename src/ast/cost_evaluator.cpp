@@ -56,10 +56,7 @@ float cost_evaluator::eval(expr * f) const {
         }
         else if (fid == m_util.get_family_id()) {
             switch (to_app(f)->get_decl_kind()) {
-            case OP_NUM: {
-                rational r = to_app(f)->get_decl()->get_parameter(0).get_rational();
-                return static_cast<float>(numerator(r).get_int64())/static_cast<float>(denominator(r).get_int64());
-            } 
+            case OP_NUM:      return num_value(to_app(f));
             case OP_LE:       return E(0) <= E(1) ? 1.0f : 0.0f;
             case OP_GE:       return E(0) >= E(1) ? 1.0f : 0.0f;
             case OP_LT:       return E(0) <  E(1) ? 1.0f : 0.0f;
@@ -96,5 +93,179 @@ float cost_evaluator::operator()(expr * f, unsigned num_args, float const * args
     return eval(f);
 }
 
+float cost_evaluator::num_value(app * f) const {
+    rational r = f->get_decl()->get_parameter(0).get_rational();
+    return static_cast<float>(numerator(r).get_int64())/static_cast<float>(denominator(r).get_int64());
+}
+
+unsigned cost_evaluator::emit(program & p, program::opcode op, unsigned arg, float val) {
+    program::instr i;
+    i.m_op  = op;
+    i.m_arg = arg;
+    i.m_val = val;
+    p.m_code.push_back(i);
+    return p.m_code.size() - 1;
+}
+
+void cost_evaluator::compile(expr * f, program & p) {
+    p.m_code.reset();
+    p.m_max_stack = 0;
+    unsigned depth = 0;
+    compile(f, p, depth);
+    SASSERT(depth == 1);
+}
+
+/**
+   \brief Append the code of f to p. The code pushes the value of f on
+   the stack, depth is the size of the stack.
+*/
+void cost_evaluator::compile(expr * f, program & p, unsigned & depth) {
+#define C(IDX) compile(to_app(f)->get_arg(IDX), p, depth)
+    auto push = [&](program::opcode op, float val = 0) {
+        emit(p, op, 0, val);
+        ++depth;
+        p.m_max_stack = std::max(p.m_max_stack, depth);
+    };
+    auto binary = [&](program::opcode op) {
+        C(0);
+        C(1);
+        emit(p, op);
+        --depth;
+    };
+    auto here = [&]() { return p.m_code.size(); };
+    if (is_app(f)) {
+        family_id fid = to_app(f)->get_family_id();
+        if (fid == m.get_basic_family_id()) {
+            switch (to_app(f)->get_decl_kind()) {
+            case OP_TRUE:     push(program::PUSH, 1.0f); return;
+            case OP_FALSE:    push(program::PUSH, 0.0f); return;
+            case OP_NOT:      C(0); emit(p, program::NOT); return;
+            case OP_AND:
+            case OP_OR: {
+                // jump to the result as soon as an argument decides it
+                bool is_and = m.is_and(f);
+                unsigned_vector jumps;
+                for (expr * arg : *to_app(f)) {
+                    compile(arg, p, depth);
+                    jumps.push_back(emit(p, is_and ? program::JZ : program::JNZ));
+                    --depth;
+                }
+                push(program::PUSH, is_and ? 1.0f : 0.0f);
+                unsigned end = emit(p, program::JMP);
+                for (unsigned j : jumps)
+                    p.m_code[j].m_arg = here();
+                emit(p, program::PUSH, 0, is_and ? 0.0f : 1.0f);
+                p.m_code[end].m_arg = here();
+                return;
+            }
+            case OP_ITE: {
+                C(0);
+                unsigned jz = emit(p, program::JZ);
+                --depth;
+                C(1);
+                unsigned end = emit(p, program::JMP);
+                --depth;
+                p.m_code[jz].m_arg = here();
+                C(2);
+                p.m_code[end].m_arg = here();
+                return;
+            }
+            case OP_EQ:       binary(program::EQ); return;
+            case OP_XOR:      binary(program::NE); return;
+            case OP_IMPLIES: {
+                C(0);
+                unsigned jz = emit(p, program::JZ);
+                --depth;
+                C(1);
+                emit(p, program::BOOL);
+                unsigned end = emit(p, program::JMP);
+                p.m_code[jz].m_arg = here();
+                emit(p, program::PUSH, 0, 1.0f);
+                p.m_code[end].m_arg = here();
+                return;
+            }
+            default:
+                ;
+            }
+        }
+        else if (fid == m_util.get_family_id()) {
+            switch (to_app(f)->get_decl_kind()) {
+            case OP_NUM:      push(program::PUSH, num_value(to_app(f))); return;
+            case OP_LE:       binary(program::LE); return;
+            case OP_GE:       binary(program::GE); return;
+            case OP_LT:       binary(program::LT); return;
+            case OP_GT:       binary(program::GT); return;
+            case OP_ADD:      binary(program::ADD); return;
+            case OP_SUB:      binary(program::SUB); return;
+            case OP_UMINUS:   C(0); emit(p, program::UMINUS); return;
+            case OP_MUL:      binary(program::MUL); return;
+            case OP_DIV:      binary(program::DIV); return;
+            default:
+                ;
+            }
+        }
+    }
+    else if (is_var(f)) {
+        emit(p, program::VAR, to_var(f)->get_idx());
+        ++depth;
+        p.m_max_stack = std::max(p.m_max_stack, depth);
+        return;
+    }
+    push(program::ERROR);
+#undef C
+}
+
+float cost_evaluator::operator()(program const & p, unsigned num_args, float const * args) {
+    if (m_stack.size() < p.m_max_stack)
+        m_stack.resize(p.m_max_stack);
+    float * s = m_stack.data();
+    unsigned sp = 0;
+    unsigned pc = 0, sz = p.m_code.size();
+    while (pc < sz) {
+        program::instr const & i = p.m_code[pc++];
+        switch (i.m_op) {
+        case program::PUSH:   s[sp++] = i.m_val; break;
+        case program::VAR:
+            if (i.m_arg < num_args)
+                s[sp++] = args[num_args - i.m_arg - 1];
+            else {
+                warning_msg("cost function evaluation error");
+                s[sp++] = 1.0f;
+            }
+            break;
+        case program::NOT:    s[sp-1] = s[sp-1] == 0.0f ? 1.0f : 0.0f; break;
+        case program::EQ:     --sp; s[sp-1] = s[sp-1] == s[sp] ? 1.0f : 0.0f; break;
+        case program::NE:     --sp; s[sp-1] = s[sp-1] != s[sp] ? 1.0f : 0.0f; break;
+        case program::LE:     --sp; s[sp-1] = s[sp-1] <= s[sp] ? 1.0f : 0.0f; break;
+        case program::GE:     --sp; s[sp-1] = s[sp-1] >= s[sp] ? 1.0f : 0.0f; break;
+        case program::LT:     --sp; s[sp-1] = s[sp-1] <  s[sp] ? 1.0f : 0.0f; break;
+        case program::GT:     --sp; s[sp-1] = s[sp-1] >  s[sp] ? 1.0f : 0.0f; break;
+        case program::ADD:    --sp; s[sp-1] += s[sp]; break;
+        case program::SUB:    --sp; s[sp-1] -= s[sp]; break;
+        case program::UMINUS: s[sp-1] = - s[sp-1]; break;
+        case program::MUL:    --sp; s[sp-1] *= s[sp]; break;
+        case program::DIV:
+            --sp;
+            if (s[sp] == 0.0f) {
+                warning_msg("cost function division by zero");
+                s[sp-1] = 1.0f;
+            }
+            else
+                s[sp-1] /= s[sp];
+            break;
+        case program::BOOL:   s[sp-1] = s[sp-1] != 0.0f ? 1.0f : 0.0f; break;
+        case program::JZ:     if (s[--sp] == 0.0f) pc = i.m_arg; break;
+        case program::JNZ:    if (s[--sp] != 0.0f) pc = i.m_arg; break;
+        case program::JMP:    pc = i.m_arg; break;
+        case program::ERROR:
+            warning_msg("cost function evaluation error");
+            s[sp++] = 1.0f;
+            break;
+        }
+    }
+    SASSERT(sp == 1);
+    return s[0];
+}
+
 
 
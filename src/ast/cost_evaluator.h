@@ -22,11 +22,43 @@ Revision History:
 #include "ast/arith_decl_plugin.h"
 
 class cost_evaluator {
+public:
+    /**
+       \brief Cost function compiled to code for a stack machine.
+       The code evaluates the arguments of ite, and, or and => lazily,
+       so it produces the same values and warnings as eval.
+    */
+    class program {
+        friend class cost_evaluator;
+        enum opcode : unsigned char {
+            PUSH, VAR, NOT, EQ, NE, LE, GE, LT, GT, ADD, SUB, UMINUS, MUL, DIV,
+            BOOL,    // replace the top by 1 if it is non-zero
+            JZ,      // pop, jump if zero
+            JNZ,     // pop, jump if non-zero
+            JMP,
+            ERROR    // unsupported expression
+        };
+        struct instr {
+            opcode   m_op;
+            unsigned m_arg = 0;  // variable index or jump target
+            float    m_val = 0;
+        };
+        svector<instr> m_code;
+        unsigned       m_max_stack = 0;
+    public:
+        bool empty() const { return m_code.empty(); }
+    };
+
+private:
     ast_manager &   m;
     arith_util      m_util;
     unsigned        m_num_args;
     float const *   m_args;
+    svector<float>  m_stack;
     float eval(expr * f) const;
+    float num_value(app * f) const;
+    void compile(expr * f, program & p, unsigned & depth);
+    static unsigned emit(program & p, program::opcode op, unsigned arg = 0, float val = 0);
 public:
     cost_evaluator(ast_manager & m);
     /**
@@ -36,6 +68,18 @@ public:
        (VAR (num_args - 1)) is stored in the first position of the array.
     */
     float operator()(expr * f, unsigned num_args, float const * args);
+
+    /**
+       \brief Compile the cost function f, so that it can be evaluated
+       without traversing the expression.
+    */
+    void compile(expr * f, program & p);
+
+    /**
+       \brief Evaluate a compiled cost function. The arguments use the same
+       order as for the expression.
+    */
+    float operator()(program const & p, unsigned num_args, float const * args);
 };
 
 
@@ -60,6 +60,15 @@ Revision History:
 
 #define IS_CGR_SUPPORT true
 
+// Use direct threaded dispatch in the interpreter: every instruction jumps
+// to the handler of the next one through a table of label addresses, so each
+// handler has its own indirect branch that the predictor can learn.
+// It relies on the labels as values extension of GCC and clang and is not used
+// when instructions are traced or profiled.
+#if defined(__GNUC__) && !defined(_TRACE) && !defined(_PROFILE_MAM) && !defined(_NO_MAM_THREADED_DISPATCH)
+#define _MAM_THREADED_DISPATCH
+#endif
+
 namespace euf {
     // ------------------------------------
     //
@@ -143,6 +152,24 @@ namespace euf {
         IS_CGR
     } opcode;
 
+    // the opcodes in the order of opcode, for the dispatch table of the interpreter
+#define MAM_OPCODES(X)                                                                  \
+    X(INIT1) X(INIT2) X(INIT3) X(INIT4) X(INIT5) X(INIT6) X(INITN) X(INITAC)            \
+    X(BIND1) X(BIND2) X(BIND3) X(BIND4) X(BIND5) X(BIND6) X(BINDN)                      \
+    X(YIELD1) X(YIELD2) X(YIELD3) X(YIELD4) X(YIELD5) X(YIELD6) X(YIELDN)               \
+    X(COMPARE) X(CHECK) X(FILTER) X(CFILTER) X(PFILTER) X(CHOOSE) X(NOOP) X(CONTINUE)   \
+    X(GET_ENODE)                                                                        \
+    X(GET_CGR1) X(GET_CGR2) X(GET_CGR3) X(GET_CGR4) X(GET_CGR5) X(GET_CGR6) X(GET_CGRN) \
+    X(IS_CGR)
+
+    template<unsigned N>
+    constexpr bool opcodes_in_order(opcode const (&ops)[N]) {
+        for (unsigned i = 0; i < N; ++i)
+            if (ops[i] != i)
+                return false;
+        return true;
+    }
+
     struct instruction {
         opcode         m_opcode;
         instruction *  m_next;
@@ -2358,6 +2385,22 @@ namespace euf {
     bool interpreter::execute_core(code_tree * t, enode * n) {
         TRACE(trigger_bug, tout << "interpreter::execute_core\n"; t->display(tout); tout << "\nenode: " << mk_ismt2_pp(n->get_expr(), m) << "\n";);
         unsigned since_last_check = 0;
+#ifdef _MAM_THREADED_DISPATCH
+#define MAM_DISPATCH_ENTRY(OP) &&l_##OP,
+#define MAM_OPCODE_ENTRY(OP) OP,
+        static void * const s_dispatch[] = { MAM_OPCODES(MAM_DISPATCH_ENTRY) };
+        static constexpr opcode s_dispatch_opcodes[] = { MAM_OPCODES(MAM_OPCODE_ENTRY) };
+#undef MAM_DISPATCH_ENTRY
+#undef MAM_OPCODE_ENTRY
+        // the label of entry i must belong to opcode i
+        static_assert(sizeof(s_dispatch) / sizeof(s_dispatch[0]) == IS_CGR + 1, "dispatch table does not cover opcode");
+        static_assert(opcodes_in_order(s_dispatch_opcodes), "dispatch table is not in the order of opcode");
+#define MAM_LABEL(OP) l_##OP:
+#define MAM_NEXT() goto *s_dispatch[m_pc->m_opcode]
+#else
+#define MAM_LABEL(OP)
+#define MAM_NEXT() goto main_loop
+#endif
 
 #ifdef _PROFILE_MAM
 #ifdef _PROFILE_MAM_EXPENSIVE
@@ -2385,31 +2428,36 @@ namespace euf {
         m_top            = 0;
 
 
+#ifndef _MAM_THREADED_DISPATCH
     main_loop:
+#endif
 
         TRACE(mam_int, display_pc_info(tout););
 #ifdef _PROFILE_MAM
         const_cast<instruction*>(m_pc)->m_counter++;
+#endif
+#ifdef _MAM_THREADED_DISPATCH
+        goto *s_dispatch[m_pc->m_opcode];
 #endif
         switch (m_pc->m_opcode) {
-        case INIT1:
+        case INIT1: MAM_LABEL(INIT1)
             m_app          = m_registers[0];
             if (m_app->num_args() != 1)
                 goto backtrack;
             m_registers[1] = m_app->get_arg(0);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case INIT2:
+        case INIT2: MAM_LABEL(INIT2)
             m_app          = m_registers[0];
             if (m_app->num_args() != 2)
                 goto backtrack;
             m_registers[1] = m_app->get_arg(0);
             m_registers[2] = m_app->get_arg(1);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case INIT3:
+        case INIT3: MAM_LABEL(INIT3)
             m_app          = m_registers[0];
             if (m_app->num_args() != 3)
                 goto backtrack;
@@ -2417,9 +2465,9 @@ namespace euf {
             m_registers[2] = m_app->get_arg(1);
             m_registers[3] = m_app->get_arg(2);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case INIT4:
+        case INIT4: MAM_LABEL(INIT4)
             m_app          = m_registers[0];
             if (m_app->num_args() != 4)
                 goto backtrack;
@@ -2428,9 +2476,9 @@ namespace euf {
             m_registers[3] = m_app->get_arg(2);
             m_registers[4] = m_app->get_arg(3);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case INIT5:
+        case INIT5: MAM_LABEL(INIT5)
             m_app          = m_registers[0];
             if (m_app->num_args() != 5)
                 goto backtrack;
@@ -2440,9 +2488,9 @@ namespace euf {
             m_registers[4] = m_app->get_arg(3);
             m_registers[5] = m_app->get_arg(4);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case INIT6:
+        case INIT6: MAM_LABEL(INIT6)
             m_app          = m_registers[0];
             if (m_app->num_args() != 6)
                 goto backtrack;
@@ -2453,9 +2501,9 @@ namespace euf {
             m_registers[5] = m_app->get_arg(4);
             m_registers[6] = m_app->get_arg(5);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case INITN:
+        case INITN: MAM_LABEL(INITN)
             m_app      = m_registers[0];
             m_num_args = m_app->num_args();
             if (m_num_args != static_cast<const initn *>(m_pc)->m_num_args)
@@ -2463,9 +2511,9 @@ namespace euf {
             for (unsigned i = 0; i < m_num_args; ++i)
                 m_registers[i+1] = m_app->get_arg(i);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case INITAC: {
+        case INITAC: MAM_LABEL(INITAC) {
             m_app = m_registers[0];
             m_acargs.reset();
             m_acargs.push_back(m_app);
@@ -2504,10 +2552,10 @@ namespace euf {
                 m_registers[i + 1] = m_acargs[i];
             }
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
         }
 
-        case COMPARE:
+        case COMPARE: MAM_LABEL(COMPARE)
             m_n1 = m_registers[static_cast<const compare *>(m_pc)->m_reg1];
             m_n2 = m_registers[static_cast<const compare *>(m_pc)->m_reg2];
             SASSERT(m_n1 != 0);
@@ -2516,9 +2564,9 @@ namespace euf {
                 goto backtrack;
             
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case CHECK:
+        case CHECK: MAM_LABEL(CHECK)
             m_n1 = m_registers[static_cast<const check *>(m_pc)->m_reg];
             m_n2 = static_cast<const check *>(m_pc)->m_enode;
             SASSERT(m_n1 != 0);
@@ -2527,39 +2575,39 @@ namespace euf {
                 goto backtrack;
 
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
             /* CFILTER AND FILTER are handled differently by the compiler
                The compiler will never merge two CFILTERs with different m_lbl_set fields.
                Essentially, CFILTER is used to combine CHECK statements, and FILTER for BIND
             */
-        case CFILTER:
-        case FILTER:
+        case CFILTER: MAM_LABEL(CFILTER)
+        case FILTER: MAM_LABEL(FILTER)
             m_n1 = m_registers[static_cast<const filter *>(m_pc)->m_reg]->get_root();
             if (static_cast<const filter *>(m_pc)->m_lbl_set.empty_intersection(m_n1->get_lbls()))
                 goto backtrack;
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case PFILTER:
+        case PFILTER: MAM_LABEL(PFILTER)
             m_n1 = m_registers[static_cast<const filter *>(m_pc)->m_reg]->get_root();
             if (static_cast<const filter *>(m_pc)->m_lbl_set.empty_intersection(m_n1->get_plbls()))
                 goto backtrack;
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case CHOOSE:
+        case CHOOSE: MAM_LABEL(CHOOSE)
             m_backtrack_stack[m_top].m_instr                = m_pc;
             m_backtrack_stack[m_top].m_old_max_generation   = m_max_generation;
             m_top++;
             m_pc = m_pc->m_next;
-            goto main_loop;
-        case NOOP:
+            MAM_NEXT();
+        case NOOP: MAM_LABEL(NOOP)
             SASSERT(static_cast<const choose *>(m_pc)->m_alt == 0);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BIND1:
+        case BIND1: MAM_LABEL(BIND1)
 #define BIND_COMMON()                                                                                                   \
                  m_n1   = m_registers[static_cast<const bind *>(m_pc)->m_ireg];                                         \
                  SASSERT(m_n1 != 0);                                                                                    \
@@ -2578,33 +2626,33 @@ namespace euf {
             BIND_COMMON();
             m_registers[m_oreg] = m_app->get_arg(0);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BIND2:
+        case BIND2: MAM_LABEL(BIND2)
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BIND3:
+        case BIND3: MAM_LABEL(BIND3)
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_registers[m_oreg+2] = m_app->get_arg(2);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BIND4:
+        case BIND4: MAM_LABEL(BIND4)
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_registers[m_oreg+2] = m_app->get_arg(2);
             m_registers[m_oreg+3] = m_app->get_arg(3);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BIND5:
+        case BIND5: MAM_LABEL(BIND5)
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
@@ -2612,9 +2660,9 @@ namespace euf {
             m_registers[m_oreg+3] = m_app->get_arg(3);
             m_registers[m_oreg+4] = m_app->get_arg(4);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BIND6:
+        case BIND6: MAM_LABEL(BIND6)
             BIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
@@ -2623,17 +2671,17 @@ namespace euf {
             m_registers[m_oreg+4] = m_app->get_arg(4);
             m_registers[m_oreg+5] = m_app->get_arg(5);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case BINDN:
+        case BINDN: MAM_LABEL(BINDN)
             BIND_COMMON();
             m_num_args = static_cast<const bind *>(m_pc)->m_num_args;
             for (unsigned i = 0; i < m_num_args; ++i)
                 m_registers[m_oreg+i] = m_app->get_arg(i);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case YIELD1:
+        case YIELD1: MAM_LABEL(YIELD1)
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
 #define ON_MATCH(NUM)                                                                                   \
             m_max_generation = std::max(m_max_generation, get_max_generation(NUM, m_bindings.begin())); \
@@ -2650,20 +2698,20 @@ namespace euf {
             ON_MATCH(1);
             goto backtrack;
 
-        case YIELD2:
+        case YIELD2: MAM_LABEL(YIELD2)
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[1]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
             ON_MATCH(2);
             goto backtrack;
 
-        case YIELD3:
+        case YIELD3: MAM_LABEL(YIELD3)
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[2]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[1]];
             m_bindings[2] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[0]];
             ON_MATCH(3);
             goto backtrack;
 
-        case YIELD4:
+        case YIELD4: MAM_LABEL(YIELD4)
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[3]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[2]];
             m_bindings[2] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[1]];
@@ -2671,7 +2719,7 @@ namespace euf {
             ON_MATCH(4);
             goto backtrack;
 
-        case YIELD5:
+        case YIELD5: MAM_LABEL(YIELD5)
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[4]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[3]];
             m_bindings[2] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[2]];
@@ -2680,7 +2728,7 @@ namespace euf {
             ON_MATCH(5);
             goto backtrack;
 
-        case YIELD6:
+        case YIELD6: MAM_LABEL(YIELD6)
             m_bindings[0] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[5]];
             m_bindings[1] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[4]];
             m_bindings[2] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[3]];
@@ -2690,19 +2738,19 @@ namespace euf {
             ON_MATCH(6);
             goto backtrack;
 
-        case YIELDN:
+        case YIELDN: MAM_LABEL(YIELDN)
             m_num_args = static_cast<const yield *>(m_pc)->m_num_bindings;
             for (unsigned i = 0; i < m_num_args; ++i)
                 m_bindings[i] = m_registers[static_cast<const yield *>(m_pc)->m_bindings[m_num_args - i - 1]];
             ON_MATCH(m_num_args);
             goto backtrack;
 
-        case GET_ENODE:
+        case GET_ENODE: MAM_LABEL(GET_ENODE)
             m_registers[static_cast<const get_enode_instr *>(m_pc)->m_oreg] = static_cast<const get_enode_instr *>(m_pc)->m_enode;
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case GET_CGR1:
+        case GET_CGR1: MAM_LABEL(GET_CGR1)
 
 #define SET_VAR(IDX)                                                                                                                         \
             m_args[IDX] = m_registers[static_cast<const get_cgr *>(m_pc)->m_iregs[IDX]];                                                     \
@@ -2713,25 +2761,25 @@ namespace euf {
             SET_VAR(0);
             goto cgr_common;
 
-        case GET_CGR2:
+        case GET_CGR2: MAM_LABEL(GET_CGR2)
             SET_VAR(0);
             SET_VAR(1);
             goto cgr_common;
 
-        case GET_CGR3:
+        case GET_CGR3: MAM_LABEL(GET_CGR3)
             SET_VAR(0);
             SET_VAR(1);
             SET_VAR(2);
             goto cgr_common;
 
-        case GET_CGR4:
+        case GET_CGR4: MAM_LABEL(GET_CGR4)
             SET_VAR(0);
             SET_VAR(1);
             SET_VAR(2);
             SET_VAR(3);
             goto cgr_common;
 
-        case GET_CGR5:
+        case GET_CGR5: MAM_LABEL(GET_CGR5)
             SET_VAR(0);
             SET_VAR(1);
             SET_VAR(2);
@@ -2739,7 +2787,7 @@ namespace euf {
             SET_VAR(4);
             goto cgr_common;
 
-        case GET_CGR6:
+        case GET_CGR6: MAM_LABEL(GET_CGR6)
             SET_VAR(0);
             SET_VAR(1);
             SET_VAR(2);
@@ -2748,20 +2796,20 @@ namespace euf {
             SET_VAR(5);
             goto cgr_common;
 
-        case GET_CGRN:
+        case GET_CGRN: MAM_LABEL(GET_CGRN)
             m_num_args = static_cast<const get_cgr *>(m_pc)->m_num_args;
             m_args.reserve(m_num_args, 0);
             for (unsigned i = 0; i < m_num_args; ++i)
                 m_args[i] = m_registers[static_cast<const get_cgr *>(m_pc)->m_iregs[i]];
             goto cgr_common;
 
-        case IS_CGR:
+        case IS_CGR: MAM_LABEL(IS_CGR)
             if (!exec_is_cgr(static_cast<const is_cgr *>(m_pc)))
                 goto backtrack;
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
-        case CONTINUE:
+        case CONTINUE: MAM_LABEL(CONTINUE)
             m_num_args = static_cast<const cont *>(m_pc)->m_num_args;
             m_oreg     = static_cast<const cont *>(m_pc)->m_oreg;
             m_app = init_continue(static_cast<const cont *>(m_pc), m_num_args);
@@ -2772,7 +2820,7 @@ namespace euf {
             for (unsigned i = 0; i < m_num_args; ++i)
                 m_registers[m_oreg+i] = m_app->get_arg(i);
             m_pc = m_pc->m_next;
-            goto main_loop;
+            MAM_NEXT();
         }
 
         goto backtrack;
@@ -2784,7 +2832,7 @@ namespace euf {
         update_max_generation(m_n1, nullptr);                                                                                                                  
         m_registers[static_cast<const get_cgr *>(m_pc)->m_oreg] = m_n1;                                                                                        
         m_pc = m_pc->m_next;                                                                                                                                   
-        goto main_loop;
+        MAM_NEXT();
 
     backtrack:
         TRACE(mam_int, tout << "backtracking.\n";);
@@ -2829,7 +2877,7 @@ namespace euf {
             TRACE(mam_int, tout << "alt: " << m_pc << "\n";);
             SASSERT(m_pc != 0);
             m_top--;
-            goto main_loop;
+            MAM_NEXT();
         case BIND1:
 #define BBIND_COMMON() m_b   = static_cast<const bind*>(bp.m_instr);                                                            \
                        m_n1  = m_registers[m_b->m_ireg];                                                                        \
@@ -2846,14 +2894,14 @@ namespace euf {
             BBIND_COMMON();
             m_registers[m_oreg] = m_app->get_arg(0);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         case BIND2:
             BBIND_COMMON();
             m_registers[m_oreg]   = m_app->get_arg(0);
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_pc = m_b->m_next;
-                goto main_loop;
+                MAM_NEXT();
 
         case BIND3:
             BBIND_COMMON();
@@ -2861,7 +2909,7 @@ namespace euf {
             m_registers[m_oreg+1] = m_app->get_arg(1);
             m_registers[m_oreg+2] = m_app->get_arg(2);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         case BIND4:
             BBIND_COMMON();
@@ -2870,7 +2918,7 @@ namespace euf {
             m_registers[m_oreg+2] = m_app->get_arg(2);
             m_registers[m_oreg+3] = m_app->get_arg(3);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         case BIND5:
             BBIND_COMMON();
@@ -2880,7 +2928,7 @@ namespace euf {
             m_registers[m_oreg+3] = m_app->get_arg(3);
             m_registers[m_oreg+4] = m_app->get_arg(4);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         case BIND6:
             BBIND_COMMON();
@@ -2891,7 +2939,7 @@ namespace euf {
             m_registers[m_oreg+4] = m_app->get_arg(4);
             m_registers[m_oreg+5] = m_app->get_arg(5);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         case BINDN:
             BBIND_COMMON();
@@ -2899,7 +2947,7 @@ namespace euf {
             for (unsigned i = 0; i < m_num_args; ++i)
                 m_registers[m_oreg+i] = m_app->get_arg(i);
             m_pc = m_b->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         case INITAC:
             // this is a backtracking point.
@@ -2908,7 +2956,7 @@ namespace euf {
                 goto backtrack;
             }            
             m_pc = bp.m_instr->m_next;
-            goto main_loop;
+            MAM_NEXT();
 
         case CONTINUE: {
             auto &bp_rest = bp.m_rest;
@@ -2936,7 +2984,7 @@ namespace euf {
                     for (unsigned i = 0; i < m_num_args; ++i)
                         m_registers[m_oreg+i] = m_app->get_arg(i);
                     m_pc = c->m_next;
-                    goto main_loop;
+                    MAM_NEXT();
                 }
             }
             // continue failed
@@ -2950,6 +2998,8 @@ namespace euf {
         }
         return false;
     } // end of execute_core
+#undef MAM_LABEL
+#undef MAM_NEXT
 
 #if 0
     void display_trees(std::ostream & out, const ptr_vector<code_tree> & trees) {
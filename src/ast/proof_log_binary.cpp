@@ -0,0 +1,47 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    proof_log_binary.cpp
+
+Abstract:
+
+    Binary clause proof logs (solver.proof.log_binary).
+
+--*/
+
+#include "ast/proof_log_binary.h"
+
+proof_log_binary_writer::proof_log_binary_writer(ast_manager& m, std::ostream& out, unsigned max_defined):
+    m_out(out),
+    m_writer(m),
+    m_max_defined(max_defined) {
+}
+
+/**
+   \brief Append a record to the log.
+   The stream is not flushed after every record, the ostream buffers the writes.
+*/
+void proof_log_binary_writer::log(proof_log_record r, unsigned n, expr* const* lits, expr* hint) {
+    if (m_writer.num_defined() >= m_max_defined)
+        m_writer.reset();
+    m_writer.write_unsigned(static_cast<unsigned>(r));
+    m_writer.write_exprs(n, lits);
+    if (r == proof_log_record::infer)
+        m_writer.write_ast(hint);
+    m_writer.flush(m_out);
+}
+
+bool proof_log_binary_reader::next(proof_log_record& r, expr_ref_vector& lits, expr_ref& hint) {
+    if (m_reader.at_end())
+        return false;
+    uint64_t k = m_reader.read_unsigned();
+    if (k > static_cast<unsigned>(proof_log_record::del))
+        throw default_exception("unknown record in proof log");
+    r = static_cast<proof_log_record>(k);
+    lits.reset();
+    m_reader.read_exprs(lits);
+    hint = r == proof_log_record::infer ? m_reader.read_expr() : nullptr;
+    return true;
+}
@@ -0,0 +1,53 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    proof_log_binary.h
+
+Abstract:
+
+    Binary clause proof logs (solver.proof.log_binary).
+
+    The log is an ast_binary stream of records. Every record is its
+    kind followed by the literals of the clause and, for inferences,
+    by the proof hint.
+
+    Terms are shared with earlier records, so a record only defines the
+    sub-terms that were not logged before. To keep the memory of the
+    writer bounded, its tables are reset once they hold a given number
+    of terms. Later records define the terms they use again.
+
+--*/
+#pragma once
+
+#include "ast/ast_binary.h"
+
+enum class proof_log_record : unsigned char {
+    assume,
+    infer,
+    del
+};
+
+class proof_log_binary_writer {
+    std::ostream&      m_out;
+    ast_binary_writer  m_writer;
+    unsigned           m_max_defined;
+public:
+    proof_log_binary_writer(ast_manager& m, std::ostream& out, unsigned max_defined = 1 << 16);
+
+    void log(proof_log_record r, unsigned n, expr* const* lits, expr* hint);
+
+    unsigned num_defined() const { return m_writer.num_defined(); }
+};
+
+class proof_log_binary_reader {
+    ast_binary_reader m_reader;
+public:
+    proof_log_binary_reader(ast_manager& m, std::istream& in): m_reader(m, in) {}
+
+    /**
+       \brief Read the next record. Returns false at the end of the log.
+    */
+    bool next(proof_log_record& r, expr_ref_vector& lits, expr_ref& hint);
+};
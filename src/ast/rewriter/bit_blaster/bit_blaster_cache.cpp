@@ -0,0 +1,93 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    bit_blaster_cache.cpp
+
+Abstract:
+
+    Cache of bit-blasted circuits.
+
+--*/
+#include "ast/rewriter/bit_blaster/bit_blaster_cache.h"
+
+bit_blaster_cache::bit_blaster_cache(ast_manager & m):
+    m_bits(m),
+    m_table(DEFAULT_HASHTABLE_INITIAL_CAPACITY, entry_hash(*this), entry_eq(*this)) {
+}
+
+bool bit_blaster_cache::entry_eq::operator()(int i, int j) const {
+    entry const & e1 = m_cache.m_entries[i];
+    entry const & e2 = m_cache.m_entries[j];
+    if (e1.m_op != e2.m_op || e1.m_num_args != e2.m_num_args)
+        return false;
+    expr * const * b1 = m_cache.m_bits.data() + e1.m_offset;
+    expr * const * b2 = m_cache.m_bits.data() + e2.m_offset;
+    for (unsigned k = 0; k < e1.m_num_args; ++k)
+        if (b1[k] != b2[k])
+            return false;
+    return true;
+}
+
+void bit_blaster_cache::push_key(decl_kind op, unsigned sz, expr * const * in1, expr * const * in2) {
+    unsigned offset = m_bits.size();
+    unsigned h = combine_hash(op, sz);
+    for (unsigned i = 0; i < sz; ++i) {
+        m_bits.push_back(in1[i]);
+        h = combine_hash(h, in1[i]->get_id());
+    }
+    if (in2) {
+        for (unsigned i = 0; i < sz; ++i) {
+            m_bits.push_back(in2[i]);
+            h = combine_hash(h, in2[i]->get_id());
+        }
+    }
+    m_entries.push_back({ op, offset, m_bits.size() - offset, 0, h });
+}
+
+bool bit_blaster_cache::find(decl_kind op, unsigned sz, expr * const * in1, expr * const * in2, expr_ref_vector & out) {
+    unsigned offset = m_bits.size();
+    int idx = m_entries.size();
+    push_key(op, sz, in1, in2);
+    int other;
+    bool found = m_table.find(idx, other);
+    m_entries.pop_back();
+    m_bits.shrink(offset);
+    if (!found) {
+        m_num_misses++;
+        return false;
+    }
+    m_num_hits++;
+    entry const & e = m_entries[other];
+    expr * const * bits = m_bits.data() + e.m_offset + e.m_num_args;
+    out.append(e.m_num_out, bits);
+    return true;
+}
+
+void bit_blaster_cache::insert(decl_kind op, unsigned sz, expr * const * in1, expr * const * in2, expr_ref_vector const & out) {
+    unsigned num_bits = (in2 ? 2 : 1) * sz + out.size();
+    if (num_bits > m_max_size)
+        return;
+    if (m_bits.size() + num_bits > m_max_size) {
+        reset();
+        m_num_resets++;
+    }
+    int idx = m_entries.size();
+    push_key(op, sz, in1, in2);
+    m_bits.append(out);
+    m_entries.back().m_num_out = out.size();
+    m_table.insert(idx);
+}
+
+void bit_blaster_cache::reset() {
+    m_table.reset();
+    m_entries.reset();
+    m_bits.reset();
+}
+
+void bit_blaster_cache::collect_statistics(statistics & st) const {
+    st.update("bv blast cache hits", m_num_hits);
+    st.update("bv blast cache misses", m_num_misses);
+    st.update("bv blast cache resets", m_num_resets);
+}
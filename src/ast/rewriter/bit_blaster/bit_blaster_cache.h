@@ -0,0 +1,81 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    bit_blaster_cache.h
+
+Abstract:
+
+    Cache of bit-blasted circuits.
+
+    An entry maps an operation and the bits of its arguments to the bits
+    of the result. The bits are hash-consed expressions, so the same
+    operation on the same argument bits is blasted only once, even after
+    the terms that produced it were discarded by a pop. The cache is not
+    scoped, it pins the bits of every entry until it is reset. It is reset
+    when an insertion would make it pin more than its maximal number of
+    bits.
+
+    The cache only saves building the circuit expressions. The literals and
+    clauses of a circuit belong to the scope in which it was internalized,
+    so after a pop the cached bits are internalized again. Only theory_bv
+    of the smt core uses the cache; goal2sat and inc_sat_solver do not.
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "util/hashtable.h"
+#include "util/statistics.h"
+
+class bit_blaster_cache {
+    struct entry {
+        decl_kind m_op;
+        unsigned  m_offset;    // position of the argument bits in m_bits
+        unsigned  m_num_args;  // number of argument bits
+        unsigned  m_num_out;   // number of result bits, they follow the argument bits
+        unsigned  m_hash;
+    };
+
+    struct entry_hash {
+        bit_blaster_cache & m_cache;
+        entry_hash(bit_blaster_cache & c): m_cache(c) {}
+        unsigned operator()(int i) const { return m_cache.m_entries[i].m_hash; }
+    };
+
+    struct entry_eq {
+        bit_blaster_cache & m_cache;
+        entry_eq(bit_blaster_cache & c): m_cache(c) {}
+        bool operator()(int i, int j) const;
+    };
+
+    expr_ref_vector                       m_bits;
+    svector<entry>                        m_entries;
+    int_hashtable<entry_hash, entry_eq>   m_table;
+    unsigned                              m_num_hits = 0;
+    unsigned                              m_num_misses = 0;
+    unsigned                              m_num_resets = 0;
+    unsigned                              m_max_size = UINT_MAX;
+
+    void push_key(decl_kind op, unsigned sz, expr * const * in1, expr * const * in2);
+
+public:
+    bit_blaster_cache(ast_manager & m);
+
+    /**
+       \brief Retrieve the bits of op applied to the bit-vectors in1 and in2
+       of size sz. in2 is null for unary operations.
+    */
+    bool find(decl_kind op, unsigned sz, expr * const * in1, expr * const * in2, expr_ref_vector & out);
+
+    void insert(decl_kind op, unsigned sz, expr * const * in1, expr * const * in2, expr_ref_vector const & out);
+
+    unsigned size() const { return m_entries.size(); }
+
+    void set_max_size(unsigned max_size) { m_max_size = max_size; }
+
+    void reset();
+
+    void collect_statistics(statistics & st) const;
+};
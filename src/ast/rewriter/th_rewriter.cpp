@@ -42,6 +42,7 @@ Notes:
 #include "ast/well_sorted.h"
 #include "ast/for_each_expr.h"
 #include "ast/array_peq.h"
+#include "util/profile.h"
 
 namespace {
 struct th_rewriter_cfg : public default_rewriter_cfg {
@@ -1085,6 +1086,7 @@ void th_rewriter::reset() {
 }
 
 void th_rewriter::operator()(expr_ref & term) {
+    PROFILE_SCOPE("th_rewriter");
     expr_ref result(term.get_manager());    
     try {
         m_imp->operator()(term, result);
@@ -1098,6 +1100,7 @@ void th_rewriter::operator()(expr_ref & term) {
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result) {
+    PROFILE_SCOPE("th_rewriter");
     try {
         m_imp->operator()(t, result);
     }
@@ -1110,6 +1113,7 @@ void th_rewriter::operator()(expr * t, expr_ref & result) {
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result, proof_ref & result_pr) {
+    PROFILE_SCOPE("th_rewriter");
     try {
         m_imp->operator()(t, result, result_pr);
     }
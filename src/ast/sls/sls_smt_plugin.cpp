@@ -56,8 +56,14 @@ namespace sls {
         m_sls_model = nullptr;
         m_ddfw = alloc(sat::ddfw);
         m_ddfw->set_plugin(this);
-        m_ddfw->updt_params(ctx.get_params());
-        m_context.updt_params(ctx.get_params());
+        params_ref p = ctx.get_params();
+        if (m_seed_offset > 0) {
+            unsigned seed = smt_params_helper(p).random_seed() + m_seed_offset;
+            p.set_uint("random_seed", seed);
+            m_ddfw->set_seed(seed);
+        }
+        m_ddfw->updt_params(p);
+        m_context.updt_params(p);
 
         for (auto const& clause : clauses) {
             m_ddfw->add(clause.size(), clause.data());
@@ -210,12 +216,12 @@ namespace sls {
     void smt_plugin::import_phase_from_smt() {
         if (m_has_new_sat_phase)
             return;
-        m_has_new_sat_phase = true;
         IF_VERBOSE(3, verbose_stream() << "new SMT -> SLS phase\n");
         ctx.set_has_new_best_phase(false);
         std::lock_guard<std::mutex> lock(m_mutex);
         for (auto v : m_shared_bool_vars) 
             m_sat_phase[v] = ctx.get_best_phase(v);
+        m_has_new_sat_phase = true;
     }
 
     bool smt_plugin::export_to_sls() {    
@@ -242,15 +248,12 @@ namespace sls {
     }
     
     void smt_plugin::export_phase_to_sls() {
-#if 0
         IF_VERBOSE(2, verbose_stream() << "SMT -> SLS phase\n");
+        // only bias the next restart, flipping the current assignment disturbs the search
         for (auto v : m_shared_bool_vars) {
             auto w = m_smt_bool_var2sls_bool_var[v];
-            if (m_sat_phase[v] != is_true(sat::literal(w, false))) 
-                flip(w);            
             m_ddfw->bias(w) = m_sat_phase[v] ? 1 : -1;
         }
-#endif
     }
 
     void smt_plugin::export_values_to_sls() {
@@ -281,17 +284,20 @@ namespace sls {
     void smt_plugin::smt_values_to_sls() {
 
         if (true || ctx.parallel_mode()) {
-            std::scoped_lock lock(m_mutex);
-            m_sync_var_values.reset();
-            for (auto const& [t, t_sync] : m_smt2sync_uninterp) {
-                expr_ref val_t(m);
-                if (!ctx.get_smt_value(t, val_t))
-                    continue;
-                auto t_sync_ref = expr_ref(t_sync, m_sync);
-                auto val_sync = expr_ref(m_smt2sync_tr(val_t.get()), m_sync);
-                m_sync_var_values.push_back({ t_sync_ref, val_sync });
+            {
+                std::scoped_lock lock(m_mutex);
+                m_sync_var_values.reset();
+                for (auto const& [t, t_sync] : m_smt2sync_uninterp) {
+                    expr_ref val_t(m);
+                    if (!ctx.get_smt_value(t, val_t))
+                        continue;
+                    auto t_sync_ref = expr_ref(t_sync, m_sync);
+                    auto val_sync = expr_ref(m_smt2sync_tr(val_t.get()), m_sync);
+                    m_sync_var_values.push_back({ t_sync_ref, val_sync });
+                }
+                m_has_new_smt_values = true;
             }
-            m_has_new_smt_values = true;
+            import_phase_from_smt();
             return;
         }
 #if 0
@@ -414,6 +420,59 @@ namespace sls {
         m_has_new_sls_values = false;
     }
 
+    /**
+     * Retrieve the values of the shared uninterpreted terms in the last assignment
+     * saved by the walker, translated to the manager of the SMT engine.
+     */
+    bool smt_plugin::get_sls_values(vector<std::pair<expr_ref, expr_ref>>& values) {
+        values.reset();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_has_new_sls_values)
+            return false;
+        ast_translation tr(m_sync, m);
+        for (auto const& [t, t_sync] : m_smt2sync_uninterp) {
+            expr* sync_val = m_sync_values.get(t_sync->get_id(), nullptr);
+            if (sync_val)
+                values.push_back({ expr_ref(t, m), expr_ref(tr(sync_val), m) });
+        }
+        m_has_new_sls_values = false;
+        return true;
+    }
+
+    void smt_plugin::get_sls_phase(sat::literal_vector& phase) {
+        phase.reset();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_has_new_sls_phase)
+            return;
+        for (auto v : m_shared_bool_vars)
+            phase.push_back(sat::literal(v, !m_sls_phase[v]));
+        m_has_new_sls_phase = false;
+    }
+
+    /**
+     * Hand values of another walker to this walker. They are imported
+     * like the values of the SMT engine.
+     */
+    void smt_plugin::values_to_sls(vector<std::pair<expr_ref, expr_ref>> const& values) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sync_var_values.reset();
+        for (auto const& [t, val] : values) {
+            expr* t_sync = nullptr;
+            if (!m_smt2sync_uninterp.find(t, t_sync))
+                continue;
+            m_sync_var_values.push_back({ expr_ref(t_sync, m_sync), expr_ref(m_smt2sync_tr(val.get()), m_sync) });
+        }
+        m_has_new_smt_values = true;
+    }
+
+    void smt_plugin::phase_to_sls(sat::literal_vector const& phase) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto lit : phase)
+            if (m_shared_bool_vars.contains(lit.var()))
+                m_sat_phase[lit.var()] = !lit.sign();
+        m_has_new_sat_phase = true;
+    }
+
     void smt_plugin::add_shared_term(expr* t) {
         m_shared_terms.insert(t->get_id());
         if (is_uninterp(t))
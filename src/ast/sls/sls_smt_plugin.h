@@ -63,6 +63,7 @@ namespace sls {
         std::thread m_thread;
         std::mutex  m_mutex;
 
+        unsigned m_seed_offset = 0;
         unsigned m_value_smt2sls_delay = 0;
         unsigned m_value_smt2sls_delay_threshold = 50;
 
@@ -70,7 +71,7 @@ namespace sls {
         model_ref m_sls_model;
 
         bool m_new_clause_added = false; 
-        unsigned m_min_unsat_size = UINT_MAX;
+        std::atomic<unsigned> m_min_unsat_size = UINT_MAX;
         obj_map<expr, expr*> m_sls2sync_uninterp; // hashtable from sls-uninterp to sync uninterp
         obj_map<expr, expr*> m_smt2sync_uninterp; // hashtable from external uninterp to sync uninterp
         vector<std::pair<expr_ref, expr_ref>> m_sync_var_values;
@@ -114,6 +115,8 @@ namespace sls {
         void finalize(model_ref& md, ::statistics& st);
         void get_shared_clauses(vector<sat::literal_vector>& clauses);
         void updt_params(params_ref& p) {}
+        // walkers of a portfolio add distinct offsets to the random seed
+        void set_seed_offset(unsigned k) { m_seed_offset = k; }
         std::ostream& display(std::ostream& out) override;
 
         void bounded_run(unsigned max_iterations);
@@ -158,6 +161,14 @@ namespace sls {
         void sls_values_to_smt();
         void sls_activity_to_smt();
 
+        // exchange of the best assignment between walkers of a portfolio, called by the main thread
+        unsigned min_unsat_size() const { return m_min_unsat_size; }
+        bool has_new_sls_values() const { return m_has_new_sls_values; }
+        bool get_sls_values(vector<std::pair<expr_ref, expr_ref>>& values);
+        void get_sls_phase(sat::literal_vector& phase);
+        void values_to_sls(vector<std::pair<expr_ref, expr_ref>> const& values);
+        void phase_to_sls(sat::literal_vector const& phase);
+
         
         // sat_solver_context:
         vector<sat::clause_info> const& clauses() const override { return m_ddfw->clauses(); }
@@ -53,6 +53,7 @@ Notes:
 #include "cmd_context/basic_cmds.h"
 #include "cmd_context/cmd_context.h"
 #include "solver/slice_solver.h"
+#include "solver/query_cache_solver.h"
 #include <iostream>
 
 func_decls::func_decls(ast_manager & m, func_decl * f):
@@ -679,6 +680,8 @@ opt_wrapper* cmd_context::get_opt() {
 }
 
 void cmd_context::set_opt(opt_wrapper* opt) {
+    if (m_num_streamed > 0)
+        throw cmd_exception("optimization is not available after assertions were streamed into the solver");
     m_opt = opt;
     for (unsigned i = 0; i < m_scopes.size(); ++i) 
         m_opt->push();
@@ -1051,6 +1054,29 @@ void cmd_context::insert(symbol const & s, object_ref * r) {
     m_object_refs.insert(s, r);
 }
 
+bool cmd_context::import_decls(cmd_context const & src) {
+    SASSERT(&src.m() == &m());
+    for (auto const & [s, p] : src.m_psort_decls) {
+        if (m_psort_decls.contains(s))
+            continue;
+        if (!p->is_user_decl() || p->get_num_params() > 0)
+            return false;
+        insert(s, pm().mk_psort_user_decl(0, s, pm().mk_psort_cnst(p->instantiate(src.pm()))));
+    }
+    for (auto const & [s, decls] : src.m_func_decls) {
+        func_decls fs = decls;
+        func_decls & dst = m_func_decls.insert_if_not_there(s, func_decls());
+        for (unsigned i = 0; i < fs.get_num_entries(); ++i)
+            dst.insert(m(), fs.get_entry(i));
+    }
+    for (auto const & [s, decls] : src.m_macros) {
+        macro_decls & dst = m_macros.insert_if_not_there(s, macro_decls());
+        for (macro_decl const & d : decls)
+            dst.insert(m(), d.m_domain.size(), d.m_domain.data(), d.m_body);
+    }
+    return true;
+}
+
 void cmd_context::model_add(symbol const & s, unsigned arity, sort *const* domain, expr * t) {
 
     if (!mc0()) m_mcs.set(m_mcs.size()-1, alloc(generic_model_converter, m(), "cmd_context"));
@@ -1589,6 +1615,7 @@ void cmd_context::reset(bool finalize) {
     reset_func_decls();
     restore_assertions(0);
     m_solver = nullptr;
+    m_num_streamed = 0;
     m_mcs.reset();
     m_mcs.push_back(nullptr);
     m_scopes.reset();
@@ -1624,11 +1651,21 @@ void cmd_context::reset(bool finalize) {
     SASSERT(!m_own_manager || !has_manager());
 }
 
+void cmd_context::check_not_streamed(char const* cmd) const {
+    if (m_num_streamed > 0)
+        throw cmd_exception(std::string(cmd) + " is not available after assertions were streamed into the solver");
+}
+
 void cmd_context::assert_expr(expr * t) {
     scoped_rlimit no_limit(m().limit(), 0);
     if (!m_check_logic(t))
         throw cmd_exception(m_check_logic.get_last_error());
     m_check_sat_result = nullptr;
+    if (m_streaming && m_solver && !m_opt && !m_interactive_mode) {
+        ++m_num_streamed;
+        m_solver->assert_expr(t);
+        return;
+    }
     m().inc_ref(t);
     m_assertions.push_back(t);
     if (produce_unsat_cores())
@@ -1923,6 +1960,7 @@ void cmd_context::reset_assertions() {
     if (m_opt) {
         m_opt = nullptr;
     }
+    m_num_streamed = 0;
     if (m_solver) {
         m_solver = nullptr;
         mk_solver();
@@ -2214,6 +2252,7 @@ void cmd_context::validate_model() {
         return;
     if (!is_model_available(md))
         return;
+    check_not_streamed("model validation");
     SASSERT(md.get() != 0);
     params_ref p;
     p.set_uint("max_degree", UINT_MAX); // evaluate algebraic numbers of any degree.
@@ -2358,11 +2397,14 @@ void cmd_context::display_detailed_analysis(std::ostream& out, model_evaluator&
 }
 
 void cmd_context::mk_solver() {
+    if (m_num_streamed > 0)
+        throw cmd_exception("solver cannot be re-created after assertions were streamed into it");
     bool proofs_enabled = m().proofs_enabled(), models_enabled = true, unsat_core_enabled = true;
     params_ref p;
     m_params.get_solver_params(p, proofs_enabled, models_enabled, unsat_core_enabled);
     m_solver = (*m_solver_factory)(m(), p, proofs_enabled, models_enabled, unsat_core_enabled, m_logic);
     m_solver = mk_slice_solver(m_solver.get());
+    m_solver = mk_query_cache_solver(m_solver.get());
     if (m_simplifier_factory)
         m_solver = mk_simplifier_solver(m_solver.get(), &m_simplifier_factory);
     if (m_preferred) {
@@ -2415,6 +2457,7 @@ void cmd_context::display_statistics(bool show_total_time, double total_time) {
 
 
 vector<std::pair<expr*,expr*>> cmd_context::tracked_assertions() {
+    check_not_streamed("retrieving assertions");
     vector<std::pair<expr*,expr*>> result;
     if (assertion_names().size() == assertions().size()) {
         for (unsigned i = 0; i < assertions().size(); ++i) {
@@ -2440,6 +2483,7 @@ void cmd_context::reset_tracked_assertions() {
 }
 
 void cmd_context::display_assertions() {
+    check_not_streamed("get-assertions");
     if (!m_interactive_mode)
         throw cmd_exception("command is only available in interactive mode, use command (set-option :interactive-mode true)");
     regular_stream() << "(";
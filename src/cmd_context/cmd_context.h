@@ -247,6 +247,8 @@ protected:
     status                       m_status = UNKNOWN;
     bool                         m_numeral_as_real = false;
     bool                         m_ignore_check = false;      // used by the API to disable check-sat() commands when parsing SMT 2.0 files.
+    bool                         m_streaming = false;         // assert directly into the solver without retaining assertions.
+    unsigned                     m_num_streamed = 0;
     bool                         m_exit_on_error = false;
     bool                         m_allow_duplicate_declarations = false;
     scoped_ptr<proof_cmds>       m_proof_cmds;
@@ -393,6 +395,20 @@ public:
     void set_numeral_as_real(bool f) { m_numeral_as_real = f; }
     void set_interactive_mode(bool flag) { m_interactive_mode = flag; }
     void set_ignore_check(bool flag) { m_ignore_check = flag; }
+    /**
+       \brief In streaming mode, assertions without names are passed to the solver
+       without being retained by the context. This bounds memory on huge benchmarks,
+       but the assertions are then not available for get-assertions, model validation,
+       optimization, tactics applied to the assertions, or for re-creating the solver.
+    */
+    void set_streaming(bool flag) { m_streaming = flag; }
+    bool streaming() const { return m_streaming; }
+    /**
+       \brief Throw an exception if assertions were streamed into the solver,
+       so that the retained assertions are incomplete. \c cmd names the command
+       that needs them.
+    */
+    void check_not_streamed(char const* cmd) const;
     bool ignore_check() const { return m_ignore_check; }
     void set_exit_on_error(bool flag) { m_exit_on_error = flag; }
     bool exit_on_error() const { return m_exit_on_error; }
@@ -466,6 +482,13 @@ public:
     void model_add(symbol const & s, unsigned arity, sort *const* domain, expr * t);
     void model_del(func_decl* f);
     void register_fun(symbol const& s, func_decl* f);
+    /**
+       \brief Copy the function declarations, macros and sorts of src, a context over the
+       same manager. Theory plugins are not updated, since src already registered the
+       definitions with them. Returns false if src declares a sort with parameters or a
+       datatype. The copies are not scoped.
+    */
+    bool import_decls(cmd_context const & src);
     void insert_rec_fun(func_decl* f, expr_ref_vector const& binding, svector<symbol> const& ids, expr* e);
     func_decl * find_func_decl(symbol const & s) const;
     func_decl * find_func_decl(symbol const & s, unsigned num_indices, unsigned const * indices,
@@ -25,6 +25,7 @@ Notes:
 void assert_exprs_from(cmd_context const & ctx, goal & t) {
     if (ctx.produce_proofs() && ctx.produce_unsat_cores()) 
         throw cmd_exception("Frontend does not support simultaneous generation of proofs and unsat cores");
+    ctx.check_not_streamed("applying a tactic to the assertions");
     if (ctx.produce_unsat_cores() && ctx.assertions().size() != ctx.assertion_names().size())
         throw cmd_exception("Unsat core tracking must be set before assertions are added");
     ast_manager & m = t.m();
@@ -59,6 +59,36 @@ namespace lp {
             return a.analyze();
         }
 
+        /**
+           \brief Report the bound u on column bound_j implied by row.
+           The explanation collects the witnesses of the bounds of the
+           other columns of the row.
+        */
+        static void add_implied_bound(B & bp, const C & row, unsigned bound_j, const mpq& u, bool coeff_before_j_is_pos, bool is_lower_bound, bool strict) {
+            auto* lar = &bp.lp();
+            auto* r = &row;
+            auto explain = [r, bound_j, coeff_before_j_is_pos, is_lower_bound, strict, lar]() {
+                (void) strict;
+                TRACE(bound_analyzer, tout << "explain_bound_on_var_on_coeff, bound_j = " << bound_j << ", coeff_before_j_is_pos = " << coeff_before_j_is_pos << ", is_lower_bound = " << is_lower_bound << ", strict = " << strict << "\n";);
+                int bound_sign = (is_lower_bound ? 1 : -1);
+                int j_sign = (coeff_before_j_is_pos ? 1 : -1) * bound_sign;
+
+                u_dependency* ret = nullptr;
+                for (auto const& c : *r) {
+                    unsigned j = c.var();
+                    if (j == bound_j)
+                        continue;
+                    mpq const& a = c.coeff();
+                    int a_sign = is_pos(a) ? 1 : -1;
+                    int sign = j_sign * a_sign;
+                    u_dependency* witness = sign > 0 ? lar->get_column_upper_bound_witness(j) : lar->get_column_lower_bound_witness(j);
+                    ret = lar->join_deps(ret, witness);
+                }
+                return ret;
+            };
+            bp.add_bound(u, bound_j, is_lower_bound, strict, explain);
+        }
+
     private:
 
         unsigned analyze() {
@@ -296,28 +326,7 @@ namespace lp {
         // }
 
         void limit_j(unsigned bound_j, const mpq& u, bool coeff_before_j_is_pos, bool is_lower_bound, bool strict) {
-            auto* lar = &m_bp.lp();
-            auto* row = &this->m_row;
-            auto explain = [row, bound_j, coeff_before_j_is_pos, is_lower_bound, strict, lar]() {
-                (void) strict;
-                TRACE(bound_analyzer, tout << "explain_bound_on_var_on_coeff, bound_j = " << bound_j << ", coeff_before_j_is_pos = " << coeff_before_j_is_pos << ", is_lower_bound = " << is_lower_bound << ", strict = " << strict << "\n";);
-                int bound_sign = (is_lower_bound ? 1 : -1);
-                int j_sign = (coeff_before_j_is_pos ? 1 : -1) * bound_sign;
-
-                u_dependency* ret = nullptr;
-                for (auto const& r : *row) {
-                    unsigned j = r.var();
-                    if (j == bound_j)
-                        continue;
-                    mpq const& a = r.coeff();
-                    int a_sign = is_pos(a) ? 1 : -1;
-                    int sign = j_sign * a_sign;
-                    u_dependency* witness = sign > 0 ? lar->get_column_upper_bound_witness(j) : lar->get_column_lower_bound_witness(j);
-                    ret = lar->join_deps(ret, witness);
-                }
-                return ret;
-            };
-            m_bp.add_bound(u, bound_j, is_lower_bound, strict, explain);
+            add_implied_bound(m_bp, m_row, bound_j, u, coeff_before_j_is_pos, is_lower_bound, strict);
         }
 
         void advance_u(unsigned j) {
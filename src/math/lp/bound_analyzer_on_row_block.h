@@ -0,0 +1,234 @@
+/*++
+  Copyright (c) 2026 Microsoft Corporation
+
+  Module Name:
+
+  bound_analyzer_on_row_block.h
+
+  Abstract:
+
+  Bound propagation for a block of rows whose coefficients and relevant
+  bounds are small integers.
+
+  The rows are copied into flat column arrays: for every cell the
+  coefficient, the column, and the largest and smallest value of the
+  monoid a*x_j under the current bounds of x_j. The totals of a row are
+  then sums over contiguous int64 arrays, which the compiler can
+  vectorize, instead of sums of rationals.
+
+  The magnitudes admitted by add_row keep every product and sum far from
+  the int64 range, so the computation is exact. The implied bounds, their
+  strictness, their explanations and the order in which they are reported
+  are the same as those of bound_analyzer_on_row.
+
+  --*/
+#pragma once
+
+#include "util/vector.h"
+#include "math/lp/bound_analyzer_on_row.h"
+
+namespace lp {
+
+    template <typename C, typename B> // C is a row container, B is lp_bound_propagator
+    class bound_analyzer_on_row_block {
+        // |a| < 2^20 and |bound| < 2^31 give monoids below 2^51,
+        // and rows of at most 2^11 cells give totals below 2^62.
+        static const int64_t  max_coeff = 1ll << 20;
+        static const unsigned max_row_size = 1u << 11;
+
+        enum : unsigned char {
+            has_max    = 1,  // the monoid is bounded from above
+            has_min    = 2,  // the monoid is bounded from below
+            max_strict = 4,
+            min_strict = 8
+        };
+
+        B &                    m_bp;
+        svector<int64_t>       m_coeffs;
+        unsigned_vector        m_columns;
+        svector<int64_t>       m_max;    // a*ub(x_j) if a > 0, a*lb(x_j) otherwise
+        svector<int64_t>       m_min;    // a*lb(x_j) if a > 0, a*ub(x_j) otherwise
+        svector<unsigned char> m_flags;
+        unsigned_vector        m_row_start;
+        ptr_vector<C const>    m_rows;
+        rational               m_bound;
+
+        static bool is_small_int(const mpq& v, int64_t & r) {
+            if (!v.is_int() || !v.is_small())
+                return false;
+            r = v.get_int64();
+            return true;
+        }
+
+        bool set_bound(const impq& b, int64_t a, int64_t & r, bool & strict) const {
+            int64_t v;
+            if (!is_small_int(b.x, v))
+                return false;
+            r = a * v;
+            strict = !is_zero(b.y);
+            return true;
+        }
+
+        void limit(unsigned r, unsigned k, int64_t num, bool is_lower_bound, bool strict) {
+            int64_t a = m_coeffs[k];
+            m_bound = rational(num, rational::i64());
+            m_bound /= rational(a, rational::i64());
+            bound_analyzer_on_row<C, B>::add_implied_bound(m_bp, *m_rows[r], m_columns[k], m_bound, a > 0, is_lower_bound, strict);
+        }
+
+        // counterpart of limit_monoid_u_from_below and limit_all_monoids_from_below
+        void limit_from_below(unsigned r, unsigned s, unsigned e, unsigned num_unbounded, unsigned u) {
+            int64_t total = 0;
+            unsigned strict = 0;
+            for (unsigned k = s; k < e; ++k)
+                total -= m_max[k];
+            for (unsigned k = s; k < e; ++k)
+                strict += (m_flags[k] & max_strict) != 0;
+            if (num_unbounded == 1) {
+                // m_max[u] is zero
+                limit(r, u, total, m_coeffs[u] > 0, strict > 0);
+                return;
+            }
+            for (unsigned k = s; k < e; ++k) {
+                bool str = (m_flags[k] & max_strict) != 0;
+                limit(r, k, total + m_max[k], m_coeffs[k] > 0, strict - str > 0);
+            }
+        }
+
+        // counterpart of limit_monoid_l_from_above and limit_all_monoids_from_above
+        void limit_from_above(unsigned r, unsigned s, unsigned e, unsigned num_unbounded, unsigned l) {
+            int64_t total = 0;
+            unsigned strict = 0;
+            for (unsigned k = s; k < e; ++k)
+                total -= m_min[k];
+            for (unsigned k = s; k < e; ++k)
+                strict += (m_flags[k] & min_strict) != 0;
+            if (num_unbounded == 1) {
+                limit(r, l, total, m_coeffs[l] < 0, strict > 0);
+                return;
+            }
+            for (unsigned k = s; k < e; ++k) {
+                bool str = (m_flags[k] & min_strict) != 0;
+                limit(r, k, total + m_min[k], m_coeffs[k] < 0, strict - str > 0);
+            }
+        }
+
+        bool add_cell(unsigned j, const mpq& coeff) {
+            int64_t a;
+            if (!is_small_int(coeff, a) || a >= max_coeff || a <= -max_coeff)
+                return false;
+            auto const& lar = m_bp.lp();
+            bool has_lo = false, has_hi = false;
+            switch (lar.get_column_types()[j]) {
+            case column_type::fixed:
+            case column_type::boxed:
+                has_lo = has_hi = true;
+                break;
+            case column_type::lower_bound:
+                has_lo = true;
+                break;
+            case column_type::upper_bound:
+                has_hi = true;
+                break;
+            default:
+                break;
+            }
+            int64_t lo = 0, hi = 0;
+            bool lo_strict = false, hi_strict = false;
+            if (has_lo && !set_bound(lar.get_lower_bound(j), a, lo, lo_strict))
+                return false;
+            if (has_hi && !set_bound(lar.get_upper_bound(j), a, hi, hi_strict))
+                return false;
+            unsigned char f = 0;
+            if (a > 0) {
+                f |= (has_hi ? has_max : 0) | (hi_strict ? max_strict : 0);
+                f |= (has_lo ? has_min : 0) | (lo_strict ? min_strict : 0);
+                m_max.push_back(hi);
+                m_min.push_back(lo);
+            }
+            else {
+                f |= (has_lo ? has_max : 0) | (lo_strict ? max_strict : 0);
+                f |= (has_hi ? has_min : 0) | (hi_strict ? min_strict : 0);
+                m_max.push_back(lo);
+                m_min.push_back(hi);
+            }
+            m_coeffs.push_back(a);
+            m_columns.push_back(j);
+            m_flags.push_back(f);
+            return true;
+        }
+
+        void analyze_row(unsigned r) {
+            unsigned s = m_row_start[r], e = m_row_start[r + 1];
+            unsigned num_u = 0, num_l = 0, u = 0, l = 0;
+            for (unsigned k = s; k < e; ++k) {
+                if (!(m_flags[k] & has_max)) {
+                    ++num_u;
+                    u = k;
+                }
+                if (!(m_flags[k] & has_min)) {
+                    ++num_l;
+                    l = k;
+                }
+            }
+            if (num_u <= 1)
+                limit_from_below(r, s, e, num_u, u);
+            if (num_l <= 1)
+                limit_from_above(r, s, e, num_l, l);
+        }
+
+    public:
+        // number of rows after which a block is analyzed; it bounds the memory
+        // of the block and the work between cancellation checks of the caller.
+        static const unsigned max_rows = 256;
+
+        bound_analyzer_on_row_block(B & bp) : m_bp(bp) { m_row_start.push_back(0); }
+
+        unsigned size() const { return m_rows.size(); }
+
+        void reset() {
+            m_coeffs.reset();
+            m_columns.reset();
+            m_max.reset();
+            m_min.reset();
+            m_flags.reset();
+            m_row_start.reset();
+            m_row_start.push_back(0);
+            m_rows.reset();
+        }
+
+        /**
+           \brief Add a row with right side zero to the block.
+           Return false, and leave the block unchanged, if the coefficients
+           or the bounds of the row do not fit the machine word kernel.
+        */
+        bool add_row(const C & row) {
+            if (row.size() > max_row_size)
+                return false;
+            unsigned sz = m_coeffs.size();
+            for (auto const& c : row) {
+                if (!add_cell(c.var(), c.coeff())) {
+                    m_coeffs.shrink(sz);
+                    m_columns.shrink(sz);
+                    m_max.shrink(sz);
+                    m_min.shrink(sz);
+                    m_flags.shrink(sz);
+                    return false;
+                }
+            }
+            m_row_start.push_back(m_coeffs.size());
+            m_rows.push_back(&row);
+            return true;
+        }
+
+        /**
+           \brief Propagate the bounds implied by the rows of the block, in
+           the order they were added, and reset the block.
+        */
+        void analyze() {
+            for (unsigned r = 0; r < m_rows.size(); ++r)
+                analyze_row(r);
+            reset();
+        }
+    };
+}
@@ -0,0 +1,228 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    float_simplex.cpp
+
+Abstract:
+
+    Feasibility simplex over a double precision copy of the tableau.
+
+--*/
+#include "math/lp/float_simplex.h"
+#include <cmath>
+#include <climits>
+
+namespace lp {
+
+    // coefficients below this are treated as zero after a row operation
+    static const double s_drop_tolerance = 1e-12;
+    // smallest coefficient accepted for a pivot
+    static const double s_pivot_tolerance = 1e-9;
+
+    double float_simplex::tolerance(double bound) {
+        return 1e-9 * (1 + std::fabs(bound));
+    }
+
+    bool float_simplex::below_lower(unsigned j) const {
+        return has_lower(j) && m_x[j] < m_lower[j] - tolerance(m_lower[j]);
+    }
+
+    bool float_simplex::above_upper(unsigned j) const {
+        return has_upper(j) && m_x[j] > m_upper[j] + tolerance(m_upper[j]);
+    }
+
+    bool float_simplex::can_increase(unsigned j) const {
+        return !has_upper(j) || m_x[j] < m_upper[j] - tolerance(m_upper[j]);
+    }
+
+    bool float_simplex::can_decrease(unsigned j) const {
+        return !has_lower(j) || m_x[j] > m_lower[j] + tolerance(m_lower[j]);
+    }
+
+    void float_simplex::reset(unsigned num_rows, unsigned num_columns) {
+        m_rows.clear();
+        m_rows.resize(num_rows);
+        m_columns.clear();
+        m_columns.resize(num_columns);
+        m_basis.assign(num_rows, UINT_MAX);
+        m_heading.assign(num_columns, -1);
+        m_types.assign(num_columns, column_type::free_column);
+        m_lower.assign(num_columns, 0);
+        m_upper.assign(num_columns, 0);
+        m_x.assign(num_columns, 0);
+        m_bound_status.assign(num_columns, not_at_bound);
+        m_work.assign(num_columns, -1);
+        m_pivots = 0;
+    }
+
+    bool float_simplex::set_column(unsigned j, column_type t, double lower, double upper, double x) {
+        if (!std::isfinite(lower) || !std::isfinite(upper) || !std::isfinite(x))
+            return false;
+        m_types[j] = t;
+        m_lower[j] = lower;
+        m_upper[j] = upper;
+        m_x[j] = x;
+        return true;
+    }
+
+    bool float_simplex::add_entry(unsigned i, unsigned j, double a) {
+        if (!std::isfinite(a))
+            return false;
+        add_to_row(i, j, a);
+        return true;
+    }
+
+    void float_simplex::set_basic(unsigned i, unsigned j) {
+        m_basis[i] = j;
+        m_heading[j] = i;
+    }
+
+    void float_simplex::add_to_row(unsigned i, unsigned j, double a) {
+        auto & row = m_rows[i];
+        auto & col = m_columns[j];
+        row.push_back({ j, static_cast<unsigned>(col.size()), a });
+        col.push_back({ i, static_cast<unsigned>(row.size() - 1) });
+    }
+
+    void float_simplex::remove_entry(unsigned i, unsigned offset) {
+        auto & row = m_rows[i];
+        row_entry e = row[offset];
+        auto & col = m_columns[e.m_j];
+        if (e.m_offset + 1 != col.size()) {
+            column_entry last = col.back();
+            col[e.m_offset] = last;
+            m_rows[last.m_i][last.m_offset].m_offset = e.m_offset;
+        }
+        col.pop_back();
+        if (offset + 1 != row.size()) {
+            row_entry last = row.back();
+            row[offset] = last;
+            m_columns[last.m_j][last.m_offset].m_offset = offset;
+        }
+        row.pop_back();
+    }
+
+    /**
+       \brief row[dst] += alpha * row[src]
+    */
+    void float_simplex::add_rows(double alpha, unsigned src, unsigned dst) {
+        auto & row = m_rows[dst];
+        for (unsigned k = 0; k < row.size(); ++k)
+            m_work[row[k].m_j] = k;
+        for (row_entry const & e : m_rows[src]) {
+            int k = m_work[e.m_j];
+            if (k == -1) {
+                add_to_row(dst, e.m_j, alpha * e.m_coeff);
+                m_work[e.m_j] = static_cast<int>(row.size() - 1);
+            }
+            else
+                row[k].m_coeff += alpha * e.m_coeff;
+        }
+        for (row_entry const & e : row)
+            m_work[e.m_j] = -1;
+        for (unsigned k = static_cast<unsigned>(row.size()); k-- > 0; )
+            if (std::fabs(row[k].m_coeff) < s_drop_tolerance)
+                remove_entry(dst, k);
+    }
+
+    int float_simplex::find_entering(unsigned i, bool increase, bool bland) const {
+        unsigned bj = m_basis[i];
+        int choice = -1;
+        unsigned best_size = UINT_MAX;
+        double best_abs = 0;
+        for (row_entry const & e : m_rows[i]) {
+            unsigned j = e.m_j;
+            double a = e.m_coeff;
+            if (j == bj || std::fabs(a) < s_pivot_tolerance)
+                continue;
+            // the basic column moves by -a times the change of j
+            bool ok = (increase == (a < 0)) ? can_increase(j) : can_decrease(j);
+            if (!ok)
+                continue;
+            if (bland) {
+                if (choice == -1 || j < static_cast<unsigned>(choice))
+                    choice = j;
+                continue;
+            }
+            unsigned sz = static_cast<unsigned>(m_columns[j].size());
+            if (sz < best_size || (sz == best_size && std::fabs(a) > best_abs)) {
+                choice = j;
+                best_size = sz;
+                best_abs = std::fabs(a);
+            }
+        }
+        return choice;
+    }
+
+    /**
+       \brief Move the basic column of row i to target by changing the entering column.
+    */
+    void float_simplex::update_values(unsigned i, unsigned entering, double target) {
+        unsigned bj = m_basis[i];
+        double a = 0;
+        for (row_entry const & e : m_rows[i])
+            if (e.m_j == entering)
+                a = e.m_coeff;
+        double t = -(target - m_x[bj]) / a;
+        for (column_entry const & c : m_columns[entering])
+            m_x[m_basis[c.m_i]] -= m_rows[c.m_i][c.m_offset].m_coeff * t;
+        m_x[entering] += t;
+        m_x[bj] = target;
+    }
+
+    void float_simplex::pivot(unsigned i, unsigned entering) {
+        auto & row = m_rows[i];
+        double a = 0;
+        for (row_entry & e : row)
+            if (e.m_j == entering)
+                a = e.m_coeff;
+        for (row_entry & e : row)
+            e.m_coeff = e.m_j == entering ? 1.0 : e.m_coeff / a;
+        std::vector<std::pair<unsigned, double>> others;
+        for (column_entry const & c : m_columns[entering])
+            if (c.m_i != i)
+                others.push_back({ c.m_i, m_rows[c.m_i][c.m_offset].m_coeff });
+        for (auto const & [k, c] : others)
+            add_rows(-c, i, k);
+        unsigned leaving = m_basis[i];
+        m_heading[leaving] = -1;
+        m_heading[entering] = i;
+        m_basis[i] = entering;
+        ++m_pivots;
+    }
+
+    float_simplex::status float_simplex::solve(lp_settings& settings, unsigned max_pivots) {
+        unsigned num_rows = static_cast<unsigned>(m_rows.size());
+        while (true) {
+            if (m_pivots >= max_pivots)
+                return gave_up;
+            if (m_pivots % 64 == 0 && settings.get_cancel_flag())
+                return gave_up;
+            int row = -1;
+            unsigned leaving = UINT_MAX;
+            for (unsigned i = 0; i < num_rows; ++i) {
+                unsigned bj = m_basis[i];
+                if (bj < leaving && (below_lower(bj) || above_upper(bj))) {
+                    leaving = bj;
+                    row = i;
+                }
+            }
+            if (row == -1)
+                return feasible;
+            bool increase = below_lower(leaving);
+            // switch to Bland's rule when the search takes long, as lp_primal_core_solver does
+            int entering = find_entering(row, increase, m_pivots > num_rows);
+            if (entering == -1)
+                return infeasible;
+            double target = increase ? m_lower[leaving] : m_upper[leaving];
+            update_values(row, entering, target);
+            if (!std::isfinite(m_x[entering]))
+                return gave_up;
+            pivot(row, entering);
+            m_bound_status[leaving] = increase ? at_lower : at_upper;
+            m_bound_status[entering] = not_at_bound;
+        }
+    }
+}
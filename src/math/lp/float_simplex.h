@@ -0,0 +1,103 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    float_simplex.h
+
+Abstract:
+
+    Feasibility simplex over a double precision copy of the tableau.
+
+    The tableau is given row by row in the form used by lar_core_solver:
+    every row contains its basic column with coefficient one and the sum
+    of the row is zero. The solver repeatedly picks the infeasible basic
+    column of smallest index, moves it to its violated bound and pivots in
+    a non-basic column of its row that can compensate, as
+    lp_primal_core_solver does in the tableau_rows strategy.
+
+    The result is only a hint: the basis and the bounds at which the
+    non-basic columns rest. The caller moves the rational tableau to this
+    basis and lets the exact simplex certify feasibility or produce the
+    infeasible row.
+
+--*/
+#pragma once
+
+#include "math/lp/lp_settings.h"
+#include <vector>
+
+namespace lp {
+
+class float_simplex {
+public:
+    enum status { feasible, infeasible, gave_up };
+    enum bound_status : unsigned char { not_at_bound, at_lower, at_upper };
+
+private:
+    struct row_entry {
+        unsigned m_j;
+        unsigned m_offset;   // position in m_columns[m_j]
+        double   m_coeff;
+    };
+
+    struct column_entry {
+        unsigned m_i;
+        unsigned m_offset;   // position in m_rows[m_i]
+    };
+
+    std::vector<std::vector<row_entry>>    m_rows;
+    std::vector<std::vector<column_entry>> m_columns;
+    std::vector<unsigned>                  m_basis;     // basic column of every row
+    std::vector<int>                       m_heading;   // row of a basic column, -1 for non-basic
+    std::vector<column_type>               m_types;
+    std::vector<double>                    m_lower;
+    std::vector<double>                    m_upper;
+    std::vector<double>                    m_x;
+    std::vector<bound_status>              m_bound_status;
+    std::vector<int>                       m_work;       // offsets of the columns of a row during pivoting
+    unsigned                               m_pivots = 0;
+
+    bool has_lower(unsigned j) const { return m_types[j] != column_type::free_column && m_types[j] != column_type::upper_bound; }
+    bool has_upper(unsigned j) const { return m_types[j] != column_type::free_column && m_types[j] != column_type::lower_bound; }
+    static double tolerance(double bound);
+    bool below_lower(unsigned j) const;
+    bool above_upper(unsigned j) const;
+    bool can_increase(unsigned j) const;
+    bool can_decrease(unsigned j) const;
+
+    void add_to_row(unsigned i, unsigned j, double a);
+    void remove_entry(unsigned i, unsigned offset);
+    int find_entering(unsigned i, bool increase, bool bland) const;
+    void update_values(unsigned i, unsigned entering, double target);
+    void pivot(unsigned i, unsigned entering);
+    void add_rows(double alpha, unsigned src, unsigned dst);
+
+public:
+    void reset(unsigned num_rows, unsigned num_columns);
+
+    /**
+       \brief Set type, bounds and current value of column j.
+       Return false if one of the numbers is not finite.
+    */
+    bool set_column(unsigned j, column_type t, double lower, double upper, double x);
+
+    /**
+       \brief Add the entry a of column j to row i. Return false if a is not finite.
+    */
+    bool add_entry(unsigned i, unsigned j, double a);
+
+    void set_basic(unsigned i, unsigned j);
+
+    /**
+       \brief Search a feasible basis with at most max_pivots pivots.
+    */
+    status solve(lp_settings& settings, unsigned max_pivots);
+
+    unsigned basic(unsigned i) const { return m_basis[i]; }
+    bool is_basic(unsigned j) const { return m_heading[j] >= 0; }
+    bound_status get_bound_status(unsigned j) const { return m_bound_status[j]; }
+    unsigned pivots() const { return m_pivots; }
+};
+
+}
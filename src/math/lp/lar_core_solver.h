@@ -23,6 +23,8 @@ class lar_core_solver  {
     stacked_value<simplex_strategy_enum> m_stacked_simplex_strategy;
     vector<impq> m_r_x;  // the solution
     vector<impq> m_backup_x;
+    // pivots of the last feasibility search, including those of the double precision simplex
+    unsigned m_last_search_pivots = UINT_MAX;
 
 public:
     
@@ -110,6 +112,10 @@ public:
 
     void solve();
 
+    bool use_float_simplex() const;
+
+    unsigned crash_basis_with_float_simplex();
+
     void pivot(int entering, int leaving) { m_r_solver.pivot(entering, leaving); }
     
     bool lower_bounds_are_set() const { return true; }
@@ -14,6 +14,7 @@ Revision History:
 #include <string>
 #include "util/vector.h"
 #include "math/lp/lar_core_solver.h"
+#include "math/lp/float_simplex.h"
 namespace lp {
 lar_core_solver::lar_core_solver(
     lp_settings & settings,
@@ -95,10 +96,13 @@ void lar_core_solver::solve() {
     ++m_r_solver.m_settings.stats().m_need_to_solve_inf;
     SASSERT( r_basis_is_OK());
              
+    unsigned pivots = use_float_simplex() ? crash_basis_with_float_simplex() : 0;
+    unsigned iterations = settings().stats().m_total_iterations;
     if (m_r_solver.m_look_for_feasible_solution_only) //todo : should it be set?
          m_r_solver.find_feasible_solution();
     else 
         m_r_solver.solve();
+    m_last_search_pivots = pivots + settings().stats().m_total_iterations - iterations;
     
     SASSERT(r_basis_is_OK());
     
@@ -121,4 +125,113 @@ void lar_core_solver::solve() {
   TRACE(lar_solver, tout << m_r_solver.get_status() << "\n";);
 }
 
+/**
+   \brief Copying the tableau to double precision costs about as much as a few exact
+   pivots, so the double precision simplex is only used for feasibility searches on
+   large tableaux, and only when the previous search needed many pivots. The first
+   search always uses it.
+*/
+bool lar_core_solver::use_float_simplex() const {
+    return m_r_solver.m_look_for_feasible_solution_only &&
+        settings().float_simplex() &&
+        m_r_A.row_count() >= settings().float_simplex_min_rows() &&
+        m_last_search_pivots >= settings().float_simplex_min_pivots();
+}
+
+/**
+   \brief Run the feasibility simplex on a double precision copy of the tableau
+   and move the rational tableau to the basis it finds. Non-basic columns that the
+   double simplex left at a bound are set to the exact bound, and the basic columns
+   are updated exactly. The rational simplex then starts from this basis: it finishes
+   without pivoting when the basis is feasible, and otherwise continues from it and
+   produces the infeasible row itself.
+   Returns the number of pivots of the double precision simplex.
+*/
+unsigned lar_core_solver::crash_basis_with_float_simplex() {
+    auto & s = m_r_solver;
+    lp_settings & st = s.m_settings;
+    unsigned m = m_r_A.row_count(), n = m_r_A.column_count();
+    // a stand-in for the infinitesimal of strict bounds; the exact simplex corrects the choice
+    double delta = 1e-6;
+    auto to_double = [&](impq const& v) { return v.x.get_double() + delta * v.y.get_double(); };
+    float_simplex fs;
+    fs.reset(m, n);
+    for (unsigned j = 0; j < n; ++j) {
+        double lo = lower_bound_is_set(j) ? to_double(m_r_lower_bounds[j]) : 0;
+        double hi = upper_bound_is_set(j) ? to_double(m_r_upper_bounds[j]) : 0;
+        if (!fs.set_column(j, m_column_types[j], lo, hi, to_double(m_r_x[j])))
+            return 0;
+    }
+    for (unsigned i = 0; i < m; ++i) {
+        for (auto const& c : m_r_A.m_rows[i])
+            if (!fs.add_entry(i, c.var(), c.coeff().get_double()))
+                return 0;
+        fs.set_basic(i, m_r_basis[i]);
+    }
+    st.stats().m_float_simplex_calls++;
+    auto status = fs.solve(st, 10 * m + 1000);
+    st.stats().m_float_simplex_pivots += fs.pivots();
+    TRACE(lar_solver, tout << "float simplex status " << status << " pivots " << fs.pivots() << "\n";);
+    if (status == float_simplex::gave_up)
+        return fs.pivots();
+
+    // move the rational tableau to the basis of the double simplex
+    for (unsigned i = 0; i < m && !st.get_cancel_flag(); ++i) {
+        unsigned j = fs.basic(i);
+        if (s.m_basis_heading[j] >= 0)
+            continue;
+        int best = -1;
+        mpq best_abs;
+        for (auto const& c : m_r_A.m_columns[j]) {
+            unsigned r = c.var();
+            if (fs.is_basic(m_r_basis[r]))
+                continue;
+            mpq a = abs(m_r_A.get_val(c));
+            if (best == -1 || a > best_abs) {
+                best = r;
+                best_abs = a;
+            }
+        }
+        if (best == -1)
+            continue;
+        s.pivot(j, m_r_basis[best]);
+        st.stats().m_float_simplex_repair_pivots++;
+    }
+
+    // place the non-basic columns at their bounds and update the basic columns
+    for (unsigned j : m_r_nbasis) {
+        impq v = m_r_x[j];
+        switch (fs.get_bound_status(j)) {
+        case float_simplex::at_lower:
+            if (lower_bound_is_set(j))
+                v = m_r_lower_bounds[j];
+            break;
+        case float_simplex::at_upper:
+            if (upper_bound_is_set(j))
+                v = m_r_upper_bounds[j];
+            break;
+        default:
+            break;
+        }
+        if (lower_bound_is_set(j) && v < m_r_lower_bounds[j])
+            v = m_r_lower_bounds[j];
+        if (upper_bound_is_set(j) && v > m_r_upper_bounds[j])
+            v = m_r_upper_bounds[j];
+        if (v == m_r_x[j])
+            continue;
+        impq d = v - m_r_x[j];
+        m_r_x[j] = v;
+        for (auto const& c : m_r_A.m_columns[j])
+            m_r_x[m_r_basis[c.var()]] -= m_r_A.get_val(c) * d;
+    }
+    s.clear_inf_heap();
+    for (unsigned j : m_r_basis)
+        s.track_column_feasibility(j);
+    if (s.current_x_is_feasible())
+        st.stats().m_float_simplex_confirmed++;
+    SASSERT(s.non_basic_columns_are_set_correctly());
+    SASSERT(s.inf_heap_is_correct());
+    return fs.pivots();
+}
+
 } // namespace lp
@@ -4,6 +4,7 @@
 */
 #include "math/lp/lar_solver.h"
 #include "params/smt_params_helper.hpp"
+#include "util/profile.h"
 #include "lar_solver.h"
 
 
@@ -462,6 +463,7 @@ namespace lp {
 
     
     lp_status lar_solver::find_feasible_solution() {
+        PROFILE_SCOPE("lp.find_feasible_solution");
         stats().m_make_feasible++;
         if (A_r().column_count() > stats().m_max_cols)
             stats().m_max_cols = A_r().column_count();
@@ -27,6 +27,7 @@
 #include <utility>
 
 #include "math/lp/bound_analyzer_on_row.h"
+#include "math/lp/bound_analyzer_on_row_block.h"
 #include "math/lp/implied_bound.h"
 #include "math/lp/int_solver.h"
 #include "math/lp/lar_constraints.h"
@@ -295,11 +296,26 @@ public:
                     row_bounds_to_replay().push_back(i);
             }
         }
+        // rows with small integer coefficients and bounds are collected in blocks
+        // that are analyzed on machine integers; the other rows are analyzed
+        // one by one after the block of preceding rows is flushed.
+        // Cancellation is checked after every flush.
+        using block_analyzer = bound_analyzer_on_row_block<row_strip<mpq>, lp_bound_propagator<T>>;
+        block_analyzer block(bp);
         for (unsigned i : touched_rows()) {
-            calculate_implied_bounds_for_row(i, bp);
+            auto const& row = A_r().m_rows[i];
+            if (row.size() > settings().max_row_length_for_bound_propagation)
+                continue;
+            bool added = block.add_row(row);
+            if (added && block.size() < block_analyzer::max_rows)
+                continue;
+            block.analyze();
+            if (!added)
+                calculate_implied_bounds_for_row(i, bp);
             if (settings().get_cancel_flag())
                 return;
         }
+        block.analyze();
         touched_rows().reset();
     }
     void collect_more_rows_for_lp_propagation();
@@ -23,6 +23,7 @@ Revision History:
 #include <string>
 #include "util/vector.h"
 #include "math/lp/lp_utils.h"
+#include "util/profile.h"
 #include "math/lp/lp_core_solver_base.h"
 namespace lp {
 
@@ -249,6 +250,7 @@ divide_row_by_pivot(unsigned pivot_row, unsigned pivot_col) {
 }
 template <typename T, typename X> bool lp_core_solver_base<T, X>::
 pivot_column_tableau(unsigned j, unsigned piv_row_index) {
+    PROFILE_SCOPE("lp.pivot");
 	if (!divide_row_by_pivot(piv_row_index, j))
         return false;
     auto &column = m_A.m_columns[j];
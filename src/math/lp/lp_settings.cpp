@@ -49,6 +49,9 @@ void lp::lp_settings::updt_params(params_ref const& _p) {
     m_random_hammers = lp_p.random_hammers();
     m_lcube = lp_p.lcube();
     m_lcube_flips = lp_p.lcube_flips();
+    m_float_simplex = lp_p.float_simplex();
+    m_float_simplex_min_rows = lp_p.float_simplex_min_rows();
+    m_float_simplex_min_pivots = lp_p.float_simplex_min_pivots();
     unsigned hammer_period = lp_p.int_hammer_period();
     SASSERT(hammer_period != 0);
     m_int_find_cube_period = hammer_period;
@@ -141,6 +141,10 @@ struct statistics {
     unsigned m_bounds_tightening_conflicts = 0;
     unsigned m_bounds_tightenings = 0;
     unsigned m_nla_throttled_lemmas = 0;
+    unsigned m_float_simplex_calls = 0;
+    unsigned m_float_simplex_pivots = 0;
+    unsigned m_float_simplex_repair_pivots = 0;
+    unsigned m_float_simplex_confirmed = 0;
 
     ::statistics m_st = {};
 
@@ -184,6 +188,10 @@ struct statistics {
         st.update("arith-bounds-tightening-conflicts", m_bounds_tightening_conflicts);
         st.update("arith-bounds-tightenings", m_bounds_tightenings);
         st.update("arith-nla-throttled-lemmas", m_nla_throttled_lemmas);
+        st.update("arith-float-simplex-calls", m_float_simplex_calls);
+        st.update("arith-float-simplex-pivots", m_float_simplex_pivots);
+        st.update("arith-float-simplex-repair-pivots", m_float_simplex_repair_pivots);
+        st.update("arith-float-simplex-confirmed", m_float_simplex_confirmed);
         st.copy(m_st);
     }
 };
@@ -273,7 +281,16 @@ private:
     bool             m_random_hammers = true;
     bool             m_lcube = true;
     unsigned         m_lcube_flips = 16;
+    bool             m_float_simplex = false;
+    unsigned         m_float_simplex_min_rows = 100;
+    unsigned         m_float_simplex_min_pivots = 100;
 public:
+    bool float_simplex() const { return m_float_simplex; }
+    bool & float_simplex() { return m_float_simplex; }
+    unsigned float_simplex_min_rows() const { return m_float_simplex_min_rows; }
+    unsigned & float_simplex_min_rows() { return m_float_simplex_min_rows; }
+    unsigned float_simplex_min_pivots() const { return m_float_simplex_min_pivots; }
+    unsigned & float_simplex_min_pivots() { return m_float_simplex_min_pivots; }
     bool lcube() const { return m_lcube; }
     unsigned lcube_flips() const { return m_lcube_flips; }
     unsigned dio_calls_period() const { return m_dio_calls_period; }
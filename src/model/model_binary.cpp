@@ -0,0 +1,92 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    model_binary.cpp
+
+Abstract:
+
+    Binary serialization of models using ast_binary.
+
+    A model is written as its universes for uninterpreted sorts,
+    the interpretations of constants, and the function interpretations
+    given by their entries and else-value.
+
+--*/
+
+#include "model/model_binary.h"
+#include "model/func_interp.h"
+
+void model2binary(model const& mdl, ast_binary_writer& out) {
+    unsigned num_sorts = mdl.get_num_uninterpreted_sorts();
+    out.write_unsigned(num_sorts);
+    for (unsigned i = 0; i < num_sorts; ++i) {
+        sort* s = mdl.get_uninterpreted_sort(i);
+        ptr_vector<expr> const& universe = mdl.get_universe(s);
+        out.write_ast(s);
+        out.write_exprs(universe.size(), universe.data());
+    }
+    out.write_unsigned(mdl.get_num_constants());
+    for (unsigned i = 0; i < mdl.get_num_constants(); ++i) {
+        func_decl* c = mdl.get_constant(i);
+        out.write_ast(c);
+        out.write_ast(mdl.get_const_interp(c));
+    }
+    out.write_unsigned(mdl.get_num_functions());
+    for (unsigned i = 0; i < mdl.get_num_functions(); ++i) {
+        func_decl* f = mdl.get_function(i);
+        func_interp* fi = mdl.get_func_interp(f);
+        out.write_ast(f);
+        out.write_unsigned(fi->num_entries());
+        for (unsigned j = 0; j < fi->num_entries(); ++j) {
+            func_entry const* e = fi->get_entry(j);
+            out.write_exprs(fi->get_arity(), e->get_args());
+            out.write_ast(e->get_result());
+        }
+        out.write_ast(fi->get_else());
+    }
+}
+
+model_ref binary2model(ast_manager& m, ast_binary_reader& in) {
+    model_ref mdl = alloc(model, m);
+    auto fail = []() { throw default_exception("invalid binary model"); };
+    uint64_t num_sorts = in.read_unsigned();
+    for (uint64_t i = 0; i < num_sorts; ++i) {
+        sort* s = in.read_sort();
+        if (!s)
+            fail();
+        expr_ref_vector universe(m);
+        in.read_exprs(universe);
+        mdl->register_usort(s, universe.size(), universe.data());
+    }
+    uint64_t num_consts = in.read_unsigned();
+    for (uint64_t i = 0; i < num_consts; ++i) {
+        func_decl* c = in.read_func_decl();
+        expr* v = in.read_expr();
+        if (!c || !v || c->get_arity() != 0 || c->get_range() != v->get_sort())
+            fail();
+        mdl->register_decl(c, v);
+    }
+    uint64_t num_funs = in.read_unsigned();
+    for (uint64_t i = 0; i < num_funs; ++i) {
+        func_decl* f = in.read_func_decl();
+        if (!f || f->get_arity() == 0)
+            fail();
+        func_interp* fi = alloc(func_interp, m, f->get_arity());
+        mdl->register_decl(f, fi);
+        uint64_t num_entries = in.read_unsigned();
+        expr_ref_vector args(m);
+        for (uint64_t j = 0; j < num_entries; ++j) {
+            args.reset();
+            in.read_exprs(args);
+            expr* r = in.read_expr();
+            if (!r || args.size() != f->get_arity())
+                fail();
+            fi->insert_new_entry(args.data(), r);
+        }
+        if (expr* e = in.read_expr())
+            fi->set_else(e);
+    }
+    return mdl;
+}
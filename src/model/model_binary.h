@@ -0,0 +1,20 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    model_binary.h
+
+Abstract:
+
+    Binary serialization of models using ast_binary.
+
+--*/
+#pragma once
+
+#include "ast/ast_binary.h"
+#include "model/model.h"
+
+void model2binary(model const& mdl, ast_binary_writer& out);
+
+model_ref binary2model(ast_manager& m, ast_binary_reader& in);
@@ -331,6 +331,7 @@ public:
 private:
     void set_background(cmd_context& ctx) {
         datalog::context& dlctx = m_dl_ctx->dlctx();
+        ctx.check_not_streamed("query");
         for (expr * e : ctx.assertions()) {
             dlctx.assert_expr(e);
         }
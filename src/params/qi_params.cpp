@@ -25,6 +25,7 @@ void qi_params::updt_params(params_ref const & _p) {
     m_mbqi_max_cexs = p.mbqi_max_cexs();
     m_mbqi_max_cexs_incr = p.mbqi_max_cexs_incr();
     m_mbqi_max_iterations = p.mbqi_max_iterations();
+    m_mbqi_threads = p.mbqi_threads();
     m_mbqi_trace = p.mbqi_trace();
     m_mbqi_force_template = p.mbqi_force_template();
     m_mbqi_id = p.mbqi_id();
@@ -37,6 +38,11 @@ void qi_params::updt_params(params_ref const & _p) {
     m_qi_cost = p.qi_cost();
     m_qi_max_eager_multipatterns = p.qi_max_multi_patterns();
     m_qi_quick_checker = static_cast<quick_checker_mode>(p.qi_quick_checker());
+    m_qi_adaptive = p.qi_adaptive();
+    m_qi_adaptive_penalty = p.qi_adaptive_penalty();
+    m_qi_cache = p.qi_cache();
+    m_qi_cache_replay = p.qi_cache_replay();
+    m_qi_cache_max_size = p.qi_cache_max_size();
 }
 
 #define DISPLAY_PARAM(X) out << #X"=" << X << '\n';
@@ -56,10 +62,16 @@ void qi_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_qi_max_instances);
     DISPLAY_PARAM(m_qi_lazy_instantiation);
     DISPLAY_PARAM(m_qi_conservative_final_check);
+    DISPLAY_PARAM(m_qi_adaptive);
+    DISPLAY_PARAM(m_qi_adaptive_penalty);
+    DISPLAY_PARAM(m_qi_cache);
+    DISPLAY_PARAM(m_qi_cache_replay);
+    DISPLAY_PARAM(m_qi_cache_max_size);
     DISPLAY_PARAM(m_mbqi);
     DISPLAY_PARAM(m_mbqi_max_cexs);
     DISPLAY_PARAM(m_mbqi_max_cexs_incr);
     DISPLAY_PARAM(m_mbqi_max_iterations);
+    DISPLAY_PARAM(m_mbqi_threads);
     DISPLAY_PARAM(m_mbqi_trace);
     DISPLAY_PARAM(m_mbqi_force_template);
     DISPLAY_PARAM(m_mbqi_id);
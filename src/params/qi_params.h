@@ -42,12 +42,18 @@ struct qi_params {
     unsigned           m_qi_max_instances = UINT_MAX;
     bool               m_qi_lazy_instantiation = false;
     bool               m_qi_conservative_final_check = false;
+    bool               m_qi_adaptive = false;
+    double             m_qi_adaptive_penalty = 5.0;
+    bool               m_qi_cache = false;
+    unsigned           m_qi_cache_replay = 1;
+    unsigned           m_qi_cache_max_size = 100000;
     bool               m_qe_lite = false;
 
     bool               m_mbqi = true;
     unsigned           m_mbqi_max_cexs = 1;
     unsigned           m_mbqi_max_cexs_incr = 1;
     unsigned           m_mbqi_max_iterations = 1000;
+    unsigned           m_mbqi_threads = 1;
     bool               m_mbqi_trace = false;
     unsigned           m_mbqi_force_template = 10;
     const char *       m_mbqi_id = nullptr;
@@ -54,6 +54,7 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_core_validate = p.core_validate();
     m_sls_enable = p.sls_enable();
     m_sls_parallel = p.sls_parallel();
+    m_sls_threads = p.sls_threads();
     m_logic = _p.get_sym("logic", m_logic);
     m_string_solver = p.string_solver();
     m_up_persist_clauses = p.up_persist_clauses();
@@ -71,6 +72,7 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_lemmas2console = sp.lemmas2console();
     m_instantiations2console = sp.instantiations2console();
     m_proof_log = sp.proof_log();
+    m_proof_log_binary = sp.proof_log_binary();
     
 }
 
@@ -133,6 +135,7 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_induction);
     DISPLAY_PARAM(m_clause_proof);
     DISPLAY_PARAM(m_proof_log);
+    DISPLAY_PARAM(m_proof_log_binary);
 
     DISPLAY_PARAM(m_case_split_strategy);
     DISPLAY_PARAM(m_rel_case_split_order);
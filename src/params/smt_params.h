@@ -115,8 +115,10 @@ struct smt_params : public preprocessor_params,
     bool             m_induction = false;
     bool             m_clause_proof = false;
     symbol           m_proof_log;
+    bool             m_proof_log_binary = false;
     bool             m_sls_enable = false;
     bool             m_sls_parallel = true;
+    unsigned         m_sls_threads = 1;
 
     // -----------------------------------
     //
@@ -32,7 +32,9 @@ Revision History:
 #include "parsers/smt2/smt2scanner.h"
 #include "parsers/util/pattern_validation.h"
 #include "parsers/util/parser_params.hpp"
+#include "util/mutex.h"
 #include<sstream>
+#include<thread>
 
 namespace smt2 {
     typedef cmd_exception parser_exception;
@@ -3208,6 +3210,24 @@ namespace smt2 {
             m_ignore_user_patterns = p.ignore_user_patterns();
             m_ignore_bad_patterns  = p.ignore_bad_patterns();
             m_display_error_for_vs = p.error_for_visual_studio();
+            if (p.streaming())
+                m_ctx.set_streaming(true);
+        }
+
+        /**
+           \brief Release the memory of the parsing stacks between commands,
+           so that a huge term does not keep its buffers alive for the rest of the input.
+        */
+        void release_buffers() {
+            if (size(m_psort_stack) == 0) m_psort_stack = nullptr;
+            if (size(m_sort_stack) == 0) m_sort_stack = nullptr;
+            if (size(m_expr_stack) == 0) m_expr_stack = nullptr;
+            if (size(m_pattern_stack) == 0) m_pattern_stack = nullptr;
+            if (size(m_nopattern_stack) == 0) m_nopattern_stack = nullptr;
+            if (size(m_sexpr_stack) == 0) m_sexpr_stack = nullptr;
+            if (m_symbol_stack.empty()) m_symbol_stack.finalize();
+            if (m_param_stack.empty()) m_param_stack.finalize();
+            if (m_stack.empty()) m_stack.reset();
         }
 
         void reset() {
@@ -3237,6 +3257,10 @@ namespace smt2 {
             m_scanner.reset_input(is, interactive);
         }
 
+        void set_line(unsigned line) {
+            m_scanner.set_line(line);
+        }
+
         sexpr_ref parse_sexpr_ref() {
             m_num_bindings    = 0;
             m_num_open_paren = 0;
@@ -3292,6 +3316,10 @@ namespace smt2 {
                         switch (curr()) {
                         case scanner::LEFT_PAREN:
                             parse_cmd();
+                            if (m_ctx.streaming())
+                                release_buffers();
+                            if (m().is_concurrent())
+                                m().concurrent_checkpoint();
                             break;
                         case scanner::EOF_TOKEN:
                             return found_errors == 0;
@@ -3338,9 +3366,330 @@ namespace smt2 {
     };
 
     void free_parser(parser * p) { dealloc(p); }
+
+#ifndef SINGLE_THREAD
+    /**
+       \brief Parse a non-interactive script using several threads.
+
+       The input is split at top-level commands. Long runs of plain
+       assertions (without :named) are divided into chunks that are parsed
+       by worker threads, each with its own cmd_context over the manager of
+       the main context, which is in concurrent mode while the workers run.
+       A worker imports the declarations of the main context before the threads
+       start and then parses its chunk in place, without copying the input.
+       The assertions of the workers are asserted in the main context
+       in input order. All other commands are parsed by a single parser on
+       the main context.
+
+       A chunk that fails to parse is parsed again by the main parser, so
+       errors are reported as in the sequential case. Once the script uses
+       scopes, resets, or declarations that cannot be imported into a separate
+       context (datatypes, recursive functions, parametric sorts, unknown commands),
+       the rest of the input is parsed sequentially.
+    */
+    class parallel_parser {
+        /**
+           \brief Read-only stream buffer over a range of the input.
+        */
+        struct text_buffer : public std::streambuf {
+            text_buffer(char const * begin, char const * end) {
+                char * b = const_cast<char *>(begin);
+                setg(b, b, const_cast<char *>(end));
+            }
+        };
+
+        struct command {
+            unsigned         m_begin;
+            unsigned         m_end;
+            unsigned         m_line;
+            std::string_view m_head;
+            bool             m_plain_assert;
+        };
+
+        struct worker {
+            cmd_context        m_ctx;
+            std::ostringstream m_out;
+            params_ref         m_params;
+            char const *       m_begin = nullptr;
+            char const *       m_end = nullptr;
+            unsigned           m_num_asserts = 0;
+            bool               m_ok = false;
+            worker(ast_manager & m): m_ctx(false, &m) {}
+        };
+
+        // minimal number of assertions given to a worker thread
+        static const unsigned min_chunk_size = 512;
+
+        cmd_context &         m_ctx;
+        params_ref const &    m_params;
+        char const *          m_filename;
+        unsigned              m_threads;
+        std::string           m_text;
+        std::vector<command>  m_cmds;
+        bool                  m_parallel = true;
+        parser *              m_parser = nullptr;
+
+        void skip_comment(unsigned & i, unsigned & line) {
+            char const * s = m_text.data();
+            unsigned n = m_text.size();
+            if (s[i] == ';') {
+                while (i < n && s[i] != '\n')
+                    ++i;
+            }
+            else {
+                SASSERT(s[i] == '#' && s[i + 1] == '|');
+                for (i += 2; i + 1 < n && !(s[i] == '|' && s[i + 1] == '#'); ++i)
+                    if (s[i] == '\n')
+                        ++line;
+                i = std::min(i + 2, n);
+            }
+        }
+
+        bool is_comment_start(unsigned i) const {
+            return m_text[i] == ';' || (m_text[i] == '#' && i + 1 < m_text.size() && m_text[i + 1] == '|');
+        }
+
+        /**
+           \brief Split the input into top-level commands. The commands partition the input,
+           so a command includes the white space and comments that precede it.
+        */
+        void split() {
+            char const * s = m_text.data();
+            unsigned n = m_text.size();
+            unsigned i = 0, line = 1;
+            while (i < n) {
+                command c { i, n, line, std::string_view(), false };
+                while (i < n) {
+                    if (s[i] == '\n')
+                        ++line, ++i;
+                    else if (isspace(static_cast<unsigned char>(s[i])))
+                        ++i;
+                    else if (is_comment_start(i))
+                        skip_comment(i, line);
+                    else
+                        break;
+                }
+                if (i == n) {
+                    if (m_cmds.empty())
+                        m_cmds.push_back(c);
+                    else
+                        m_cmds.back().m_end = n;
+                    return;
+                }
+                if (s[i] != '(') {
+                    // malformed input is left to the main parser
+                    m_cmds.push_back(c);
+                    return;
+                }
+                unsigned head = i + 1;
+                while (head < n && isspace(static_cast<unsigned char>(s[head])))
+                    ++head;
+                unsigned head_end = head;
+                while (head_end < n && !isspace(static_cast<unsigned char>(s[head_end])) && s[head_end] != '(' && s[head_end] != ')')
+                    ++head_end;
+                c.m_head = std::string_view(s + head, head_end - head);
+                unsigned depth = 0;
+                for (; i < n; ++i) {
+                    char ch = s[i];
+                    if (ch == '\n')
+                        ++line;
+                    else if (ch == '(')
+                        ++depth;
+                    else if (ch == ')') {
+                        if (--depth == 0) {
+                            ++i;
+                            break;
+                        }
+                    }
+                    else if (ch == '"') {
+                        for (++i; i < n; ++i) {
+                            if (s[i] == '\n')
+                                ++line;
+                            else if (s[i] == '"') {
+                                if (i + 1 < n && s[i + 1] == '"')
+                                    ++i;
+                                else
+                                    break;
+                            }
+                        }
+                    }
+                    else if (ch == '|') {
+                        for (++i; i < n && s[i] != '|'; ++i) {
+                            if (s[i] == '\\' && i + 1 < n)
+                                ++i;
+                            if (s[i] == '\n')
+                                ++line;
+                        }
+                    }
+                    else if (is_comment_start(i)) {
+                        skip_comment(i, line);
+                        --i;
+                    }
+                }
+                c.m_end = i;
+                c.m_plain_assert = c.m_head == "assert" &&
+                    std::string_view(s + c.m_begin, c.m_end - c.m_begin).find(":named") == std::string_view::npos;
+                m_cmds.push_back(c);
+            }
+        }
+
+        /**
+           \brief Stop parsing in parallel after a command whose effect on the main
+           context cannot be imported by workers.
+        */
+        void update_decls(command const & c) {
+            static char const * supported[] = { "declare-sort", "define-sort", "declare-fun", "declare-const", "define-fun", "define-const",
+                                                "set-logic", "assert", "check-sat", "check-sat-assuming", "set-info", "set-option", "get-info", "get-option",
+                                                "get-model", "get-value", "get-assignment", "get-assertions", "get-unsat-core",
+                                                "get-unsat-assumptions", "get-proof", "echo", "eval", "simplify", "exit" };
+            for (char const * h : supported)
+                if (c.m_head == h)
+                    return;
+            m_parallel = false;
+        }
+
+        bool parse_sequential(unsigned begin, unsigned end, unsigned line) {
+            if (begin == end)
+                return true;
+            text_buffer buf(m_text.data() + begin, m_text.data() + end);
+            std::istream is(&buf);
+            if (m_parser)
+                m_parser->reset_input(is, false);
+            else
+                m_parser = alloc(parser, m_ctx, is, false, m_params, m_filename);
+            m_parser->set_line(line);
+            return (*m_parser)();
+        }
+
+        bool parse_sequential(unsigned lo, unsigned hi) {
+            if (lo == hi)
+                return true;
+            return parse_sequential(m_cmds[lo].m_begin, m_cmds[hi - 1].m_end, m_cmds[lo].m_line);
+        }
+
+        /**
+           \brief Import the declarations of the main context into a worker. This happens
+           on the main thread before the manager enters concurrent mode.
+        */
+        bool init(worker & w) {
+            try {
+                if (m_ctx.has_logic())
+                    w.m_ctx.set_logic(m_ctx.get_logic());
+                w.m_ctx.set_regular_stream(w.m_out);
+                w.m_ctx.set_diagnostic_stream(w.m_out);
+                w.m_ctx.m();
+                return w.m_ctx.import_decls(m_ctx);
+            }
+            catch (...) {
+                return false;
+            }
+        }
+
+        static void run(worker & w) {
+            try {
+                scoped_concurrent_thread thread(w.m_ctx.m());
+                text_buffer buf(w.m_begin, w.m_end);
+                std::istream is(&buf);
+                w.m_ok = parse_smt2_commands(w.m_ctx, is, false, w.m_params) &&
+                         w.m_ctx.assertions().size() == w.m_num_asserts;
+            }
+            catch (...) {
+                w.m_ok = false;
+            }
+        }
+
+        /**
+           \brief Parse the plain assertions m_cmds[lo:hi] on worker threads.
+        */
+        bool parse_parallel(unsigned lo, unsigned hi) {
+            unsigned num_workers = std::min(m_threads, (hi - lo) / min_chunk_size);
+            scoped_ptr_vector<worker> workers;
+            unsigned start = lo;
+            for (unsigned i = 0; i < num_workers; ++i) {
+                unsigned stop = lo + (unsigned)((uint64_t)(hi - lo) * (i + 1) / num_workers);
+                worker * w = alloc(worker, m_ctx.m());
+                workers.push_back(w);
+                w->m_params.copy(m_params);
+                w->m_params.set_uint("threads", 1);
+                if (!init(*w))
+                    return parse_sequential(lo, hi);
+                w->m_num_asserts = stop - start;
+                w->m_begin = m_text.data() + m_cmds[start].m_begin;
+                w->m_end = m_text.data() + m_cmds[stop - 1].m_end;
+                start = stop;
+            }
+            IF_VERBOSE(2, verbose_stream() << "(smt2.parser :parallel-assertions " << (hi - lo) << " :threads " << num_workers << ")\n";);
+            ast_manager & m = m_ctx.m();
+            m.set_concurrent(true);
+            std::vector<std::thread> threads;
+            for (worker * w : workers)
+                threads.push_back(std::thread([w]() { run(*w); }));
+            for (auto & th : threads)
+                th.join();
+            m.set_concurrent(false);
+            for (worker * w : workers)
+                if (!w->m_ok)
+                    return parse_sequential(lo, hi);
+            for (worker * w : workers)
+                for (expr * e : w->m_ctx.assertions())
+                    m_ctx.assert_expr(e);
+            return true;
+        }
+
+        bool can_run_parallel() const {
+            return m_parallel && !m_ctx.interactive_mode() && !m_ctx.print_success_enabled();
+        }
+
+    public:
+        parallel_parser(cmd_context & ctx, params_ref const & ps, char const * filename, unsigned threads):
+            m_ctx(ctx), m_params(ps), m_filename(filename),
+            m_threads(threads) {}
+
+        ~parallel_parser() {
+            dealloc(m_parser);
+        }
+
+        bool operator()(std::istream & is) {
+            m_text.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+            split();
+            bool ok = true;
+            unsigned seq = 0, i = 0, n = m_cmds.size();
+            while (i < n) {
+                command const & c = m_cmds[i];
+                if (c.m_plain_assert && m_parallel) {
+                    unsigned j = i;
+                    while (j < n && m_cmds[j].m_plain_assert)
+                        ++j;
+                    if (j - i >= 2 * min_chunk_size && m_threads > 1) {
+                        ok = parse_sequential(seq, i) && ok;
+                        if (can_run_parallel())
+                            ok = parse_parallel(i, j) && ok;
+                        else
+                            ok = parse_sequential(i, j) && ok;
+                        seq = j;
+                    }
+                    i = j;
+                    continue;
+                }
+                update_decls(c);
+                ++i;
+                if (c.m_head == "exit")
+                    return parse_sequential(seq, i) && ok;
+            }
+            return parse_sequential(seq, n) && ok;
+        }
+    };
+#endif
 }
 
 bool parse_smt2_commands(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & ps, char const * filename) {
+#ifndef SINGLE_THREAD
+    unsigned threads = parser_params(ps).threads();
+    if (!interactive && threads > 1 && !ctx.interactive_mode()) {
+        smt2::parallel_parser p(ctx, ps, filename, threads);
+        return p(is);
+    }
+#endif
     smt2::parser p(ctx, is, interactive, ps, filename);
     return p();
 }
@@ -78,6 +78,7 @@ namespace smt2 {
         scanner(cmd_context & ctx, std::istream& stream, bool interactive = false);  
         
         int get_line() const { return m_line; }
+        void set_line(int line) { m_line = line; }
         int get_pos() const { return m_pos; }
         symbol const & get_id() const { return m_id; }
         rational get_number() const { return m_number; }
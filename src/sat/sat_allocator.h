@@ -7,7 +7,8 @@ Module Name:
 
 Abstract:
 
-    Small object allocator suitable for clauses
+    Small object allocator suitable for clauses,
+    and an arena that references objects by 32-bit offsets.
 
 Author:
 
@@ -20,6 +21,8 @@ Revision History:
 
 #include "util/vector.h"
 #include "util/machine.h"
+#include "util/z3_exception.h"
+#include <algorithm>
 
 class sat_allocator {
     static const unsigned CHUNK_SIZE     = (1 << 16) - sizeof(char*);
@@ -93,6 +96,242 @@ public:
     char const* id() const { return m_id; }
 };
 
+/**
+   \brief Arena of 8-byte aligned slots that are referenced by 32-bit offsets.
+
+   Objects are carved out of large pages by bumping a pointer. An offset stores
+   the page index in the upper bits and the slot within the page in the lower bits.
+   The offset of an object is recovered from its address through a sorted index
+   of the pages, so objects do not store their own offset.
+   Freed objects are recycled through per-size free lists. Larger freed blocks are
+   kept in power-of-two size classes; a block reused for a smaller object is split
+   and the remainder is freed again. When a page is full and enough slots have been
+   freed, adjacent free blocks are merged, and free blocks at the end of the current
+   page are returned to the bump pointer. Objects that do not fit in a page get a
+   dedicated page.
+*/
+class sat_arena {
+    static const unsigned SLOT_BITS   = 3;
+    static const unsigned PAGE_BITS   = 17;
+    static const unsigned PAGE_SIZE   = (1u << PAGE_BITS) << SLOT_BITS;
+    static const unsigned MAX_PAGES   = 1u << (32 - PAGE_BITS);
+    static const unsigned PAGE_SLOTS  = 1u << PAGE_BITS;
+    static const unsigned NUM_FREE    = 128;   // free lists are kept for objects of up to NUM_FREE slots
+    char const *              m_id;
+    size_t                    m_alloc_size = 0;
+    ptr_vector<char>          m_pages;
+    svector<std::pair<char const*, unsigned>> m_page_index; // page address, page index, sorted by address
+    unsigned                  m_freed = 0;                 // slots freed since the last merge
+    unsigned_vector           m_free_pages;    // indices of released dedicated pages
+    unsigned                  m_curr_page = UINT_MAX;
+    unsigned                  m_curr_slot = 0;
+    vector<unsigned_vector>   m_free;
+    vector<svector<std::pair<unsigned, unsigned>>> m_large_free; // offset, number of slots, by log2 of the number of slots
+
+    static unsigned num_slots(size_t size) {
+        return static_cast<unsigned>((size + (1u << SLOT_BITS) - 1) >> SLOT_BITS);
+    }
+
+    static bool page_lt(std::pair<char const*, unsigned> const& a, std::pair<char const*, unsigned> const& b) {
+        return a.first < b.first;
+    }
+
+    void index_page(char const * page, unsigned idx) {
+        std::pair<char const*, unsigned> e(page, idx);
+        auto it = std::upper_bound(m_page_index.begin(), m_page_index.end(), e, page_lt);
+        unsigned pos = static_cast<unsigned>(it - m_page_index.begin());
+        m_page_index.push_back(e);
+        for (unsigned i = m_page_index.size() - 1; i > pos; --i)
+            m_page_index[i] = m_page_index[i - 1];
+        m_page_index[pos] = e;
+    }
+
+    void unindex_page(char const * page) {
+        std::pair<char const*, unsigned> e(page, 0);
+        auto it = std::lower_bound(m_page_index.begin(), m_page_index.end(), e, page_lt);
+        SASSERT(it != m_page_index.end() && it->first == page);
+        for (unsigned i = static_cast<unsigned>(it - m_page_index.begin()); i + 1 < m_page_index.size(); ++i)
+            m_page_index[i] = m_page_index[i + 1];
+        m_page_index.pop_back();
+    }
+
+    unsigned mk_page(size_t size) {
+        char * page = static_cast<char*>(memory::allocate(size));
+        unsigned idx;
+        if (!m_free_pages.empty()) {
+            idx = m_free_pages.back();
+            m_free_pages.pop_back();
+            m_pages[idx] = page;
+        }
+        else if (m_pages.size() >= MAX_PAGES) {
+            memory::deallocate(page);
+            throw default_exception("clause arena exhausted");
+        }
+        else {
+            idx = m_pages.size();
+            m_pages.push_back(page);
+        }
+        index_page(page, idx);
+        return idx;
+    }
+
+    void free_slots(unsigned off, unsigned n) {
+        if (n < NUM_FREE) {
+            m_free.reserve(n + 1);
+            m_free[n].push_back(off);
+        }
+        else {
+            unsigned c = log2(n);
+            m_large_free.reserve(c + 1);
+            m_large_free[c].push_back({off, n});
+        }
+    }
+
+    unsigned alloc_curr(unsigned n) {
+        unsigned off = (m_curr_page << PAGE_BITS) | m_curr_slot;
+        m_curr_slot += n;
+        return off;
+    }
+
+    // take a free block of at least NUM_FREE and at least n slots, and free its remainder.
+    // Blocks in classes above log2(n) always fit; in the class of n only the last one is tried.
+    bool reuse_large(unsigned n, unsigned & off) {
+        unsigned c = log2(n);
+        for (unsigned i = c; i < m_large_free.size(); ++i) {
+            auto & blocks = m_large_free[i];
+            if (blocks.empty() || blocks.back().second < n)
+                continue;
+            off = blocks.back().first;
+            unsigned sz = blocks.back().second;
+            blocks.pop_back();
+            if (sz > n)
+                free_slots(off + n, sz - n);
+            return true;
+        }
+        return false;
+    }
+
+    // take any free block of at least n slots and free its remainder.
+    bool reuse(unsigned n, unsigned & off) {
+        for (unsigned k = n + 1; k < m_free.size(); ++k) {
+            if (m_free[k].empty())
+                continue;
+            off = m_free[k].back();
+            m_free[k].pop_back();
+            free_slots(off + n, k - n);
+            return true;
+        }
+        return reuse_large(n, off);
+    }
+
+    // merge adjacent free blocks of the same page
+    void coalesce() {
+        svector<std::pair<unsigned, unsigned>> blocks;
+        for (unsigned n = 0; n < m_free.size(); ++n)
+            for (unsigned off : m_free[n])
+                blocks.push_back({off, n});
+        for (auto const & bs : m_large_free)
+            blocks.append(bs);
+        m_free.reset();
+        m_large_free.reset();
+        m_freed = 0;
+        std::sort(blocks.begin(), blocks.end());
+        auto release = [&](unsigned off, unsigned n) {
+            if ((off >> PAGE_BITS) == m_curr_page && (off & (PAGE_SLOTS - 1)) + n == m_curr_slot)
+                m_curr_slot -= n;
+            else
+                free_slots(off, n);
+        };
+        unsigned i = 0;
+        while (i < blocks.size()) {
+            auto [off, n] = blocks[i++];
+            for (; i < blocks.size() && blocks[i].first == off + n && (blocks[i].first >> PAGE_BITS) == (off >> PAGE_BITS); ++i)
+                n += blocks[i].second;
+            release(off, n);
+        }
+    }
+
+public:
+    sat_arena(char const * id = "unknown"): m_id(id) {}
+    ~sat_arena() { reset(); }
+
+    void reset() {
+        for (char * p : m_pages)
+            if (p)
+                memory::deallocate(p);
+        m_pages.reset();
+        m_page_index.reset();
+        m_free_pages.reset();
+        m_free.reset();
+        m_large_free.reset();
+        m_freed = 0;
+        m_curr_page = UINT_MAX;
+        m_curr_slot = 0;
+        m_alloc_size = 0;
+    }
+
+    unsigned allocate(size_t size) {
+        m_alloc_size += size;
+        unsigned n = num_slots(size);
+        if (n < m_free.size() && !m_free[n].empty()) {
+            unsigned off = m_free[n].back();
+            m_free[n].pop_back();
+            return off;
+        }
+        if (n > PAGE_SLOTS) 
+            return mk_page(size) << PAGE_BITS;
+        unsigned off;
+        if (n >= NUM_FREE && reuse_large(n, off))
+            return off;
+        if (m_curr_page == UINT_MAX || m_curr_slot + n > PAGE_SLOTS) {
+            if (m_freed >= PAGE_SLOTS / 4) {
+                coalesce();
+                if (m_curr_page != UINT_MAX && m_curr_slot + n <= PAGE_SLOTS)
+                    return alloc_curr(n);
+            }
+            if (reuse(n, off))
+                return off;
+            m_curr_page = mk_page(PAGE_SIZE);
+            m_curr_slot = 0;
+        }
+        return alloc_curr(n);
+    }
+
+    // size must be the size passed to allocate.
+    void deallocate(size_t size, unsigned off) {
+        m_alloc_size -= size;
+        unsigned n = num_slots(size);
+        if (n > PAGE_SLOTS) {
+            unsigned idx = off >> PAGE_BITS;
+            unindex_page(m_pages[idx]);
+            memory::deallocate(m_pages[idx]);
+            m_pages[idx] = nullptr;
+            m_free_pages.push_back(idx);
+        }
+        else {
+            free_slots(off, n);
+            m_freed += n;
+        }
+    }
+
+    char * get(unsigned off) const {
+        return m_pages[off >> PAGE_BITS] + (static_cast<size_t>(off & (PAGE_SLOTS - 1)) << SLOT_BITS);
+    }
+
+    // p must point to the start of an object of the arena.
+    unsigned get_offset(char const * p) const {
+        std::pair<char const*, unsigned> e(p, 0);
+        auto it = std::upper_bound(m_page_index.begin(), m_page_index.end(), e, page_lt);
+        SASSERT(it != m_page_index.begin());
+        --it;
+        return (it->second << PAGE_BITS) | static_cast<unsigned>((p - it->first) >> SLOT_BITS);
+    }
+
+    size_t get_allocation_size() const { return m_alloc_size; }
+
+    char const* id() const { return m_id; }
+};
+
 inline void * operator new(size_t s, sat_allocator & r) { return r.allocate(s); }
 inline void * operator new[](size_t s, sat_allocator & r) { return r.allocate(s); }
 inline void operator delete(void * p, sat_allocator & r) { UNREACHABLE(); }
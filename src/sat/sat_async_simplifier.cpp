@@ -0,0 +1,256 @@
+/*++
+  Copyright (c) 2026 Microsoft Corporation
+
+  Module Name:
+
+   sat_async_simplifier.cpp
+
+  Abstract:
+   
+    Inprocessing on a helper thread.
+
+  --*/
+
+#include "sat/sat_async_simplifier.h"
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    async_simplifier::async_simplifier(solver& s): s(s) {}
+
+    async_simplifier::~async_simplifier() {
+        cancel();
+    }
+
+    void async_simplifier::start() {
+        SASSERT(!m_running);
+        SASSERT(s.at_base_lvl());
+        params_ref p(s.params());
+        // only equivalence preserving steps, and no nested helper.
+        p.set_bool("inprocess.async", false);
+        p.set_bool("elim_vars", false);
+        p.set_bool("bce", false);
+        p.set_bool("abce", false);
+        p.set_bool("cce", false);
+        p.set_bool("acce", false);
+        p.set_bool("bca", false);
+        p.set_bool("anf", false);
+        p.set_bool("lookahead_simplify", false);
+        p.set_sym("inprocess.out", symbol::null);
+        p.set_bool("drat.disable", true);
+        p.set_uint("threads", 1);
+        m_limit.reset_cancel();
+        m_copy = alloc(solver, p, m_limit);
+        m_copy->copy(s);
+        m_copy->m_next_simplify = 0;
+        m_sizes.reset();
+        for (clause* c : m_copy->m_clauses)
+            m_sizes.insert(c->id(), c->size());
+        m_failed = false;
+        m_running = true;
+        ++m_stats.m_num_rounds;
+        IF_VERBOSE(2, verbose_stream() << "(sat.async-simplify :start " << m_stats.m_num_rounds << ")\n";);
+#ifdef SINGLE_THREAD
+        run();
+#else
+        m_done = false;
+        m_thread = std::thread([&]() { run(); m_done = true; });
+#endif
+    }
+
+    void async_simplifier::run() {
+        try {
+            if (!m_copy->inconsistent())
+                m_copy->do_simplify();
+        }
+        catch (z3_exception&) {
+            m_failed = true;
+        }
+    }
+
+    void async_simplifier::join() {
+#ifndef SINGLE_THREAD
+        if (m_thread.joinable())
+            m_thread.join();
+#endif
+        m_running = false;
+    }
+
+    bool async_simplifier::try_import() {
+        if (!m_running)
+            return true;
+#ifndef SINGLE_THREAD
+        if (!m_done)
+            return false;
+#endif
+        join();
+        if (!m_failed && !m_limit.is_canceled())
+            import();
+        m_copy = nullptr;
+        return true;
+    }
+
+    void async_simplifier::cancel() {
+        if (!m_running)
+            return;
+        m_limit.cancel();
+        join();
+        m_copy = nullptr;
+        ++m_stats.m_num_discarded;
+    }
+
+    /**
+       The snapshot may be older than the current clause database of s:
+       literals over variables that s eliminated since then are skipped.
+    */
+    bool async_simplifier::is_stale(literal l) const {
+        return l.var() >= s.num_vars() || s.was_eliminated(l.var());
+    }
+
+    /**
+       Add a clause implied by the snapshot to s as a redundant clause.
+       Returns false if it is stale or already satisfied.
+    */
+    bool async_simplifier::add_clause(literal_vector& lits) {
+        unsigned j = 0;
+        for (literal l : lits) {
+            if (is_stale(l))
+                return false;
+            switch (s.value(l)) {
+            case l_true:
+                return false;
+            case l_false:
+                break;
+            case l_undef:
+                lits[j++] = l;
+                break;
+            }
+        }
+        lits.shrink(j);
+        switch (lits.size()) {
+        case 0:
+            s.set_conflict();
+            return true;
+        case 1:
+            s.assign_unit(lits[0]);
+            return true;
+        case 2:
+            if (find_binary_watch(s.get_wlist(~lits[0]), lits[1]))
+                return false;
+            s.mk_bin_clause(lits[0], lits[1], status::redundant());
+            return true;
+        default:
+            s.mk_clause(lits, status::redundant());
+            return true;
+        }
+    }
+
+    void async_simplifier::import() {
+        SASSERT(s.at_base_lvl());
+        if (m_copy->inconsistent()) {
+            s.set_conflict();
+            return;
+        }
+        import_units();
+        import_binaries();
+        import_equivalences();
+        import_clauses();
+        if (!s.inconsistent())
+            s.propagate(false);
+        IF_VERBOSE(2, verbose_stream() << "(sat.async-simplify :units " << m_stats.m_num_units 
+                   << " :binaries " << m_stats.m_num_binaries << " :equivs " << m_stats.m_num_equivs
+                   << " :clauses " << m_stats.m_num_clauses << ")\n";);
+    }
+
+    void async_simplifier::import_units() {
+        solver& c = *m_copy;
+        unsigned trail_sz = c.init_trail_size();
+        for (unsigned i = 0; i < trail_sz && !s.inconsistent(); ++i) {
+            literal lit = c.trail_literal(i);
+            if (is_stale(lit))
+                continue;
+            switch (s.value(lit)) {
+            case l_true:
+                break;
+            case l_false:
+                s.set_conflict();
+                break;
+            case l_undef:
+                s.assign_unit(lit);
+                ++m_stats.m_num_units;
+                break;
+            }
+        }
+    }
+
+    void async_simplifier::import_binaries() {
+        solver& c = *m_copy;
+        for (unsigned l_idx = 0; l_idx < c.m_watches.size() && !s.inconsistent(); ++l_idx) {
+            literal l1 = ~to_literal(l_idx);
+            if (is_stale(l1) || s.value(l1) != l_undef)
+                continue;
+            for (watched const& w : c.m_watches[l_idx]) {
+                if (!w.is_binary_clause())
+                    continue;
+                literal l2 = w.get_literal();
+                if (l1.index() > l2.index() || is_stale(l2) || s.value(l2) != l_undef)
+                    continue;
+                if (find_binary_watch(s.get_wlist(~l1), l2))
+                    continue;
+                s.mk_bin_clause(l1, l2, status::redundant());
+                ++m_stats.m_num_binaries;
+            }
+        }
+    }
+
+    /**
+       The copy starts with an empty model converter and does not eliminate
+       variables, so its model converter only records the equivalences
+       that scc substituted. They are added to s as binary clauses, the next
+       scc pass of s substitutes them and records them in the model converter of s.
+    */
+    void async_simplifier::import_equivalences() {
+        literal_vector stack, lits;
+        m_copy->m_mc.expand(stack);
+        for (literal l : stack) {
+            if (s.inconsistent())
+                break;
+            if (l != null_literal) {
+                lits.push_back(l);
+                continue;
+            }
+            if (add_clause(lits))
+                ++m_stats.m_num_equivs;
+            lits.reset();
+        }
+    }
+
+    /**
+       Clauses that subsumption resolution or asymmetric branching shortened
+       in the copy, and clauses the copy created, replace the clauses of s
+       they subsume when learned clauses are subsumed in s.
+    */
+    void async_simplifier::import_clauses() {
+        literal_vector lits;
+        for (clause* c : m_copy->m_clauses) {
+            if (s.inconsistent())
+                break;
+            unsigned sz;
+            if (c->was_removed() || (m_sizes.find(c->id(), sz) && c->size() >= sz))
+                continue;
+            lits.reset();
+            lits.append(c->size(), c->begin());
+            if (add_clause(lits))
+                ++m_stats.m_num_clauses;
+        }
+    }
+
+    void async_simplifier::collect_statistics(statistics& st) const {
+        st.update("sat async simplify rounds", m_stats.m_num_rounds);
+        st.update("sat async simplify discarded", m_stats.m_num_discarded);
+        st.update("sat async simplify units", m_stats.m_num_units);
+        st.update("sat async simplify binaries", m_stats.m_num_binaries);
+        st.update("sat async simplify equivalences", m_stats.m_num_equivs);
+        st.update("sat async simplify clauses", m_stats.m_num_clauses);
+    }
+}
@@ -0,0 +1,92 @@
+/*++
+  Copyright (c) 2026 Microsoft Corporation
+
+  Module Name:
+
+   sat_async_simplifier.h
+
+  Abstract:
+   
+    Inprocessing on a helper thread.
+
+    A snapshot of the clause database is copied into an auxiliary solver
+    that runs the equivalence preserving part of the inprocessing pipeline
+    (scc, subsumption, probing, asymmetric branching) while the main solver
+    keeps searching. Everything the copy derives is implied by the snapshot.
+    At the next simplification round of the main solver the derived units,
+    binary clauses, equivalences and strengthened clauses are imported as
+    redundant clauses; the main solver then substitutes the equivalences
+    with its own scc pass and records them in its own model converter.
+    Variable elimination and blocked clause elimination change the set of
+    models, they keep running inline in the main solver.
+
+  --*/
+#pragma once
+
+#include "util/util.h"
+#include "util/map.h"
+#include "util/rlimit.h"
+#include "util/statistics.h"
+#include "sat/sat_types.h"
+#ifndef SINGLE_THREAD
+#include <atomic>
+#include <thread>
+#endif
+
+namespace sat {
+
+    class solver;
+
+    class async_simplifier {
+        struct stats {
+            unsigned m_num_rounds = 0;
+            unsigned m_num_discarded = 0;
+            unsigned m_num_units = 0;
+            unsigned m_num_binaries = 0;
+            unsigned m_num_equivs = 0;
+            unsigned m_num_clauses = 0;
+        };
+
+        solver&            s;
+        reslimit           m_limit;
+        scoped_ptr<solver> m_copy;
+        u_map<unsigned>    m_sizes;       // sizes of the clauses of the copy when it was made
+        bool               m_running = false;
+        bool               m_failed = false;
+        stats              m_stats;
+#ifndef SINGLE_THREAD
+        std::thread        m_thread;
+        std::atomic<bool>  m_done = false;
+#endif
+
+        void run();
+        void import();
+        void import_units();
+        void import_binaries();
+        void import_equivalences();
+        void import_clauses();
+        bool is_stale(literal l) const;
+        bool add_clause(literal_vector& lits);
+        void join();
+
+    public:
+        async_simplifier(solver& s);
+        ~async_simplifier();
+
+        bool is_running() const { return m_running; }
+
+        // snapshot the clauses of the main solver and start simplifying them.
+        void start();
+
+        // import the result if the helper finished.
+        // Returns true if no helper is running after the call.
+        bool try_import();
+
+        // stop the helper and discard its results.
+        // Called when the clause database changes in ways that can invalidate the snapshot.
+        void cancel();
+
+        void collect_statistics(statistics& st) const;
+    };
+
+}
@@ -47,9 +47,9 @@ namespace sat {
                     w.is_ext_constraint() && 
                     s.m_ext && 
                     learned && // cannot (yet) observe if ext constraints are learned
-                    !seen_idx.contains(w.get_ext_constraint_idx()) &&
-                    s.m_ext->is_extended_binary(w.get_ext_constraint_idx(), r)) {
-                    seen_idx.insert(w.get_ext_constraint_idx(), true);
+                    !seen_idx.contains(s.get_ext_constraint_idx(w)) &&
+                    s.m_ext->is_extended_binary(s.get_ext_constraint_idx(w), r)) {
+                    seen_idx.insert(s.get_ext_constraint_idx(w), true);
                     for (unsigned i = 0; i < std::min(4u, r.size()); ++i) {
                         shuffle<literal>(r.size(), r.data(), m_rand);
                         literal u = r[0];
@@ -178,6 +178,7 @@ namespace sat {
     }
 
     unsigned big::reduce_tr(solver& s) {
+        s.invalidate_bin_watches();
         unsigned idx = 0;
         unsigned elim = 0;
         m_del_bin.reset();
@@ -133,17 +133,18 @@ namespace sat {
     };
 
     /**
-       \brief Simple clause allocator that allows uint (32bit integers) to be used to reference clauses (even in 64bit machines).
+       \brief Clause allocator that allows uint (32bit integers) to be used to reference clauses (even in 64bit machines).
+       Clauses, with their literals inline, are carved out of a sat_arena and referenced by offsets into the arena.
     */
     class clause_allocator {
-        sat_allocator    m_allocator;
+        sat_arena        m_arena;
         id_gen           m_id_gen;
     public:
         clause_allocator();
         void          finalize();
-        size_t        get_allocation_size() const { return m_allocator.get_allocation_size(); }
-        clause *      get_clause(clause_offset cls_off) const;
-        clause_offset get_offset(clause const * ptr) const;
+        size_t        get_allocation_size() const { return m_arena.get_allocation_size(); }
+        clause *      get_clause(clause_offset cls_off) const { return reinterpret_cast<clause*>(m_arena.get(cls_off)); }
+        clause_offset get_offset(clause const * ptr) const { return m_arena.get_offset(reinterpret_cast<char const*>(ptr)); }
         clause *      mk_clause(unsigned num_lits, literal const * lits, bool learned);
         clause *      copy_clause(clause const& other);
         void          del_clause(clause * cls);
@@ -36,6 +36,7 @@ namespace sat {
        - Delete watched clauses (they will be reinserted after they are cleaned).
     */
     void cleaner::cleanup_watches() {
+        s.invalidate_bin_watches();
         vector<watch_list>::iterator it  = s.m_watches.begin();
         vector<watch_list>::iterator end = s.m_watches.end();
         unsigned l_idx = 0;
@@ -84,6 +84,7 @@ namespace sat {
         m_propagate_prefetch = p.propagate_prefetch();
         m_inprocess_max   = p.inprocess_max();
         m_inprocess_out   = p.inprocess_out();
+        m_inprocess_async = p.inprocess_async();
 
         m_random_freq     = p.random_freq();
         m_random_seed     = p.random_seed();
@@ -109,6 +110,8 @@ namespace sat {
         m_anf_simplify      = p.anf();
         m_anf_delay         = p.anf_delay();
         m_anf_exlin         = p.anf_exlin();
+        m_sim_sweep         = p.sim_sweep();
+        m_sim_sweep_probes  = p.sim_sweep_probes();
         m_lookahead_simplify = p.lookahead_simplify();
         m_lookahead_double = p.lookahead_double();
         m_lookahead_simplify_bca = p.lookahead_simplify_bca();
@@ -106,6 +106,7 @@ namespace sat {
         double             m_slow_glue_avg;
         unsigned           m_inprocess_max;
         symbol             m_inprocess_out;
+        bool               m_inprocess_async;
         double             m_random_freq;
         unsigned           m_random_seed;
         unsigned           m_burst_search;
@@ -122,6 +123,8 @@ namespace sat {
         bool               m_anf_simplify;
         unsigned           m_anf_delay;
         bool               m_anf_exlin;
+        bool               m_sim_sweep;
+        unsigned           m_sim_sweep_probes;
         bool               m_lookahead_simplify;
         bool               m_lookahead_simplify_bca;
         cutoff_t           m_lookahead_cube_cutoff;
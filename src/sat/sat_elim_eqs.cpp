@@ -40,6 +40,7 @@ namespace sat {
     }
 
     void elim_eqs::cleanup_bin_watches(literal_vector const & roots) {        
+        m_solver.invalidate_bin_watches();
         unsigned l_idx = 0;
         m_new_bin.reset();
         for (watch_list & wlist : m_solver.m_watches) {
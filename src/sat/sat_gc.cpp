@@ -594,4 +594,85 @@ namespace sat {
 
 #endif
 
+    struct solver::cmp_activity {
+        solver& s;
+        cmp_activity(solver& s):s(s) {}
+        bool operator()(bool_var v1, bool_var v2) const {
+            return s.m_activity[v1] > s.m_activity[v2];
+        }
+    };
+
+    bool solver::should_defrag() {
+        if (m_defrag_threshold > 0) --m_defrag_threshold;
+        return m_defrag_threshold == 0 && m_config.m_gc_defrag;
+    }
+
+    void solver::defrag_clauses() {
+        m_defrag_threshold = 2;
+        if (memory_pressure()) return;
+        pop(scope_lvl());
+        IF_VERBOSE(2, verbose_stream() << "(sat-defrag)\n");
+        clause_allocator& alloc = m_cls_allocator[!m_cls_allocator_idx];
+        ptr_vector<clause> new_clauses, new_learned;
+        for (clause* c : m_clauses) c->unmark_used();
+        for (clause* c : m_learned) c->unmark_used();
+
+        svector<bool_var> vars;
+        for (unsigned i = 0; i < num_vars(); ++i) vars.push_back(i);
+        std::stable_sort(vars.begin(), vars.end(), cmp_activity(*this));
+        literal_vector lits;
+        for (bool_var v : vars) lits.push_back(literal(v, false)), lits.push_back(literal(v, true));
+        // walk clauses, reallocate them in an order that defragments memory and creates locality.
+        // clauses are copied into the fresh arena of the other allocator, which compacts the clause database.
+        for (literal lit : lits) {
+            watch_list& wlist = m_watches[lit.index()];
+            for (watched& w : wlist) {
+                if (w.is_clause()) {
+                    clause& c1 = get_clause(w);
+                    clause_offset offset;
+                    if (c1.was_used()) {
+                        offset = c1.get_new_offset();
+                    }
+                    else {
+                        clause* c2 = alloc.copy_clause(c1); 
+                        c1.mark_used();
+                        if (c1.is_learned()) {
+                            new_learned.push_back(c2);
+                        }
+                        else {
+                            new_clauses.push_back(c2);
+                        }
+                        offset = alloc.get_offset(c2);
+                        c1.set_new_offset(offset);
+                    }
+                    w = watched(w.get_blocked_literal(), offset);
+                }
+            }
+        }
+
+        // reallocate ternary clauses.
+        for (clause* c : m_clauses) {
+            if (!c->was_used()) {
+                SASSERT(c->size() == 3);
+                new_clauses.push_back(alloc.copy_clause(*c));
+            }
+            dealloc_clause(c);
+        }
+
+        for (clause* c : m_learned) {
+            if (!c->was_used()) {
+                SASSERT(c->size() == 3);
+                new_learned.push_back(alloc.copy_clause(*c));
+            }
+            dealloc_clause(c);
+        }
+        m_clauses.swap(new_clauses);
+        m_learned.swap(new_learned);
+
+        cls_allocator().finalize();
+        m_cls_allocator_idx = !m_cls_allocator_idx;
+
+        reinit_assumptions();
+    }
+
 }
@@ -81,6 +81,15 @@ namespace sat {
         return (m_prefix & mask) == (p & mask);
     }
 
+    // external constraints share their watch handles with the solver
+    watched lookahead::mk_ext_watch(ext_constraint_idx idx) {
+        return m_s.mk_ext_watch(idx);
+    }
+
+    bool lookahead::find_ext_watch(ext_constraint_idx idx, watched& w) const {
+        return m_s.find_ext_watch(idx, w);
+    }
+
     void lookahead::add_binary(literal l1, literal l2) {
         TRACE(sat, tout << "binary: " << l1 << " " << l2 << "\n";);
         SASSERT(l1 != l2);
@@ -694,7 +703,7 @@ namespace sat {
         }
         for (auto w : m_watches[l.index()]) {
             lits.reset();
-            if (w.is_ext_constraint() && m_s.m_ext->is_extended_binary(w.get_ext_constraint_idx(), lits)) { 
+            if (w.is_ext_constraint() && m_s.m_ext->is_extended_binary(m_s.get_ext_constraint_idx(w), lits)) { 
                 for (literal u : lits) {
                     // u is positive in lits, l is negative:                    
                     if (~l != u && u.index() > l.index() && is_stamped(u)) {
@@ -1355,10 +1364,10 @@ namespace sat {
         watch_list::iterator it = wlist.begin(), it2 = it, end = wlist.end();
         for (; it != end && !inconsistent(); ++it) {
             SASSERT(it->get_kind() == watched::EXT_CONSTRAINT);
-            bool keep = m_s.m_ext->propagated(l, it->get_ext_constraint_idx());
+            bool keep = m_s.m_ext->propagated(l, m_s.get_ext_constraint_idx(*it));
             if (m_search_mode == lookahead_mode::lookahead1 && !m_inconsistent) {
                 lookahead_literal_occs_fun literal_occs_fn(*this);
-                m_lookahead_reward += m_s.m_ext->get_reward(l, it->get_ext_constraint_idx(), literal_occs_fn);
+                m_lookahead_reward += m_s.m_ext->get_reward(l, m_s.get_ext_constraint_idx(*it), literal_occs_fn);
             }
             if (inconsistent()) {
                 if (!keep) ++it;
@@ -2566,7 +2575,7 @@ namespace sat {
         for (unsigned i = 0; i < m_watches.size(); ++i) {
             watch_list const& wl = m_watches[i];
             if (!wl.empty()) {
-                sat::display_watch_list(out << to_literal(i) << " -> ", dummy_allocator, wl, nullptr);
+                sat::display_watch_list(out << to_literal(i) << " -> ", dummy_allocator, wl, nullptr, nullptr);
                 out << "\n";
             }
         }
@@ -472,6 +472,8 @@ namespace sat {
 
         watch_list& get_wlist(literal l) { return m_watches[l.index()]; }
         watch_list const& get_wlist(literal l) const { return m_watches[l.index()]; }
+        watched mk_ext_watch(ext_constraint_idx idx);
+        bool find_ext_watch(ext_constraint_idx idx, watched& w) const;
 
         // new clause management:
         void add_ternary(literal u, literal v, literal w);
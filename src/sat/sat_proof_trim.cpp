@@ -17,6 +17,9 @@
 --*/
 
 #include "sat/sat_proof_trim.h"
+#include "sat/dimacs.h"
+#include <mutex>
+#include <thread>
 
 namespace sat {
 
@@ -38,9 +41,9 @@ namespace sat {
         SASSERT(cl.empty());
         m_result.push_back({id, unsigned_vector()});
         conflict_analysis_core(m_conflict, m_conflict_clause);
-        m_trail.pop_back();
-        
-        for (unsigned i = m_trail.size(); i-- > 0; ) {            
+
+        // the empty clause stays on the trail so that check can find it
+        for (unsigned i = m_trail.size() - 1; i-- > 0; ) {            
             auto const& [id, cl, clp, is_add, is_initial] = m_trail[i];
             if (!is_add) {
                 revive(cl, clp);
@@ -427,4 +430,474 @@ namespace sat {
     void proof_trim::infer(unsigned id) {
         assume(id, false);        
     }
+
+    namespace {
+
+        /**
+           State for checking a lemma by reverse unit propagation
+           over the clauses it depends on.
+        */
+        class rup_checker {
+            svector<lbool>  m_value;     // indexed by literal
+            literal_vector  m_assigned;
+            unsigned_vector m_hints;
+            bool_vector     m_done;
+
+            lbool value(literal l) const { return m_value[l.index()]; }
+
+            void assign(literal l) {
+                m_value[l.index()] = l_true;
+                m_value[(~l).index()] = l_false;
+                m_assigned.push_back(l);
+            }
+
+            void reset() {
+                for (literal l : m_assigned)
+                    m_value[l.index()] = m_value[(~l).index()] = l_undef;
+                m_assigned.reset();
+            }
+
+        public:
+            rup_checker(unsigned num_vars): m_value(2 * num_vars, l_undef) {}
+
+            template<typename GetClause>
+            bool check(literal_vector const& lemma, unsigned_vector& deps, GetClause& get_clause) {
+                for (literal l : lemma) {
+                    if (value(l) == l_true) {
+                        // tautology
+                        reset();
+                        return true;
+                    }
+                    if (value(l) == l_undef)
+                        assign(~l);
+                }
+                m_hints.reset();
+                m_done.reset();
+                m_done.resize(deps.size(), false);
+                bool progress = true, conflict = false;
+                while (progress && !conflict) {
+                    progress = false;
+                    for (unsigned k = 0; k < deps.size() && !conflict; ++k) {
+                        if (m_done[k])
+                            continue;
+                        literal_vector const* cl = get_clause(deps[k]);
+                        literal unit = null_literal;
+                        unsigned num_undef = 0;
+                        bool is_sat = !cl;
+                        if (cl) {
+                            for (literal lit : *cl) {
+                                lbool v = value(lit);
+                                if (v == l_true) {
+                                    is_sat = true;
+                                    break;
+                                }
+                                if (v == l_undef) {
+                                    ++num_undef;
+                                    unit = lit;
+                                }
+                            }
+                        }
+                        if (is_sat) {
+                            m_done[k] = true;
+                            continue;
+                        }
+                        if (num_undef > 1)
+                            continue;
+                        m_done[k] = true;
+                        m_hints.push_back(deps[k]);
+                        if (num_undef == 0)
+                            conflict = true;
+                        else {
+                            assign(unit);
+                            progress = true;
+                        }
+                    }
+                }
+                reset();
+                if (conflict) {
+                    deps.reset();
+                    deps.append(m_hints);
+                }
+                return conflict;
+            }
+        };
+
+        /**
+           Forward replay of a segment of the proof trail.
+           Clauses are identified by their position on the trail.
+           Level 0 holds the consequences of the live clauses, a lemma is
+           checked by assigning its negation above level 0 and propagating.
+        */
+        class segment_checker {
+            typedef vector<std::tuple<unsigned, literal_vector, clause*, bool, bool>> trail_t;
+            static unsigned const none = UINT_MAX;
+            trail_t const&         m_trail;
+            unsigned_vector const& m_del_of;     // deletion -> deleted clause
+            unsigned_vector const& m_deleted_at; // clause -> its deletion
+            vector<literal_vector> m_lits;       // watched literals first
+            vector<unsigned_vector> m_watches;   // visited when the literal becomes false
+            bool_vector            m_deleted;
+            svector<lbool>         m_value;
+            unsigned_vector        m_reason, m_pos;
+            bool_vector            m_mark;
+            literal_vector         m_assigned;
+            unsigned_vector        m_units;
+            unsigned               m_qhead = 0;
+            unsigned               m_conflict = none;
+
+            lbool value(literal l) const { return m_value[l.index()]; }
+            unsigned id(unsigned i) const { return std::get<0>(m_trail[i]); }
+
+            void assign(literal l, unsigned reason) {
+                m_value[l.index()] = l_true;
+                m_value[(~l).index()] = l_false;
+                m_reason[l.var()] = reason;
+                m_pos[l.var()] = m_assigned.size();
+                m_assigned.push_back(l);
+            }
+
+            void backtrack(unsigned sz) {
+                for (unsigned i = sz; i < m_assigned.size(); ++i) {
+                    literal l = m_assigned[i];
+                    m_value[l.index()] = m_value[(~l).index()] = l_undef;
+                }
+                m_assigned.shrink(sz);
+                m_qhead = std::min(m_qhead, sz);
+            }
+
+            unsigned propagate() {
+                while (m_qhead < m_assigned.size()) {
+                    literal l = ~m_assigned[m_qhead++];
+                    auto& ws = m_watches[l.index()];
+                    unsigned j = 0, k = 0, sz = ws.size();
+                    for (; k < sz; ++k) {
+                        unsigned ci = ws[k];
+                        if (m_deleted[ci])
+                            continue;
+                        auto& c = m_lits[ci];
+                        if (c[0] == l)
+                            std::swap(c[0], c[1]);
+                        if (value(c[0]) == l_true) {
+                            ws[j++] = ci;
+                            continue;
+                        }
+                        bool found = false;
+                        for (unsigned t = 2; t < c.size() && !found; ++t) {
+                            if (value(c[t]) != l_false) {
+                                std::swap(c[1], c[t]);
+                                m_watches[c[1].index()].push_back(ci);
+                                found = true;
+                            }
+                        }
+                        if (found)
+                            continue;
+                        ws[j++] = ci;
+                        if (value(c[0]) == l_false) {
+                            for (++k; k < sz; ++k)
+                                ws[j++] = ws[k];
+                            ws.shrink(j);
+                            return ci;
+                        }
+                        assign(c[0], ci);
+                    }
+                    ws.shrink(j);
+                }
+                return none;
+            }
+
+            void attach(unsigned i) {
+                auto& c = m_lits[i];
+                c = std::get<1>(m_trail[i]);
+                if (c.empty()) {
+                    if (m_conflict == none)
+                        m_conflict = i;
+                    return;
+                }
+                if (c.size() == 1)
+                    m_units.push_back(i);
+                // watch non-false literals, otherwise the literals falsified last
+                auto rank = [&](literal l) {
+                    return value(l) == l_false ? m_pos[l.var()] : UINT_MAX;
+                };
+                for (unsigned w = 0; w < 2 && w < c.size(); ++w)
+                    for (unsigned t = w + 1; t < c.size(); ++t)
+                        if (rank(c[t]) > rank(c[w]))
+                            std::swap(c[t], c[w]);
+                if (c.size() > 1) {
+                    m_watches[c[0].index()].push_back(i);
+                    m_watches[c[1].index()].push_back(i);
+                }
+                if (m_conflict != none)
+                    return;
+                if (value(c[0]) == l_false)
+                    m_conflict = i;
+                else if (value(c[0]) == l_undef && (c.size() == 1 || value(c[1]) == l_false))
+                    assign(c[0], i);
+                if (m_conflict == none)
+                    m_conflict = propagate();
+            }
+
+            // a deleted reason invalidates level 0, it is rebuilt from the live clauses
+            void detach(unsigned i) {
+                m_deleted[i] = true;
+                bool is_reason = m_conflict == i;
+                for (literal l : m_lits[i])
+                    is_reason |= value(l) == l_true && m_reason[l.var()] == i;
+                if (!is_reason)
+                    return;
+                backtrack(0);
+                m_conflict = none;
+                for (unsigned u : m_units) {
+                    literal l = m_lits[u][0];
+                    if (value(l) == l_false && m_conflict == none)
+                        m_conflict = u;
+                    else if (value(l) == l_undef)
+                        assign(l, u);
+                }
+                if (m_conflict == none)
+                    m_conflict = propagate();
+            }
+
+            void analyze(unsigned ci, literal lit, unsigned_vector& deps) {
+                unsigned num_marked = 0;
+                auto mark = [&](literal l) {
+                    if (!m_mark[l.var()] && value(l) != l_undef) {
+                        m_mark[l.var()] = true;
+                        ++num_marked;
+                    }
+                };
+                if (ci != none) {
+                    deps.push_back(id(ci));
+                    for (literal l : m_lits[ci])
+                        mark(l);
+                }
+                else
+                    mark(lit);
+                for (unsigned k = m_assigned.size(); num_marked > 0 && k-- > 0; ) {
+                    bool_var v = m_assigned[k].var();
+                    if (!m_mark[v])
+                        continue;
+                    m_mark[v] = false;
+                    --num_marked;
+                    unsigned r = m_reason[v];
+                    if (r == none)
+                        continue;
+                    deps.push_back(id(r));
+                    for (literal l : m_lits[r])
+                        if (l.var() != v)
+                            mark(l);
+                }
+            }
+
+            void check(literal_vector const& lemma, unsigned_vector& deps) {
+                if (m_conflict != none) {
+                    analyze(m_conflict, null_literal, deps);
+                    return;
+                }
+                unsigned sz = m_assigned.size();
+                literal sat = null_literal;
+                for (literal l : lemma) {
+                    if (value(l) == l_true) {
+                        sat = l;
+                        break;
+                    }
+                    if (value(l) == l_undef)
+                        assign(~l, none);
+                }
+                unsigned ci = sat == null_literal ? propagate() : none;
+                if (ci != none || sat != null_literal)
+                    analyze(ci, sat, deps);
+                backtrack(sz);
+            }
+
+        public:
+            segment_checker(trail_t const& trail, unsigned_vector const& del_of, unsigned_vector const& deleted_at, unsigned num_vars):
+                m_trail(trail), m_del_of(del_of), m_deleted_at(deleted_at),
+                m_lits(trail.size()), m_watches(2 * num_vars), m_deleted(trail.size(), false),
+                m_value(2 * num_vars, l_undef), m_reason(num_vars, none), m_pos(num_vars, 0u),
+                m_mark(num_vars, false) {}
+
+            /**
+               Replay the trail from begin to end and store the dependencies
+               of every lemma in deps, indexed by trail position.
+               A lemma that does not follow by unit propagation gets no dependencies.
+            */
+            void run(unsigned begin, unsigned end, vector<unsigned_vector>& deps) {
+                for (unsigned i = 0; i < begin; ++i)
+                    if (std::get<3>(m_trail[i]) && m_deleted_at[i] >= begin)
+                        attach(i);
+                for (unsigned i = begin; i < end; ++i) {
+                    auto const& [id, cl, clp, is_add, is_initial] = m_trail[i];
+                    if (!is_add) {
+                        if (m_del_of[i] != none)
+                            detach(m_del_of[i]);
+                        continue;
+                    }
+                    if (!is_initial)
+                        check(cl, deps[i]);
+                    attach(i);
+                }
+            }
+        };
+    }
+
+    void proof_trim::init_id2trail(u_map<unsigned>& id2trail) const {
+        for (unsigned i = 0; i < m_trail.size(); ++i) {
+            auto const& [id, cl, clp, is_add, is_initial] = m_trail[i];
+            if (is_add && !id2trail.contains(id))
+                id2trail.insert(id, i);
+        }
+    }
+
+    bool proof_trim::read_drat(dimacs::drat_parser& drat, unsigned& num_inputs, unsigned& num_lemmas) {
+        for (auto const& r : drat) {
+            init_clause();
+            for (literal lit : r.m_lits) {
+                SASSERT(lit.var() > 0);
+                while (lit.var() > num_vars())
+                    mk_var();
+                add_literal(lit.var() - 1, lit.sign());
+            }
+            if (r.m_status.is_deleted())
+                del();
+            else if (r.m_status.is_redundant() && r.m_status.is_sat()) {
+                infer(lemma_id_base + num_lemmas++);
+                if (r.m_lits.empty())
+                    return true;
+            }
+            else
+                assume(++num_inputs);
+        }
+        return false;
+    }
+
+    unsigned proof_trim::check(vector<std::pair<unsigned, unsigned_vector>>& proof) {
+        u_map<unsigned> id2trail;
+        init_id2trail(id2trail);
+        unsigned num_failed = 0;
+        rup_checker checker(s.num_vars());
+
+        auto get_clause = [&](unsigned id) -> literal_vector const* {
+            unsigned idx;
+            if (!id2trail.find(id, idx))
+                return nullptr;
+            return &std::get<1>(m_trail[idx]);
+        };
+
+        for (auto& [id, deps] : proof) {
+            unsigned idx;
+            if (!id2trail.find(id, idx)) {
+                ++num_failed;
+                continue;
+            }
+            auto const& [id1, cl, clp, is_add, is_initial] = m_trail[idx];
+            if (is_initial)
+                continue;
+            if (!checker.check(cl, deps, get_clause))
+                ++num_failed;
+        }
+        return num_failed;
+    }
+
+    vector<std::pair<unsigned, unsigned_vector>> proof_trim::trim(unsigned num_threads) {
+        unsigned n = m_trail.size();
+        SASSERT(n > 0 && std::get<1>(m_trail.back()).empty());
+
+        // match deletions with the clauses they delete, units are never deleted
+        unsigned_vector del_of(n, UINT_MAX), deleted_at(n, UINT_MAX);
+        map<literal_vector, unsigned_vector, hash, eq> live;
+        for (unsigned i = 0; i < n; ++i) {
+            auto const& [id, cl, clp, is_add, is_initial] = m_trail[i];
+            if (is_add)
+                live.insert_if_not_there(cl, unsigned_vector()).push_back(i);
+            else if (cl.size() > 1) {
+                auto* e = live.find_core(cl);
+                if (!e || e->get_data().m_value.empty())
+                    continue;
+                unsigned j = e->get_data().m_value.back();
+                e->get_data().m_value.pop_back();
+                del_of[i] = j;
+                deleted_at[j] = i;
+            }
+        }
+
+        vector<unsigned_vector> deps(n);
+        num_threads = std::max(1u, std::min(num_threads, n));
+        unsigned chunk = (n + num_threads - 1) / num_threads;
+        std::mutex mux;
+        std::exception_ptr ex = nullptr;
+        auto worker = [&](unsigned begin, unsigned end) {
+            try {
+                segment_checker checker(m_trail, del_of, deleted_at, num_vars());
+                checker.run(begin, end, deps);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (!ex)
+                    ex = std::current_exception();
+            }
+        };
+        vector<std::thread> threads;
+        for (unsigned begin = 0; begin < n; begin += chunk)
+            threads.push_back(std::thread([&, begin]() { worker(begin, std::min(n, begin + chunk)); }));
+        for (auto& th : threads)
+            th.join();
+        if (ex)
+            std::rethrow_exception(ex);
+
+        u_map<unsigned> id2trail;
+        init_id2trail(id2trail);
+        bool_vector in_core(n, false);
+        unsigned_vector todo;
+        in_core[n - 1] = true;
+        todo.push_back(n - 1);
+        while (!todo.empty()) {
+            unsigned i = todo.back();
+            todo.pop_back();
+            for (unsigned d : deps[i]) {
+                unsigned j;
+                if (id2trail.find(d, j) && !in_core[j]) {
+                    in_core[j] = true;
+                    todo.push_back(j);
+                }
+            }
+        }
+
+        vector<std::pair<unsigned, unsigned_vector>> result;
+        for (unsigned i = 0; i < n; ++i) {
+            if (!in_core[i])
+                continue;
+            auto const& [id, cl, clp, is_add, is_initial] = m_trail[i];
+            result.push_back({ id, is_initial ? unsigned_vector() : deps[i] });
+        }
+        return result;
+    }
+
+    std::ostream& proof_trim::display_lrat(std::ostream& out, vector<std::pair<unsigned, unsigned_vector>> const& proof, unsigned num_inputs) const {
+        u_map<unsigned> id2trail, id2lrat;
+        init_id2trail(id2trail);
+        unsigned n = num_inputs;
+        auto lrat_id = [&](unsigned id) {
+            unsigned r = id;
+            id2lrat.find(id, r);
+            return r;
+        };
+        for (auto const& [id, deps] : proof) {
+            unsigned idx;
+            if (!id2trail.find(id, idx))
+                continue;
+            auto const& [id1, cl, clp, is_add, is_initial] = m_trail[idx];
+            if (is_initial)
+                continue;
+            out << ++n;
+            for (literal lit : cl)
+                out << " " << dimacs_lit(lit);
+            out << " 0";
+            for (unsigned d : deps)
+                out << " " << lrat_id(d);
+            out << " 0\n";
+            id2lrat.insert(id, n);
+        }
+        return out;
+    }
 }
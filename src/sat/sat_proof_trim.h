@@ -26,6 +26,10 @@
 #include "sat/sat_types.h"
 #include "sat/sat_solver.h"
 
+namespace dimacs {
+    class drat_parser;
+}
+
 namespace sat {
 
     class proof_trim {
@@ -78,6 +82,8 @@ namespace sat {
         uint_set m_units;
         bool unit_or_binary_occurs();
         void set_conflict(literal_vector const& c, clause* cp) { m_conflict.reset(); m_conflict.append(c); m_conflict_clause = cp;}
+
+        void init_id2trail(u_map<unsigned>& id2trail) const;
         
     public:
 
@@ -95,5 +101,43 @@ namespace sat {
 
         vector<std::pair<unsigned, unsigned_vector>> trim();
 
+        /**
+           \brief Trim the proof on num_threads threads.
+           The trail is split into segments that are replayed forwards in parallel.
+           Each thread starts from the clauses live at the beginning of its segment
+           and records the clauses that unit propagation uses to refute each lemma.
+           The core is then marked backwards from the empty clause.
+           The result has the same form as the result of trim.
+        */
+        vector<std::pair<unsigned, unsigned_vector>> trim(unsigned num_threads);
+
+        /**
+           \brief Read a DRAT proof up to the first empty clause.
+           Input and theory clauses are assumed with ids 1, 2, ... in the order
+           they occur, as in the CNF, lemmas get ids from lemma_id_base on.
+           The proof uses DIMACS variables, they are shifted down by one so that
+           display_lrat writes them back with the numbering of the proof.
+           Return false if the proof does not derive the empty clause.
+        */
+        static unsigned const lemma_id_base = 1u << 31;
+        bool read_drat(dimacs::drat_parser& drat, unsigned& num_inputs, unsigned& num_lemmas);
+
+        /**
+           \brief Verify the lemmas of a trimmed proof by reverse unit propagation
+           over their dependencies.
+           The dependencies of every verified lemma are reduced to the clauses
+           used by unit propagation, in the order they become unit, as
+           required for LRAT hints.
+           Return the number of lemmas that could not be verified.
+        */
+        unsigned check(vector<std::pair<unsigned, unsigned_vector>>& proof);
+
+        /**
+           \brief Display a checked proof in LRAT format.
+           Initial clauses are referred to by their ids, the caller numbers them
+           as in the input CNF. Lemmas are numbered from num_inputs + 1.
+        */
+        std::ostream& display_lrat(std::ostream& out, vector<std::pair<unsigned, unsigned_vector>> const& proof, unsigned num_inputs) const;
+
     };
 }
@@ -0,0 +1,315 @@
+/*++
+  Copyright (c) 2026 Microsoft Corporation
+
+  Module Name:
+
+   sat_sim_sweep.cpp
+
+  Abstract:
+
+    Equivalence and constant detection by bit-parallel random simulation.
+
+  --*/
+
+#include <algorithm>
+#include "util/union_find.h"
+#include "util/stopwatch.h"
+#include "sat/sat_sim_sweep.h"
+#include "sat/sat_solver.h"
+#include "sat/sat_elim_eqs.h"
+#include "sat/sat_aig_finder.h"
+
+namespace sat {
+
+    struct sim_sweep::report {
+        sim_sweep& s;
+        stopwatch  m_watch;
+        report(sim_sweep& s): s(s) { m_watch.start(); }
+        ~report() {
+            m_watch.stop();
+            IF_VERBOSE(2,
+                       verbose_stream() << " (sat.sim-sweep"
+                       << " :gates " << s.m_stats.m_num_gates
+                       << " :candidates " << s.m_stats.m_num_candidates
+                       << " :probes " << s.m_stats.m_num_probes
+                       << " :num-units " << s.m_stats.m_num_units
+                       << " :num-eqs " << s.m_stats.m_num_eqs
+                       << m_watch << ")\n");
+        }
+    };
+
+    sim_sweep::sim_sweep(solver& s, unsigned max_probes): s(s), m_max_probes(max_probes) {}
+
+    void sim_sweep::operator()() {
+        SASSERT(s.at_base_lvl());
+        report _report(*this);
+        find_gates();
+        sort_gates();
+        simulate();
+        sweep();
+    }
+
+    void sim_sweep::find_gates() {
+        m_def.reset();
+        m_def.resize(s.num_vars(), UINT_MAX);
+        auto add_gate = [&](literal head, bool is_ite, unsigned sz, literal const* args) {
+            if (m_def[head.var()] != UINT_MAX)
+                return;
+            for (unsigned i = 0; i < sz; ++i)
+                if (args[i].var() == head.var())
+                    return;
+            m_def[head.var()] = m_gates.size();
+            m_gates.push_back({ head, is_ite, m_args.size(), sz });
+            m_args.append(sz, args);
+        };
+        std::function<void(literal, literal_vector const&)> on_aig =
+            [&](literal head, literal_vector const& ands) {
+            add_gate(head, false, ands.size(), ands.data());
+        };
+        std::function<void(literal, literal, literal, literal)> on_if =
+            [&](literal head, literal c, literal th, literal el) {
+            literal args[3] = { c, th, el };
+            add_gate(head, true, 3, args);
+        };
+        clause_vector clauses(s.clauses());
+        aig_finder af(s);
+        af.set(on_aig);
+        af.set(on_if);
+        af(clauses);
+        m_stats.m_num_gates = m_gates.size();
+    }
+
+    /**
+       \brief Order the gates so that every gate comes after the gates
+       defining its arguments. A definition that closes a cycle is dropped
+       and its head is simulated as an input.
+    */
+    void sim_sweep::sort_gates() {
+        enum { unvisited, active, done };
+        unsigned num_vars = s.num_vars();
+        svector<unsigned char> state(num_vars, unvisited);
+        unsigned_vector todo;
+        for (bool_var v = 0; v < num_vars; ++v) {
+            todo.push_back(v);
+            while (!todo.empty()) {
+                bool_var w = todo.back();
+                unsigned g = m_def[w];
+                if (state[w] == done || g == UINT_MAX) {
+                    state[w] = done;
+                    todo.pop_back();
+                    continue;
+                }
+                if (state[w] == active) {
+                    state[w] = done;
+                    m_order.push_back(g);
+                    todo.pop_back();
+                    continue;
+                }
+                gate const& gt = m_gates[g];
+                literal const* args = m_args.data() + gt.m_offset;
+                if (std::any_of(args, args + gt.m_size, [&](literal a) { return state[a.var()] == active; })) {
+                    m_def[w] = UINT_MAX;
+                    continue;
+                }
+                state[w] = active;
+                for (unsigned i = 0; i < gt.m_size; ++i)
+                    if (state[args[i].var()] == unvisited)
+                        todo.push_back(args[i].var());
+            }
+        }
+    }
+
+    void sim_sweep::eval(literal l, uint64_t* out) {
+        uint64_t mask = l.sign() ? ~static_cast<uint64_t>(0) : 0;
+        uint64_t const* v = sim(l.var());
+        for (unsigned i = 0; i < num_words; ++i)
+            out[i] = v[i] ^ mask;
+    }
+
+    void sim_sweep::simulate() {
+        random_gen& rand = s.rand();
+        unsigned num_vars = s.num_vars();
+        m_sim.reset();
+        m_sim.resize(num_vars * num_words, 0);
+        for (bool_var v = 0; v < num_vars; ++v) {
+            uint64_t* out = sim(v);
+            lbool val = s.value(v);
+            for (unsigned i = 0; i < num_words; ++i) {
+                if (val != l_undef)
+                    out[i] = val == l_true ? ~static_cast<uint64_t>(0) : 0;
+                else
+                    for (unsigned k = 0; k < 5; ++k)
+                        out[i] = (out[i] << 15) ^ static_cast<uint64_t>(rand());
+            }
+        }
+        uint64_t acc[num_words], a[num_words], b[num_words], c[num_words];
+        for (unsigned g : m_order) {
+            gate const& gt = m_gates[g];
+            literal const* args = m_args.data() + gt.m_offset;
+            if (s.value(gt.m_head) != l_undef)
+                continue;
+            if (gt.m_is_ite) {
+                eval(args[0], a);
+                eval(args[1], b);
+                eval(args[2], c);
+                for (unsigned i = 0; i < num_words; ++i)
+                    acc[i] = (a[i] & b[i]) | (~a[i] & c[i]);
+            }
+            else {
+                for (unsigned i = 0; i < num_words; ++i)
+                    acc[i] = ~static_cast<uint64_t>(0);
+                for (unsigned j = 0; j < gt.m_size; ++j) {
+                    eval(args[j], a);
+                    for (unsigned i = 0; i < num_words; ++i)
+                        acc[i] &= a[i];
+                }
+            }
+            uint64_t mask = gt.m_head.sign() ? ~static_cast<uint64_t>(0) : 0;
+            uint64_t* out = sim(gt.m_head.var());
+            for (unsigned i = 0; i < num_words; ++i)
+                out[i] = acc[i] ^ mask;
+        }
+    }
+
+    /**
+       \brief Return true if l propagates to a conflict. Then ~l is
+       asserted as a unit.
+    */
+    bool sim_sweep::probe_conflict(literal l) {
+        ++m_stats.m_num_probes;
+        s.push();
+        s.assign_scoped(l);
+        s.propagate(false);
+        if (s.inconsistent()) {
+            s.drat_explain_conflict();
+            s.pop(1);
+            s.assign_scoped(~l);
+            s.propagate(false);
+            ++m_stats.m_num_units;
+            return true;
+        }
+        s.pop(1);
+        return false;
+    }
+
+    /**
+       \brief Return true if l propagates implied.
+    */
+    bool sim_sweep::probe(literal l, literal implied) {
+        ++m_stats.m_num_probes;
+        s.push();
+        s.assign_scoped(l);
+        s.propagate(false);
+        if (s.inconsistent()) {
+            s.drat_explain_conflict();
+            s.pop(1);
+            s.assign_scoped(~l);
+            s.propagate(false);
+            ++m_stats.m_num_units;
+            return false;
+        }
+        bool r = s.value(implied) == l_true;
+        s.pop(1);
+        return r;
+    }
+
+    /**
+       \brief Return true if l => implied is established by probing
+       either l or the contrapositive ~implied. Unit propagation is
+       one-sided on gates: for head == a & b the literal ~head does not
+       propagate, but head does.
+    */
+    bool sim_sweep::implies(literal l, literal implied) {
+        if (probe(l, implied))
+            return true;
+        return !s.inconsistent() && s.value(l) == l_undef && s.value(implied) == l_undef && probe(~implied, ~l);
+    }
+
+    void sim_sweep::sweep() {
+        static const unsigned max_checks = 2;
+        unsigned num_vars = s.num_vars();
+        union_find_default_ctx ctx;
+        union_find<> uf(ctx);
+        for (unsigned i = 2 * num_vars; i-- > 0; ) uf.mk_var();
+        u_map<unsigned> heads;
+        unsigned_vector next(num_vars, UINT_MAX);
+
+        // the signature of literal(v, phase(v)) is zero in the first pattern
+        auto phase = [&](bool_var v) { return (sim(v)[0] & 1) != 0; };
+        auto is_zero = [&](bool_var v) {
+            uint64_t mask = phase(v) ? ~static_cast<uint64_t>(0) : 0;
+            for (unsigned i = 0; i < num_words; ++i)
+                if ((sim(v)[i] ^ mask) != 0)
+                    return false;
+            return true;
+        };
+        auto hash = [&](bool_var v) {
+            uint64_t mask = phase(v) ? ~static_cast<uint64_t>(0) : 0;
+            unsigned h = 0;
+            for (unsigned i = 0; i < num_words; ++i) {
+                uint64_t w = sim(v)[i] ^ mask;
+                h = combine_hash(h, static_cast<unsigned>(w) ^ static_cast<unsigned>(w >> 32));
+            }
+            return h;
+        };
+        auto same_sim = [&](bool_var v, bool_var w) {
+            uint64_t mask = phase(v) != phase(w) ? ~static_cast<uint64_t>(0) : 0;
+            for (unsigned i = 0; i < num_words; ++i)
+                if (sim(v)[i] != (sim(w)[i] ^ mask))
+                    return false;
+            return true;
+        };
+
+        for (bool_var v = 0; v < num_vars && !s.inconsistent(); ++v) {
+            if (m_stats.m_num_probes >= m_max_probes)
+                break;
+            if (s.was_eliminated(v) || s.value(v) != l_undef)
+                continue;
+            literal lv(v, phase(v));
+            if (is_zero(v)) {
+                ++m_stats.m_num_candidates;
+                probe_conflict(lv);
+                continue;
+            }
+            unsigned h = hash(v);
+            unsigned head = UINT_MAX;
+            heads.find(h, head);
+            unsigned num_checks = 0;
+            bool merged = false;
+            for (bool_var w = head; w != UINT_MAX && num_checks < max_checks && !merged; w = next[w]) {
+                if (s.value(w) != l_undef || !same_sim(v, w))
+                    continue;
+                ++num_checks;
+                ++m_stats.m_num_candidates;
+                literal lw(w, phase(w));
+                if (!implies(lv, lw) || s.value(v) != l_undef || !implies(lw, lv) || s.value(v) != l_undef)
+                    continue;
+                if (s.m_config.m_drat) {
+                    s.m_drat.add(~lv, lw, status::redundant());
+                    s.m_drat.add(lv, ~lw, status::redundant());
+                }
+                uf.merge(lv.index(), lw.index());
+                uf.merge((~lv).index(), (~lw).index());
+                ++m_stats.m_num_eqs;
+                merged = true;
+            }
+            if (!merged && !s.inconsistent() && s.value(v) == l_undef) {
+                next[v] = head;
+                heads.insert(h, v);
+            }
+        }
+
+        if (m_stats.m_num_eqs > 0 && !s.inconsistent()) {
+            elim_eqs elim(s);
+            elim(uf);
+        }
+    }
+
+    void sim_sweep::collect_statistics(statistics& st) const {
+        st.update("sat-sim.gates",      m_stats.m_num_gates);
+        st.update("sat-sim.candidates", m_stats.m_num_candidates);
+        st.update("sat-sim.probes",     m_stats.m_num_probes);
+        st.update("sat-sim.units",      m_stats.m_num_units);
+        st.update("sat-sim.eqs",        m_stats.m_num_eqs);
+    }
+}
@@ -0,0 +1,79 @@
+/*++
+  Copyright (c) 2026 Microsoft Corporation
+
+  Module Name:
+
+   sat_sim_sweep.h
+
+  Abstract:
+
+    Equivalence and constant detection by bit-parallel random simulation.
+
+    AND and if-then-else gates are extracted from the clauses with the
+    aig_finder. The variables that are not defined by a gate get random
+    values for 256 patterns, stored as four 64-bit words per variable,
+    and the gates are evaluated word by word in topological order.
+    Variables are bucketed by their signatures, up to complement.
+    Variables in the same bucket are candidate equivalences, and
+    variables with a constant signature are candidate units.
+
+    Candidates are confirmed by unit propagation, as in probing: an
+    equivalence l1 == l2 holds if l1 propagates l2 and l2 propagates
+    l1, and a unit ~l holds if l propagates to a conflict. Confirmed
+    equivalences are eliminated with elim_eqs.
+
+  --*/
+#pragma once
+
+#include "util/statistics.h"
+#include "sat/sat_types.h"
+
+namespace sat {
+
+    class solver;
+
+    class sim_sweep {
+        static const unsigned num_words = 4;
+
+        struct report;
+
+        struct stats {
+            unsigned m_num_gates, m_num_candidates, m_num_probes;
+            unsigned m_num_units, m_num_eqs;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+
+        struct gate {
+            literal  m_head;
+            bool     m_is_ite;
+            unsigned m_offset;  // position of the arguments in m_args
+            unsigned m_size;
+        };
+
+        solver&           s;
+        unsigned          m_max_probes;
+        stats             m_stats;
+        svector<gate>     m_gates;
+        literal_vector    m_args;
+        unsigned_vector   m_def;     // gate defining a variable, UINT_MAX for inputs
+        unsigned_vector   m_order;   // gates in topological order
+        svector<uint64_t> m_sim;
+
+        uint64_t* sim(bool_var v) { return m_sim.data() + v * num_words; }
+        void eval(literal l, uint64_t* out);
+
+        void find_gates();
+        void sort_gates();
+        void simulate();
+        bool probe(literal l, literal implied);
+        bool implies(literal l, literal implied);
+        bool probe_conflict(literal l);
+        void sweep();
+
+    public:
+        sim_sweep(solver& s, unsigned max_probes);
+        void operator()();
+        void collect_statistics(statistics& st) const;
+    };
+}
@@ -788,6 +788,7 @@ namespace sat {
        \brief Eliminate duplicated binary clauses.
     */
     void simplifier::elim_dup_bins() {
+        s.invalidate_bin_watches();
 #ifdef _TRACE
         unsigned l_idx = 0;
 #endif
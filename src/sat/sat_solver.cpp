@@ -32,6 +32,8 @@ Revision History:
 #include "sat/sat_ddfw_wrapper.h"
 #include "sat/sat_prob.h"
 #include "sat/sat_anf_simplifier.h"
+#include "sat/sat_sim_sweep.h"
+#include "util/profile.h"
 #if defined(_MSC_VER) && !defined(_M_ARM) && !defined(_M_ARM64)
 # include <xmmintrin.h>
 #endif
@@ -87,6 +89,7 @@ namespace sat {
     }
 
     solver::~solver() {
+        m_async_simplifier = nullptr;
         m_ext = nullptr;
         SASSERT(m_config.m_num_threads > 1 || m_trim || rlimit().is_canceled() || check_invariant());
         CTRACE(sat, !m_clauses.empty(), tout << "Delete clauses\n";);
@@ -117,9 +120,12 @@ namespace sat {
 
     void solver::copy(solver const & src, bool copy_learned) {
         pop_to_base_level();
+        if (m_async_simplifier)
+            m_async_simplifier->cancel();
         del_clauses(m_clauses);
         del_clauses(m_learned);
         m_watches.reset();
+        invalidate_bin_watches();
         m_assignment.reset();
         m_justification.reset();
         m_decision.reset();
@@ -256,6 +262,8 @@ namespace sat {
     void solver::reset_var(bool_var v, bool ext, bool dvar) {
         m_watches[2*v].reset();
         m_watches[2*v+1].reset();
+        invalidate_bin_watches(literal(v, false));
+        invalidate_bin_watches(literal(v, true));
         m_assignment[2*v] = l_undef;
         m_assignment[2*v+1] = l_undef;
         m_justification[v] = justification(UINT_MAX);
@@ -673,87 +681,6 @@ namespace sat {
         m_best_phase[v] = value;
     }
 
-    struct solver::cmp_activity {
-        solver& s;
-        cmp_activity(solver& s):s(s) {}
-        bool operator()(bool_var v1, bool_var v2) const {
-            return s.m_activity[v1] > s.m_activity[v2];
-        }
-    };
-
-    bool solver::should_defrag() {
-        if (m_defrag_threshold > 0) --m_defrag_threshold;
-        return m_defrag_threshold == 0 && m_config.m_gc_defrag;
-    }
-
-    void solver::defrag_clauses() {
-        m_defrag_threshold = 2;
-        if (memory_pressure()) return;
-        pop(scope_lvl());
-        IF_VERBOSE(2, verbose_stream() << "(sat-defrag)\n");
-        clause_allocator& alloc = m_cls_allocator[!m_cls_allocator_idx];
-        ptr_vector<clause> new_clauses, new_learned;
-        for (clause* c : m_clauses) c->unmark_used();
-        for (clause* c : m_learned) c->unmark_used();
-
-        svector<bool_var> vars;
-        for (unsigned i = 0; i < num_vars(); ++i) vars.push_back(i);
-        std::stable_sort(vars.begin(), vars.end(), cmp_activity(*this));
-        literal_vector lits;
-        for (bool_var v : vars) lits.push_back(literal(v, false)), lits.push_back(literal(v, true));
-        // walk clauses, reallocate them in an order that defragments memory and creates locality.
-        for (literal lit : lits) {
-            watch_list& wlist = m_watches[lit.index()];
-            for (watched& w : wlist) {
-                if (w.is_clause()) {
-                    clause& c1 = get_clause(w);
-                    clause_offset offset;
-                    if (c1.was_used()) {
-                        offset = c1.get_new_offset();
-                    }
-                    else {
-                        clause* c2 = alloc.copy_clause(c1); 
-                        c1.mark_used();
-                        if (c1.is_learned()) {
-                            new_learned.push_back(c2);
-                        }
-                        else {
-                            new_clauses.push_back(c2);
-                        }
-                        offset = get_offset(*c2);
-                        c1.set_new_offset(offset);
-                    }
-                    w = watched(w.get_blocked_literal(), offset);
-                }
-            }
-        }
-
-        // reallocate ternary clauses.
-        for (clause* c : m_clauses) {
-            if (!c->was_used()) {
-                SASSERT(c->size() == 3);
-                new_clauses.push_back(alloc.copy_clause(*c));
-            }
-            dealloc_clause(c);
-        }
-
-        for (clause* c : m_learned) {
-            if (!c->was_used()) {
-                SASSERT(c->size() == 3);
-                new_learned.push_back(alloc.copy_clause(*c));
-            }
-            dealloc_clause(c);
-        }
-        m_clauses.swap(new_clauses);
-        m_learned.swap(new_learned);
-
-        cls_allocator().finalize();
-        m_cls_allocator_idx = !m_cls_allocator_idx;
-
-        reinit_assumptions();
-    }
-
-
     void solver::set_learned(literal l1, literal l2, bool redundant) {
         set_learned1(l1, l2, redundant);
         set_learned1(l2, l1, redundant);
@@ -1011,6 +938,7 @@ namespace sat {
     }
 
     bool solver::propagate(bool update) {
+        PROFILE_SCOPE("sat.propagate");
         unsigned qhead = m_qhead;
         bool r = propagate_core(update);
         if (m_config.m_branching_heuristic == BH_CHB) {
@@ -1021,6 +949,18 @@ namespace sat {
         return r;
     }
 
+    bool solver::probe_literal(literal l, unsigned& num_assigned) {
+        SASSERT(value(l) == l_undef);
+        SASSERT(!inconsistent());
+        unsigned old_sz = m_trail.size();
+        push();
+        assign_scoped(l);
+        bool ok = propagate(false);
+        num_assigned = m_trail.size() - old_sz;
+        pop(1);
+        return ok;
+    }
+
     void solver::propagate_clause(clause& c, bool update, unsigned assign_level, clause_offset cls_off) {
         unsigned glue;
         SASSERT(value(c[0]) == l_undef); 
@@ -1037,6 +977,25 @@ namespace sat {
         m_watches[(~c[1]).index()].push_back(watched(c[0], cls_off));
     }
 
+#ifdef SAT_HOT_BINARY_WATCHES
+    literal_vector const& solver::get_bin_watches(literal l) {
+        unsigned idx = l.index();
+        if (idx >= m_bin_watches_stamp.size()) {
+            m_bin_watches.resize(m_watches.size());
+            m_bin_watches_stamp.resize(m_watches.size(), 0);
+        }
+        literal_vector& bins = m_bin_watches[idx];
+        if (m_bin_watches_stamp[idx] != m_bin_watches_epoch) {
+            bins.reset();
+            for (watched const& w : m_watches[idx])
+                if (w.is_binary_clause())
+                    bins.push_back(w.get_literal());
+            m_bin_watches_stamp[idx] = m_bin_watches_epoch;
+        }
+        return bins;
+    }
+#endif
+
     bool solver::propagate_literal(literal l, bool update) {
         literal l1;
 
@@ -1047,7 +1006,23 @@ namespace sat {
         literal not_l = ~l;
         SASSERT(value(l) == l_true);
         SASSERT(value(not_l) == l_false);
+#ifdef SAT_HOT_BINARY_WATCHES
+        for (literal l1 : get_bin_watches(l)) {
+            switch (value(l1)) {
+            case l_false:
+                set_conflict(justification(curr_level, not_l), ~l1);
+                return false;
+            case l_undef:
+                m_stats.m_bin_propagate++;
+                assign_core(l1, justification(curr_level, not_l));
+                break;
+            case l_true:
+                break; // skip
+            }
+        }
+#endif
         watch_list& wlist = m_watches[l.index()];
+        SAT_PS_CODE(m_stats.m_watch_visits += wlist.size(););
         m_asymm_branch.dec(wlist.size());
         m_probing.dec(wlist.size());
         watch_list::iterator it = wlist.begin();
@@ -1061,6 +1036,12 @@ namespace sat {
         for (; it != end; ++it) {
             switch (it->get_kind()) {
             case watched::BINARY:
+#ifdef SAT_HOT_BINARY_WATCHES
+                // propagated from get_bin_watches above
+                *it2 = *it;
+                it2++;
+                break;
+#endif
                 l1 = it->get_literal();
                 switch (value(l1)) {
                 case l_false:
@@ -1087,6 +1068,7 @@ namespace sat {
                 }
                 clause_offset cls_off = it->get_clause_offset();
                 clause& c = get_clause(cls_off);
+                SAT_PS_CODE(m_stats.m_clause_visits++;);
                 TRACE(propagate_clause_bug, tout << "processing... " << c << "\nwas_removed: " << c.was_removed() << "\n";);
                 if (c[0] == not_l)
                     std::swap(c[0], c[1]);
@@ -1173,7 +1155,7 @@ namespace sat {
             }
             case watched::EXT_CONSTRAINT:
                 SASSERT(m_ext);
-                keep = m_ext->propagated(l, it->get_ext_constraint_idx());
+                keep = m_ext->propagated(l, get_ext_constraint_idx(*it));
                 if (m_inconsistent) {
                     if (!keep) {
                         ++it;
@@ -2058,6 +2040,14 @@ namespace sat {
     bool solver::should_simplify() const {
         return m_conflicts_since_init >= m_next_simplify && m_simplify_enabled;
     }
+    /**
+       \brief Inprocessing is delegated to a helper thread only when the
+       imported units and binary clauses need no further justification.
+    */
+    bool solver::use_async_simplifier() const {
+        return m_config.m_inprocess_async && !m_ext && !m_config.m_drat && m_user_scope_literals.empty();
+    }
+
     /**
        \brief Apply all simplifications.
     */
@@ -2087,6 +2077,21 @@ namespace sat {
         report _rprt(*this);
         SASSERT(at_base_lvl());
 
+        // the helper thread runs the equivalence preserving steps on a snapshot,
+        // what it derived is imported first and simplified further below.
+        bool async = use_async_simplifier();
+        bool idle = true;
+        if (async) {
+            if (!m_async_simplifier)
+                m_async_simplifier = alloc(async_simplifier, *this);
+            idle = m_async_simplifier->try_import();
+            if (inconsistent())
+                return;
+        }
+        else if (m_async_simplifier) {
+            m_async_simplifier->cancel();
+        }
+
         m_cleaner(m_config.m_force_cleanup);
         CASSERT("sat_simplify_bug", check_invariant());
 
@@ -2116,16 +2121,24 @@ namespace sat {
             m_ext->simplify();
         }
 
-        m_probing();
-        CASSERT("sat_missed_prop", check_missed_propagation());
-        CASSERT("sat_simplify_bug", check_invariant());
-        m_asymm_branch(false);
+        if (async) {
+            if (idle && !inconsistent())
+                m_async_simplifier->start();
+        }
+        else {
+            m_probing();
+            CASSERT("sat_missed_prop", check_missed_propagation());
+            CASSERT("sat_simplify_bug", check_invariant());
+            m_asymm_branch(false);
 
-        if (m_config.m_lookahead_simplify && !m_ext) {
-            lookahead lh(*this);
-            lh.simplify(true);
-            lh.collect_statistics(m_aux_stats);
+            if (m_config.m_lookahead_simplify && !m_ext) {
+                lookahead lh(*this);
+                lh.simplify(true);
+                lh.collect_statistics(m_aux_stats);
+            }
         }
+        // the simplifiers may hold on to watch lists while propagating
+        invalidate_bin_watches();
 
         reinit_assumptions();
         if (inconsistent()) return;
@@ -2153,6 +2166,12 @@ namespace sat {
             // TBD: throttle anf_delay based on yield
         }        
 
+        if (m_config.m_sim_sweep && !inconsistent()) {
+            sim_sweep sweep(*this, m_config.m_sim_sweep_probes);
+            sweep();
+            sweep.collect_statistics(m_aux_stats);
+        }
+
         if (m_config.m_inprocess_out.is_non_empty_string()) {
             std::ofstream fout(m_config.m_inprocess_out.str());
             if (fout) {
@@ -2174,6 +2193,7 @@ namespace sat {
         for (watch_list & wlist : m_watches) {
             std::stable_sort(wlist.begin(), wlist.end(), watched_lt());
         }
+        invalidate_bin_watches();
     }
 
     void solver::set_model(model const& mdl, bool is_current) {
@@ -3628,6 +3648,7 @@ namespace sat {
             m_probing.reset_cache(literal(w, false));
         }
         m_watches.shrink(2*v);
+        invalidate_bin_watches();
         m_assignment.shrink(2*v);
         m_justification.shrink(v);
         m_decision.shrink(v);
@@ -3740,6 +3761,8 @@ namespace sat {
 
     void solver::user_push() {
         pop_to_base_level();
+        if (m_async_simplifier)
+            m_async_simplifier->cancel();
         m_free_var_freeze.push_back(m_free_vars);
         m_free_vars.reset(); // resetting free_vars forces new variables to be assigned above new_v
         bool_var new_v = mk_var(true, false);
@@ -3759,6 +3782,8 @@ namespace sat {
         m_user_scope_literals.shrink(old_sz);
 
         pop_to_base_level();
+        if (m_async_simplifier)
+            m_async_simplifier->cancel();
         if (m_ext)
             m_ext->user_pop(num_scopes);
     
@@ -3821,6 +3846,7 @@ namespace sat {
         m_scc.collect_statistics(st);
         m_asymm_branch.collect_statistics(st);
         m_probing.collect_statistics(st);
+        if (m_async_simplifier) m_async_simplifier->collect_statistics(st);
         if (m_ext) m_ext->collect_statistics(st);
         if (m_local_search) m_local_search->collect_statistics(st);
         st.copy(m_aux_stats);
@@ -4109,7 +4135,7 @@ namespace sat {
     }
 
     std::ostream& solver::display_watch_list(std::ostream& out, watch_list const& wl) const {
-        return sat::display_watch_list(out, cls_allocator(), wl, m_ext.get());
+        return sat::display_watch_list(out, cls_allocator(), wl, m_ext.get(), &m_ext_watches);
     }
 
     void solver::display_assignment(std::ostream & out) const {
@@ -4791,6 +4817,9 @@ namespace sat {
         st.update("sat propagations 2ary", m_bin_propagate);
         st.update("sat propagations 3ary", m_ter_propagate);
         st.update("sat propagations nary", m_propagate);
+        SAT_PS_CODE(
+            st.update("sat watch visits", static_cast<double>(m_watch_visits));
+            st.update("sat clause visits", static_cast<double>(m_clause_visits)););
         st.update("sat restarts", m_restart);
         st.update("sat minimized lits", m_minimized_lits);
         st.update("sat subs resolution dyn", m_dyn_sub_res);
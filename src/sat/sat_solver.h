@@ -44,8 +44,25 @@ Revision History:
 #include "sat/sat_drat.h"
 #include "sat/sat_parallel.h"
 #include "sat/sat_local_search.h"
+#include "sat/sat_async_simplifier.h"
 #include "sat/sat_solver_core.h"
 
+//  #define SAT_PROPAGATION_STATISTICS
+
+#ifdef SAT_PROPAGATION_STATISTICS
+#define SAT_PS_CODE(CODE) { CODE }
+#else
+#define SAT_PS_CODE(CODE)
+#endif
+
+//  #define SAT_HOT_BINARY_WATCHES
+
+#ifdef SAT_HOT_BINARY_WATCHES
+#define SAT_HBW_CODE(CODE) { CODE }
+#else
+#define SAT_HBW_CODE(CODE)
+#endif
+
 namespace pb {
     class solver;
 }
@@ -77,6 +94,9 @@ namespace sat {
         unsigned m_units;
         unsigned m_backtracks;
         unsigned m_backjumps;
+        // counted only when SAT_PROPAGATION_STATISTICS is defined
+        uint64_t m_watch_visits;     // watch list entries scanned during propagation
+        uint64_t m_clause_visits;    // clauses dereferenced because the blocked literal was not true
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
@@ -123,6 +143,15 @@ namespace sat {
         unsigned                m_num_frozen;
         unsigned_vector         m_active_vars, m_free_vars, m_vars_to_free, m_vars_to_reinit;
         vector<watch_list>      m_watches;
+#ifdef SAT_HOT_BINARY_WATCHES
+        // the binary watches of each literal, copied out of m_watches so that propagate_literal
+        // scans them before the other watches. A copy is rebuilt when its stamp is not the epoch.
+        vector<literal_vector>  m_bin_watches;
+        unsigned_vector         m_bin_watches_stamp;
+        unsigned                m_bin_watches_epoch = 1;
+        literal_vector const& get_bin_watches(literal l);
+#endif
+        ext_watch_table         m_ext_watches;
         svector<lbool>          m_assignment;
         svector<justification>  m_justification; 
         bool_vector             m_decision;
@@ -207,6 +236,9 @@ namespace sat {
 
         statistics              m_aux_stats;        
 
+        scoped_ptr<async_simplifier> m_async_simplifier;
+        bool use_async_simplifier() const;
+
         void del_clauses(clause_vector& clauses);
 
         friend class integrity_checker;
@@ -222,6 +254,8 @@ namespace sat {
         friend class scc;
         friend class pb::solver;
         friend class anf_simplifier;
+        friend class sim_sweep;
+        friend class async_simplifier;
         friend class parallel;
         friend class lookahead;
         friend class local_search;
@@ -463,9 +497,15 @@ namespace sat {
         struct bin_clause_hash { unsigned operator()(bin_clause const& b) const { return b.first.hash() + 2*b.second.hash(); } };
 
         watch_list const& get_wlist(literal l) const { return m_watches[l.index()]; }
-        watch_list& get_wlist(literal l) { return m_watches[l.index()]; }
+        watch_list& get_wlist(literal l) { invalidate_bin_watches(l); return m_watches[l.index()]; }
+        // must be called when binary watches are edited through m_watches
+        void invalidate_bin_watches() { SAT_HBW_CODE(++m_bin_watches_epoch;) }
+        void invalidate_bin_watches(literal l) { SAT_HBW_CODE(if (l.index() < m_bin_watches_stamp.size()) m_bin_watches_stamp[l.index()] = 0;) }
+        watched mk_ext_watch(ext_constraint_idx idx) { return m_ext_watches.mk_watch(idx); }
+        bool find_ext_watch(ext_constraint_idx idx, watched& w) const { return m_ext_watches.find_watch(idx, w); }
+        ext_constraint_idx get_ext_constraint_idx(watched const& w) const { return m_ext_watches[w]; }
     protected:            
-        watch_list & get_wlist(unsigned l_idx) { return m_watches[l_idx]; }
+        watch_list & get_wlist(unsigned l_idx) { invalidate_bin_watches(to_literal(l_idx)); return m_watches[l_idx]; }
         bool is_marked(bool_var v) const { return m_mark[v]; }
         void mark(bool_var v) { SASSERT(!is_marked(v)); m_mark[v] = true; }
         void reset_mark(bool_var v) { SASSERT(is_marked(v)); m_mark[v] = false; }
@@ -483,6 +523,11 @@ namespace sat {
         // if update == true, then glue of learned clauses is updated.
         bool propagate(bool update);
 
+        // assign l at a new decision level, propagate and backtrack.
+        // Returns false if propagation produced a conflict.
+        // num_assigned is set to the number of literals assigned, including l.
+        bool probe_literal(literal l, unsigned& num_assigned);
+
     protected:
         bool should_propagate() const;
         bool propagate_core(bool update);
@@ -79,7 +79,7 @@ namespace sat {
     }
 
 
-    std::ostream& display_watch_list(std::ostream & out, clause_allocator const & ca, watch_list const & wlist, extension* ext) {
+    std::ostream& display_watch_list(std::ostream & out, clause_allocator const & ca, watch_list const & wlist, extension* ext, ext_watch_table const* ext_watches) {
         bool first = true;
         for (watched const& w : wlist) {
             if (first)
@@ -96,11 +96,11 @@ namespace sat {
                 out << "(" << w.get_blocked_literal() << " " << *(ca.get_clause(w.get_clause_offset())) << ")";
                 break;
             case watched::EXT_CONSTRAINT:
-                if (ext) {
-                    ext->display_constraint(out, w.get_ext_constraint_idx());
+                if (ext && ext_watches) {
+                    ext->display_constraint(out, (*ext_watches)[w]);
                 }
                 else  {
-                    out << "ext: " << w.get_ext_constraint_idx();
+                    out << "ext: " << w.get_ext_handle();
                 }
                 break;
             }
@@ -20,6 +20,7 @@ Revision History:
 
 #include "sat/sat_types.h"
 #include "util/vector.h"
+#include "util/map.h"
 
 namespace sat {
     /**
@@ -28,9 +29,12 @@ namespace sat {
        1) A literal:               for watched binary clauses
        2) A pair of literals:      for watched ternary clauses
        3) A pair (literal, clause-offset): for watched clauses, where the first element of the pair is a literal of the clause.
-       4) A external constraint-idx: for external constraints.
+       4) A external constraint handle: for external constraints.
 
        For binary clauses: we use a bit to store whether the binary clause was learned or not.
+
+       Watch entries are 8 bytes. External constraint indices are pointer sized, so
+       the entries store 32-bit handles that ext_watch_table maps back to the indices.
        
        Remark: there are no clause objects for binary clauses.
     */
@@ -43,7 +47,7 @@ namespace sat {
             BINARY = 0, CLAUSE, EXT_CONSTRAINT
         };
     private:
-        size_t   m_val1;
+        unsigned m_val1;
         unsigned m_val2; 
     public:
         watched(literal l, bool learned):
@@ -66,11 +70,11 @@ namespace sat {
             SASSERT(get_clause_offset() == cls_off);
         }
 
-        explicit watched(ext_constraint_idx cnstr_idx):
-            m_val1(cnstr_idx),
+        explicit watched(unsigned ext_handle):
+            m_val1(ext_handle),
             m_val2(static_cast<unsigned>(EXT_CONSTRAINT)) {
             SASSERT(is_ext_constraint());
-            SASSERT(get_ext_constraint_idx() == cnstr_idx);
+            SASSERT(get_ext_handle() == ext_handle);
         }
 
         kind get_kind() const { return static_cast<kind>(m_val2 & 3); }
@@ -97,12 +101,13 @@ namespace sat {
         }
 
         bool is_ext_constraint() const { return get_kind() == EXT_CONSTRAINT; }
-        ext_constraint_idx get_ext_constraint_idx() const { SASSERT(is_ext_constraint()); return m_val1; }
+        unsigned get_ext_handle() const { SASSERT(is_ext_constraint()); return m_val1; }
         
         bool operator==(watched const & w) const { return m_val1 == w.m_val1 && m_val2 == w.m_val2; }
         bool operator!=(watched const & w) const { return !operator==(w); }
     };
 
+    static_assert(sizeof(watched) == 8, "watch entries are packed into 8 bytes");
     static_assert(0 <= watched::BINARY && watched::BINARY <= 2, "");
     static_assert(0 <= watched::CLAUSE && watched::CLAUSE <= 2, "");
     static_assert(0 <= watched::EXT_CONSTRAINT && watched::EXT_CONSTRAINT <= 2, "");
@@ -117,12 +122,39 @@ namespace sat {
 
     typedef vector<watched> watch_list;
 
+    /**
+       \brief Handles of the external constraints that occur in watch lists.
+       A constraint keeps its handle for the lifetime of the table.
+    */
+    class ext_watch_table {
+        svector<ext_constraint_idx> m_idx;
+        size_t_map<unsigned>        m_handle;
+    public:
+        watched mk_watch(ext_constraint_idx idx) {
+            unsigned h;
+            if (!m_handle.find(idx, h)) {
+                h = m_idx.size();
+                m_idx.push_back(idx);
+                m_handle.insert(idx, h);
+            }
+            return watched(h);
+        }
+        bool find_watch(ext_constraint_idx idx, watched& w) const {
+            unsigned h;
+            if (!m_handle.find(idx, h))
+                return false;
+            w = watched(h);
+            return true;
+        }
+        ext_constraint_idx operator[](watched const& w) const { return m_idx[w.get_ext_handle()]; }
+    };
+
     watched* find_binary_watch(watch_list & wlist, literal l);
     watched const* find_binary_watch(watch_list const & wlist, literal l);
     bool erase_clause_watch(watch_list & wlist, clause_offset c);
 
     class clause_allocator;
-    std::ostream& display_watch_list(std::ostream & out, clause_allocator const & ca, watch_list const & wlist, extension* ext);
+    std::ostream& display_watch_list(std::ostream & out, clause_allocator const & ca, watch_list const & wlist, extension* ext, ext_watch_table const* ext_watches);
 
     void conflict_cleanup(watch_list::iterator it, watch_list::iterator it2, watch_list& wlist);
 }
@@ -32,6 +32,13 @@ namespace bv {
         switch (to_app(e)->get_decl_kind()) {
         case OP_BMUL:
             return check_mul(to_app(e));
+        case OP_BUDIV_I:
+        case OP_BUREM_I:
+            return check_udiv_urem(to_app(e));
+        case OP_BSHL:
+        case OP_BLSHR:
+        case OP_BASHR:
+            return check_shift(to_app(e));
         case OP_BSMUL_NO_OVFL:
         case OP_BSMUL_NO_UDFL:
         case OP_BUMUL_NO_OVFL:
@@ -141,6 +148,10 @@ namespace bv {
         if (!check_mul_one(e, args, r1, r2))
             return false;
 
+        // check that the product of odd numbers is odd
+        if (!check_mul_parity(e, args, r1))
+            return false;
+
         // Add propagation axiom for arguments
         if (!check_mul_invertibility(e, args, r1))
             return false;
@@ -170,8 +181,156 @@ namespace bv {
         if (m_cheap_axioms)
             return true;
 
+        blast_delayed(e);
+        return false;
+    }
+
+    void solver::blast_delayed(app* e) {
+        m_delay_blasted.insert(e);
         set_delay_internalize(e, internalize_mode::no_delay_i);
         internalize_circuit(e);
+    }
+
+    sat::literal solver::delayed_bit(expr* e, unsigned i) {
+        return m_bits[expr2enode(e)->get_th_var(get_id())][i];
+    }
+
+    /**
+     * The least significant bit of a product is the conjunction of the
+     * least significant bits of the factors.
+     */
+    bool solver::check_mul_parity(app* n, expr_ref_vector const& arg_values, expr* value) {
+        rational v;
+        for (expr* arg : arg_values) {
+            VERIFY(bv.is_numeral(arg, v));
+            if (v.is_even())
+                return true;
+        }
+        VERIFY(bv.is_numeral(value, v));
+        if (v.is_odd())
+            return true;
+        sat::literal_vector lits;
+        for (expr* arg : *n)
+            lits.push_back(~delayed_bit(arg, 0));
+        lits.push_back(delayed_bit(n, 0));
+        add_clause(lits);
+        ++m_stats.m_num_delay_lemmas;
+        return false;
+    }
+
+    /**
+     * Word-level axioms for unsigned division and remainder,
+     * added when the current values violate them:
+     *
+     *   y = 0 => x udiv y = ~0,     y != 0 => x udiv y <= x
+     *   y = 0 => x urem y = x,      x urem y <= x,    y != 0 => x urem y < y
+     *
+     * The circuit is bit-blasted if the values satisfy the axioms but
+     * not the operation.
+     */
+    bool solver::check_udiv_urem(app* e) {
+        euf::enode* n = expr2enode(e);
+        expr_ref_vector args(m);
+        auto r1 = eval_bv(n);
+        auto r2 = eval_args(n, args);
+        if (r1 == r2)
+            return true;
+        rational x, y, z;
+        unsigned sz;
+        VERIFY(bv.is_numeral(args.get(0), x, sz));
+        VERIFY(bv.is_numeral(args.get(1), y));
+        VERIFY(bv.is_numeral(r1, z));
+        expr* a = e->get_arg(0), *b = e->get_arg(1);
+        bool is_div = bv.is_bv_udivi(e);
+        unsigned num_lemmas = m_stats.m_num_delay_lemmas;
+        sat::literal b_is_zero = eq_internalize(b, bv.mk_zero(sz));
+        if (y.is_zero()) {
+            // r2 is ~0 or x, and differs from z
+            expr_ref v(is_div ? bv.mk_numeral(rational::power_of_two(sz) - 1, sz) : a, m);
+            add_clause(~b_is_zero, eq_internalize(e, v));
+            ++m_stats.m_num_delay_lemmas;
+        }
+        else {
+            if (z > x) {
+                sat::literal le = mk_literal(bv.mk_ule(e, a));
+                if (is_div)
+                    add_clause(b_is_zero, le);
+                else
+                    add_unit(le);
+                ++m_stats.m_num_delay_lemmas;
+            }
+            if (!is_div && z >= y) {
+                add_clause(b_is_zero, ~mk_literal(bv.mk_ule(b, e)));
+                ++m_stats.m_num_delay_lemmas;
+            }
+        }
+        if (num_lemmas != m_stats.m_num_delay_lemmas)
+            return false;
+        if (m_cheap_axioms)
+            return true;
+        blast_delayed(e);
+        return false;
+    }
+
+    /**
+     * Word-level axioms for shifts, added when the current values violate them:
+     *
+     *   y = 0 => x op y = x
+     *   y >= sz => x << y = 0, x >>u y = 0
+     *   y > i => bit i of x << y is 0
+     *   x >>u y <= x
+     *   the sign bit of x >>s y is the sign bit of x
+     */
+    bool solver::check_shift(app* e) {
+        euf::enode* n = expr2enode(e);
+        expr_ref_vector args(m);
+        auto r1 = eval_bv(n);
+        auto r2 = eval_args(n, args);
+        if (r1 == r2)
+            return true;
+        rational x, y, z;
+        unsigned sz;
+        VERIFY(bv.is_numeral(args.get(0), x, sz));
+        VERIFY(bv.is_numeral(args.get(1), y));
+        VERIFY(bv.is_numeral(r1, z));
+        expr* a = e->get_arg(0), *b = e->get_arg(1);
+        unsigned num_lemmas = m_stats.m_num_delay_lemmas;
+        if (y.is_zero()) {
+            add_clause(~eq_internalize(b, bv.mk_zero(sz)), eq_internalize(e, a));
+            ++m_stats.m_num_delay_lemmas;
+        }
+        else if (bv.is_bv_ashr(e)) {
+            if (x.get_bit(sz - 1) != z.get_bit(sz - 1)) {
+                add_equiv(delayed_bit(a, sz - 1), delayed_bit(e, sz - 1));
+                ++m_stats.m_num_delay_lemmas;
+            }
+        }
+        else if (y >= sz) {
+            add_clause(~mk_literal(bv.mk_ule(bv.mk_numeral(rational(sz), sz), b)), eq_internalize(e, bv.mk_zero(sz)));
+            ++m_stats.m_num_delay_lemmas;
+        }
+        else if (bv.is_bv_lshr(e)) {
+            if (z > x) {
+                add_unit(mk_literal(bv.mk_ule(e, a)));
+                ++m_stats.m_num_delay_lemmas;
+            }
+        }
+        else {
+            unsigned shift = y.get_unsigned();
+            for (unsigned i = 0; i < shift; ++i) {
+                if (z.get_bit(i)) {
+                    // b <= i or not bit i
+                    add_clause(mk_literal(bv.mk_ule(b, bv.mk_numeral(rational(i), sz))), ~delayed_bit(e, i));
+                    ++m_stats.m_num_delay_lemmas;
+                    break;
+                }
+            }
+        }
+        if (num_lemmas != m_stats.m_num_delay_lemmas)
+            return false;
+        if (m_cheap_axioms)
+            return true;
+        blast_delayed(e);
         return false;
     }
 
@@ -379,8 +538,7 @@ namespace bv {
             return true;
         if (m_cheap_axioms)
             return true;
-        set_delay_internalize(a, internalize_mode::no_delay_i);
-        internalize_circuit(a);
+        blast_delayed(a);
         return false;
     }
 
@@ -397,8 +555,7 @@ namespace bv {
             return false;
         if (m_cheap_axioms)
             return true;
-        set_delay_internalize(a, internalize_mode::no_delay_i);
-        internalize_circuit(a);
+        blast_delayed(a);
         return false;
     }
 
@@ -429,11 +586,16 @@ namespace bv {
         case OP_BUDIV_I:
         case OP_BSDIV_I: 
         case OP_BADD:
+        case OP_BSHL:
+        case OP_BLSHR:
+        case OP_BASHR:
             if (should_bit_blast(to_app(e)))
                 return internalize_mode::no_delay_i;
             mode = internalize_mode::delay_i;
-            if (!m_delay_internalize.find(e, mode))
+            if (!m_delay_internalize.find(e, mode)) {
                 m_delay_internalize.insert(e, mode);
+                ++m_stats.m_num_delayed;
+            }
             return mode;        
         default:
             return internalize_mode::no_delay_i;
@@ -788,6 +788,15 @@ namespace bv {
         st.update("bv bit2eq", m_stats.m_num_bit2eq);
         st.update("bv bit2ne", m_stats.m_num_bit2ne);
         st.update("bv ackerman", m_stats.m_ackerman);
+        if (m_stats.m_num_delayed > 0) {
+            // a term that is bit-blasted above the base level reverts to delayed on pop,
+            // so blasted terms are counted from m_delay_blasted and not from the modes.
+            unsigned num_blasted = m_delay_blasted.size();
+            st.update("bv delayed", m_stats.m_num_delayed);
+            st.update("bv delayed lemmas", m_stats.m_num_delay_lemmas);
+            st.update("bv delayed blasted", num_blasted);
+            st.update("bv delayed never blasted", m_stats.m_num_delayed - std::min(num_blasted, m_stats.m_num_delayed));
+        }
     }
 
     sat::extension* solver::copy(sat::solver* s) { UNREACHABLE(); return nullptr; }
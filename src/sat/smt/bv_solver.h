@@ -59,6 +59,7 @@ namespace bv {
             unsigned   m_num_diseq_static, m_num_diseq_dynamic,  m_num_conflicts;
             unsigned   m_num_bit2eq, m_num_bit2ne, m_num_eq2bit, m_num_ne2bit;
             unsigned   m_ackerman;
+            unsigned   m_num_delayed, m_num_delay_lemmas;
             void reset() { memset(this, 0, sizeof(stats)); }
             stats() { reset(); }
         };
@@ -304,6 +305,7 @@ namespace bv {
         };
 
         obj_map<expr, internalize_mode> m_delay_internalize;
+        obj_hashtable<expr> m_delay_blasted;  // delayed terms that were bit-blasted, not restored on pop
         bool m_cheap_axioms{ true };
         bool should_bit_blast(app * n);
         bool check_delay_internalized(expr* e);
@@ -312,6 +314,11 @@ namespace bv {
         bool check_mul_invertibility(app* n, expr_ref_vector const& arg_values, expr* value);
         bool check_mul_zero(app* n, expr_ref_vector const& arg_values, expr* value1, expr* value2);
         bool check_mul_one(app* n, expr_ref_vector const& arg_values, expr* value1, expr* value2);
+        bool check_mul_parity(app* n, expr_ref_vector const& arg_values, expr* value);
+        bool check_udiv_urem(app* e);
+        bool check_shift(app* e);
+        void blast_delayed(app* e);
+        sat::literal delayed_bit(expr* e, unsigned i);
         bool check_umul_no_overflow(app* n, expr_ref_vector const& arg_values, expr* value);
         bool check_bv_eval(euf::enode* n);
         bool check_bool_eval(euf::enode* n);
@@ -37,8 +37,12 @@ namespace euf {
             !m_config.m_proof_log.is_non_empty_string())
             return;
         
-        if (m_config.m_proof_log.is_non_empty_string())
-            m_proof_out = alloc(std::ofstream, m_config.m_proof_log.str(), std::ios_base::out);
+        if (m_config.m_proof_log.is_non_empty_string()) {
+            bool binary = m_config.m_proof_log_binary;
+            m_proof_out = alloc(std::ofstream, m_config.m_proof_log.str(), binary ? std::ios_base::out | std::ios_base::binary : std::ios_base::out);
+            if (binary)
+                m_proof_binary = alloc(proof_log_binary_writer, m, *m_proof_out);
+        }
         get_drat().set_clause_eh(*this);
         m_proof_initialized = true;        
     }
@@ -388,6 +392,10 @@ namespace euf {
     void solver::on_proof(unsigned n, literal const* lits, sat::status st) {
         if (!m_proof_out)
             return;
+        if (m_proof_binary) {
+            on_proof_binary(n, lits, st);
+            return;
+        }
         flet<bool> _display_all_decls(m_display_all_decls, true);
         std::ostream& out = *m_proof_out;
         if (!visit_clause(out, n, lits))
@@ -405,6 +413,30 @@ namespace euf {
         out.flush();
     }
 
+    /**
+       \brief Append a record to the binary log, in the format written by the
+       SMT core. Literals without a term are named by their variable, as in
+       the text log.
+    */
+    void solver::on_proof_binary(unsigned n, literal const* lits, sat::status st) {
+        proof_log_record r = proof_log_record::infer;
+        if (st.is_deleted())
+            r = proof_log_record::del;
+        else if (st.is_input())
+            r = proof_log_record::assume;
+        m_clause.reset();
+        for (unsigned i = 0; i < n; ++i) {
+            expr* e = bool_var2expr(lits[i].var());
+            if (!e)
+                e = m.mk_const(symbol(lits[i].var()), m.mk_bool_sort());
+            m_clause.push_back(lits[i].sign() ? mk_not(m, e) : e);
+        }
+        app_ref hint(m);
+        if (r == proof_log_record::infer)
+            hint = status2proof_hint(st);
+        m_proof_binary->log(r, m_clause.size(), m_clause.data(), hint);
+    }
+
     void solver::on_check(unsigned n, literal const* lits, sat::status st) {
         if (!s().get_config().m_smt_proof_check)
             return;
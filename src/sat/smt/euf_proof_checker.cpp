@@ -19,6 +19,7 @@ Author:
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
 #include "ast/ast_ll_pp.h"
+#include "ast/proof_log_binary.h"
 #include "ast/arith_decl_plugin.h"
 #include "smt/smt_solver.h"
 #include "params/sat_params.hpp"
@@ -527,6 +528,38 @@ namespace euf {
         }
     }
 
+    void smt_proof_checker::replay(std::istream& in, replay_stats& st) {
+        proof_log_binary_reader reader(m, in);
+        proof_log_record kind;
+        expr_ref_vector clause(m);
+        expr_ref hint(m);
+        while (reader.next(kind, clause, hint)) {
+            switch (kind) {
+            case proof_log_record::assume:
+                assume(clause);
+                ++st.m_num_assumptions;
+                break;
+            case proof_log_record::infer:
+                if (hint && !is_app(hint))
+                    throw default_exception("proof hint should be an application");
+                infer(clause, hint ? to_app(hint) : nullptr);
+                ++st.m_num_inferences;
+                break;
+            case proof_log_record::del:
+                del(clause);
+                ++st.m_num_deleted;
+                break;
+            }
+        }
+    }
+
+    unsigned smt_proof_checker::num_verified_hints() const {
+        unsigned n = 0;
+        for (auto const& [k, v] : m_hint2hit)
+            n += v;
+        return n;
+    }
+
     void smt_proof_checker::collect_statistics(statistics& st) const {
         if (m_solver)
             m_solver->collect_statistics(st);
@@ -155,6 +155,20 @@ namespace euf {
         
         void infer(expr_ref_vector& clause, app* proof_hint);
 
+        struct replay_stats {
+            unsigned m_num_assumptions = 0;
+            unsigned m_num_inferences = 0;
+            unsigned m_num_deleted = 0;
+        };
+
+        /**
+           \brief Check the records of a binary clause proof log, as written
+           with solver.proof.log_binary=true.
+        */
+        void replay(std::istream& in, replay_stats& st);
+
+        unsigned num_verified_hints() const;
+
         void collect_statistics(statistics& st) const;
         
     };
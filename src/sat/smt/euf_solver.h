@@ -20,6 +20,7 @@ Author:
 #include "util/trail.h"
 #include "ast/ast_translation.h"
 #include "ast/ast_util.h"
+#include "ast/proof_log_binary.h"
 #include "ast/euf/euf_egraph.h"
 #include "ast/euf/euf_mam.h"
 #include "ast/rewriter/th_rewriter.h"
@@ -234,6 +235,7 @@ namespace euf {
         void on_clause(unsigned n, literal const* lits, sat::status st) override;
         void on_lemma(unsigned n, literal const* lits, sat::status st);
         void on_proof(unsigned n, literal const* lits, sat::status st);
+        void on_proof_binary(unsigned n, literal const* lits, sat::status st);
         void on_check(unsigned n, literal const* lits, sat::status st);
         void on_clause_eh(unsigned n, literal const* lits, sat::status st);
         std::ostream& display_literals(std::ostream& out, unsigned n, sat::literal const* lits);
@@ -445,6 +447,7 @@ namespace euf {
         sat::status mk_distinct_status(unsigned n, sat::literal const* lits);
 
         scoped_ptr<std::ostream> m_proof_out;
+        scoped_ptr<proof_log_binary_writer> m_proof_binary;
 
         // decompile
         bool extract_pb(std::function<void(unsigned sz, literal const* c, unsigned k)>& card,
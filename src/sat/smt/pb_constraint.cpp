@@ -31,11 +31,12 @@ namespace pb {
     }
 
     bool constraint::is_watched(solver_interface const& s, literal lit) const {
-        return s.get_wlist(~lit).contains(sat::watched(cindex()));
+        sat::watched w(0u);
+        return s.find_ext_watch(cindex(), w) && s.get_wlist(~lit).contains(w);
     }
 
     void constraint::unwatch_literal(solver_interface& s, literal lit) {
-        sat::watched w(cindex());
+        sat::watched w = s.mk_ext_watch(cindex());
         s.get_wlist(~lit).erase(w);
         SASSERT(!is_watched(s, lit));
     }
@@ -43,7 +44,7 @@ namespace pb {
     void constraint::watch_literal(solver_interface& s, literal lit) {
         if (is_pure() && lit == ~this->lit()) return;
         SASSERT(!is_watched(s, lit));
-        sat::watched w(cindex());
+        sat::watched w = s.mk_ext_watch(cindex());
         s.get_wlist(~lit).push_back(w);
     }
 
@@ -1771,7 +1771,7 @@ namespace pb {
         if (lvl(lit) == 0) return true;
         for (auto const & w : get_wlist(lit)) {
             if (w.get_kind() == sat::watched::EXT_CONSTRAINT) {
-                constraint const& c = index2constraint(w.get_ext_constraint_idx());
+                constraint const& c = index2constraint(m_solver->get_ext_constraint_idx(w));
                 if (!c.is_watching(~lit) && lit.var() != c.lit().var()) {
                     IF_VERBOSE(0, display(verbose_stream() << lit << " " << lvl(lit) << " is not watched in " << c << "\n", c, true););
                     UNREACHABLE();
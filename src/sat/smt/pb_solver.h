@@ -275,6 +275,8 @@ namespace pb {
         }
         inline sat::watch_list& get_wlist(literal l) override { return m_lookahead ? m_lookahead->get_wlist(l) : m_solver->get_wlist(l); }
         inline sat:: watch_list const& get_wlist(literal l) const override { return m_lookahead ? m_lookahead->get_wlist(l) : m_solver->get_wlist(l); }
+        inline sat::watched mk_ext_watch(sat::ext_constraint_idx idx) override { return m_lookahead ? m_lookahead->mk_ext_watch(idx) : m_solver->mk_ext_watch(idx); }
+        inline bool find_ext_watch(sat::ext_constraint_idx idx, sat::watched& w) const override { return m_lookahead ? m_lookahead->find_ext_watch(idx, w) : m_solver->find_ext_watch(idx, w); }
         inline void assign(literal l, sat::justification j) override { 
             if (m_lookahead) m_lookahead->assign(l); 
             else m_solver->assign(l, j);
@@ -44,6 +44,8 @@ namespace pb {
         virtual bool inconsistent() const = 0;
         virtual sat::watch_list& get_wlist(literal l) = 0;
         virtual sat::watch_list const& get_wlist(literal l) const = 0;
+        virtual sat::watched mk_ext_watch(sat::ext_constraint_idx idx) = 0;
+        virtual bool find_ext_watch(sat::ext_constraint_idx idx, sat::watched& w) const = 0;
         virtual void assign(literal l, sat::justification j) = 0; 
         virtual void set_conflict(sat::justification j, literal l) = 0;
         virtual sat::config const& get_config() const = 0;
@@ -7,11 +7,15 @@ Copyright (c) 2020 Microsoft Corporation
 #include<fstream>
 #include "util/memory_manager.h"
 #include "util/statistics.h"
+#include "util/stopwatch.h"
+#include "util/gparams.h"
 #include "ast/proofs/proof_checker.h"
 #include "ast/reg_decl_plugins.h"
 #include "sat/dimacs.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_drat.h"
+#include "sat/sat_proof_trim.h"
+#include "params/sat_params.hpp"
 #include "shell/drat_frontend.h"
 
 
@@ -64,6 +68,52 @@ public:
     }
 };
 
+/**
+ * Backward checking: replay the proof to the empty clause, trim it to the
+ * lemmas needed for the conflict and verify those lemmas.
+ * Input clauses are numbered 1, 2, ... in the order they occur, as in the CNF,
+ * so that the trimmed proof can be written in LRAT format. Theory axioms and
+ * theory lemmas are treated as input clauses.
+ * With several threads the lemmas are replayed forwards in parallel and the
+ * core is marked from their dependencies.
+ */
+static unsigned check_drat_backward(dimacs::drat_parser& drat, symbol const& lrat_file, unsigned num_threads) {
+    params_ref p;
+    reslimit lim;
+    sat::proof_trim trim(p, lim);
+    unsigned num_inputs = 0, num_lemmas = 0;
+    stopwatch sw;
+    sw.start();
+
+    if (!trim.read_drat(drat, num_inputs, num_lemmas)) {
+        std::cout << "proof does not derive the empty clause\n";
+        return 1;
+    }
+    auto proof = num_threads > 1 ? trim.trim(num_threads) : trim.trim();
+    double trim_time = sw.get_current_seconds();
+    unsigned num_failed = trim.check(proof);
+    sw.stop();
+    std::cout << "(drat-check :lemmas " << num_lemmas
+              << " :core " << proof.size()
+              << " :failed " << num_failed
+              << " :trim-time " << trim_time
+              << " :check-time " << sw.get_seconds() - trim_time << ")\n";
+    if (num_failed > 0) {
+        std::cout << "did not verify\n";
+        return 1;
+    }
+    std::cout << "verified\n";
+    if (lrat_file.is_non_empty_string()) {
+        std::ofstream out(lrat_file.str());
+        if (!out) {
+            std::cerr << "could not open file " << lrat_file << "\n";
+            return 1;
+        }
+        trim.display_lrat(out, proof, num_inputs);
+    }
+    return 0;
+}
+
 unsigned read_drat(char const* drat_file) {
     ast_manager m;
     reg_decl_plugins(m);
@@ -77,6 +127,11 @@ unsigned read_drat(char const* drat_file) {
         return m.get_family_name(th);
     };
     drat.set_read_theory(read_theory);
+
+    sat_params sp(gparams::get_module("sat"));
+    if (sp.drat_trim() || sp.drat_lrat().is_non_empty_string())
+        return check_drat_backward(drat, sp.drat_lrat(), sp.drat_trim_threads());
+
     params_ref p;
     reslimit lim;
     sat::solver solver(p, lim);
@@ -39,12 +39,13 @@ Revision History:
 #include "util/env_params.h"
 #include "util/file_path.h"
 #include "shell/drat_frontend.h"
+#include "shell/proof_frontend.h"
 
 #if defined( _WINDOWS ) && defined( __MINGW32__ ) && ( defined( __GNUG__ ) || defined( __clang__ ) )
 #include <crtdbg.h>
 #endif
 
-typedef enum { IN_UNSPECIFIED, IN_SMTLIB_2, IN_DATALOG, IN_DIMACS, IN_WCNF, IN_OPB, IN_LP, IN_Z3_LOG, IN_DRAT, IN_TPTP } input_kind;
+typedef enum { IN_UNSPECIFIED, IN_SMTLIB_2, IN_DATALOG, IN_DIMACS, IN_WCNF, IN_OPB, IN_LP, IN_Z3_LOG, IN_DRAT, IN_TPTP, IN_PROOF } input_kind;
 
 static char const * g_input_file          = nullptr;
 static char const * g_drat_input_file     = nullptr;
@@ -347,7 +348,8 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
                             strcmp(ext, "dimacs") == 0 || strcmp(ext, "cnf") == 0 ||
                             strcmp(ext, "wcnf") == 0 || strcmp(ext, "opb") == 0 ||
                             strcmp(ext, "lp") == 0 || strcmp(ext, "log") == 0 ||
-                            strcmp(ext, "drat") == 0 || strcmp(ext, "p") == 0))
+                            strcmp(ext, "drat") == 0 || strcmp(ext, "p") == 0 ||
+                            strcmp(ext, "zproof") == 0))
                     is_filepath = true;
             }
             if (is_filepath) {
@@ -429,6 +431,9 @@ int STD_CALL main(int argc, char ** argv) {
                 else if (is_tptp_extension(ext)) {
                     g_input_kind = IN_TPTP;
                 }
+                else if (strcmp(ext, "zproof") == 0) {
+                    g_input_kind = IN_PROOF;
+                }
             }
         }
         switch (g_input_kind) {
@@ -460,6 +465,9 @@ int STD_CALL main(int argc, char ** argv) {
         case IN_TPTP:
             return_value = read_tptp(g_input_file);
             break;
+        case IN_PROOF:
+            return_value = read_proof_log(g_input_file);
+            break;
         default:
             UNREACHABLE();
         }
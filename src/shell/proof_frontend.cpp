@@ -0,0 +1,51 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    proof_frontend.cpp
+
+Abstract:
+
+    Offline checker for binary clause proof logs, as written by the
+    SMT core with solver.proof.log_binary=true.
+
+    The records are replayed through the same checker that validates
+    the (assume ...), (infer ...) and (del ...) commands of text logs.
+
+--*/
+
+#include<iostream>
+#include<fstream>
+#include "util/error_codes.h"
+#include "util/gparams.h"
+#include "util/statistics.h"
+#include "ast/reg_decl_plugins.h"
+#include "sat/smt/euf_proof_checker.h"
+#include "shell/proof_frontend.h"
+
+extern bool g_display_statistics;
+
+unsigned read_proof_log(char const* proof_file) {
+    std::ifstream in(proof_file, std::ios::in | std::ios::binary);
+    if (!in) {
+        std::cerr << "(error \"failed to open file '" << proof_file << "'\")\n";
+        return ERR_OPEN_FILE;
+    }
+
+    ast_manager m;
+    reg_decl_plugins(m);
+    euf::smt_proof_checker checker(m, gparams::get_module("solver"));
+    euf::smt_proof_checker::replay_stats rs;
+    checker.replay(in, rs);
+
+    std::cout << "(proof-log :assumptions " << rs.m_num_assumptions
+              << " :inferences " << rs.m_num_inferences
+              << " :deleted " << rs.m_num_deleted << ")\n";
+    if (g_display_statistics) {
+        statistics st;
+        checker.collect_statistics(st);
+        st.display_smt2(std::cout);
+    }
+    return 0;
+}
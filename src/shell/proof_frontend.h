@@ -0,0 +1,7 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+--*/
+#pragma once
+
+unsigned read_proof_log(char const * proof_file);
+
@@ -165,4 +165,80 @@ namespace smt {
 #endif
 
     
+    instance_cache::instance_cache(ast_manager & m):
+        m(m),
+        m_pinned(m),
+        m_table(DEFAULT_HASHTABLE_INITIAL_CAPACITY, entry_hash(*this), entry_eq(*this)) {
+    }
+
+    bool instance_cache::entry_eq::operator()(int i, int j) const {
+        entry const & e1 = m_cache.m_entries[i];
+        entry const & e2 = m_cache.m_entries[j];
+        if (e1.m_q != e2.m_q)
+            return false;
+        expr * const * b1 = m_cache.get_bindings(e1);
+        expr * const * b2 = m_cache.get_bindings(e2);
+        for (unsigned k = 0, n = e1.m_q->get_num_decls(); k < n; ++k)
+            if (b1[k] != b2[k])
+                return false;
+        return true;
+    }
+
+    bool instance_cache::insert(quantifier * q, fingerprint const & f, unsigned generation) {
+        SASSERT(f.get_num_args() == q->get_num_decls());
+        unsigned offset = m_pinned.size();
+        unsigned h = q->get_id();
+        m_pinned.push_back(q);
+        for (enode * n : f) {
+            m_pinned.push_back(n->get_expr());
+            h = combine_hash(h, n->get_expr_id());
+        }
+        int idx = m_entries.size();
+        m_entries.push_back({ q, offset + 1, generation, h, 0 });
+        int other = m_table.insert_if_not_there(idx);
+        if (other == idx) {
+            m_num_misses++;
+            return false;
+        }
+        m_entries.pop_back();
+        m_pinned.shrink(offset);
+        m_entries[other].m_hits++;
+        m_num_hits++;
+        return true;
+    }
+
+    void instance_cache::compact(std::function<bool(quantifier *)> const & is_live) {
+        svector<entry> old_entries;
+        expr_ref_vector old_pinned(m);
+        old_entries.swap(m_entries);
+        old_pinned.swap(m_pinned);
+        m_table.reset();
+        for (entry const & e : old_entries) {
+            if (e.m_hits == 0 || !is_live(e.m_q)) {
+                m_num_evictions++;
+                continue;
+            }
+            unsigned offset = m_pinned.size();
+            m_pinned.push_back(e.m_q);
+            for (unsigned k = 0, n = e.m_q->get_num_decls(); k < n; ++k)
+                m_pinned.push_back(old_pinned.get(e.m_bindings_offset + k));
+            int idx = m_entries.size();
+            m_entries.push_back({ e.m_q, offset + 1, e.m_generation, e.m_hash, e.m_hits });
+            m_table.insert(idx);
+        }
+    }
+
+    void instance_cache::reset() {
+        m_num_evictions += m_entries.size();
+        m_entries.reset();
+        m_table.reset();
+        m_pinned.reset();
+    }
+
+    void instance_cache::collect_statistics(::statistics & st) const {
+        st.update("quant cache hits", m_num_hits);
+        st.update("quant cache misses", m_num_misses);
+        st.update("quant cache replays", m_num_replays);
+        st.update("quant cache evictions", m_num_evictions);
+    }
 }
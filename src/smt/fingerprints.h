@@ -20,6 +20,8 @@ Revision History:
 
 #include "smt/smt_enode.h"
 #include "util/util.h"
+#include "util/statistics.h"
+#include <functional>
 
 namespace smt {
 
@@ -76,6 +78,73 @@ namespace smt {
         bool slow_contains(void const * data, unsigned data_hash, unsigned num_args, enode * const * args) const;
 #endif
     };
+
+    /**
+       \brief Quantifier instances keyed by the quantifier and the terms of
+       the binding, which are the roots of the fingerprint of the instance.
+
+       Unlike fingerprint_set, the cache is not part of the backtracking
+       trail: the terms are pinned and the entries survive pop. An entry
+       counts how often the same instance was created again after it was
+       removed by backtracking, which lets the quantifier manager re-assert
+       instances that keep coming back without waiting for E-matching.
+    */
+    class instance_cache {
+    public:
+        struct entry {
+            quantifier * m_q;
+            unsigned     m_bindings_offset;
+            unsigned     m_generation;
+            unsigned     m_hash;
+            unsigned     m_hits;
+        };
+
+    private:
+        struct entry_hash {
+            instance_cache & m_cache;
+            entry_hash(instance_cache & c): m_cache(c) {}
+            unsigned operator()(int i) const { return m_cache.m_entries[i].m_hash; }
+        };
+
+        struct entry_eq {
+            instance_cache & m_cache;
+            entry_eq(instance_cache & c): m_cache(c) {}
+            bool operator()(int i, int j) const;
+        };
+
+        ast_manager &                         m;
+        expr_ref_vector                       m_pinned;
+        svector<entry>                        m_entries;
+        int_hashtable<entry_hash, entry_eq>   m_table;
+        unsigned                              m_num_hits = 0;
+        unsigned                              m_num_misses = 0;
+        unsigned                              m_num_replays = 0;
+        unsigned                              m_num_evictions = 0;
+
+    public:
+        instance_cache(ast_manager & m);
+
+        /**
+           \brief Record the instance of q for the bindings of the fingerprint f.
+           Return true if the instance was already in the cache.
+        */
+        bool insert(quantifier * q, fingerprint const & f, unsigned generation);
+
+        /**
+           \brief Keep only the entries that were hit and whose quantifier
+           satisfies is_live. The statistics are preserved.
+        */
+        void compact(std::function<bool(quantifier *)> const & is_live);
+
+        void reset();
+
+        svector<entry> const & entries() const { return m_entries; }
+        expr * const * get_bindings(entry const & e) const { return m_pinned.data() + e.m_bindings_offset; }
+        unsigned size() const { return m_entries.size(); }
+        void inc_replays() { m_num_replays++; }
+
+        void collect_statistics(::statistics & st) const;
+    };
 }
 
 
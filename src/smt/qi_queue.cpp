@@ -40,7 +40,7 @@ namespace smt {
         m_subst(m),
         m_instances(m) {
         init_parser_vars();
-        m_vals.resize(15, 0.0f);
+        m_vals.resize(16, 0.0f);
     }
 
     void qi_queue::setup() {
@@ -60,40 +60,44 @@ namespace smt {
             warning_msg("invalid new_gen function '%s', switching to default one", m_params.m_qi_new_gen.c_str());
             VERIFY(m_parser.parse_string("cost", m_new_gen_function));
         }
+        m_evaluator.compile(m_cost_function, m_cost_program);
+        m_evaluator.compile(m_new_gen_function, m_new_gen_program);
         m_eager_cost_threshold = m_params.m_qi_eager_threshold;
     }
 
     void qi_queue::init_parser_vars() {
-#define COST 14
+#define COST 15
         m_parser.add_var("cost");
-#define MIN_TOP_GENERATION 13
+#define MIN_TOP_GENERATION 14
         m_parser.add_var("min_top_generation");
-#define MAX_TOP_GENERATION 12
+#define MAX_TOP_GENERATION 13
         m_parser.add_var("max_top_generation");
-#define INSTANCES 11
+#define INSTANCES 12
         m_parser.add_var("instances");
-#define SIZE 10
+#define SIZE 11
         m_parser.add_var("size");
-#define DEPTH 9
+#define DEPTH 10
         m_parser.add_var("depth");
-#define GENERATION 8
+#define GENERATION 9
         m_parser.add_var("generation");
-#define QUANT_GENERATION 7
+#define QUANT_GENERATION 8
         m_parser.add_var("quant_generation");
-#define WEIGHT 6
+#define WEIGHT 7
         m_parser.add_var("weight");
-#define VARS 5
+#define VARS 6
         m_parser.add_var("vars");
-#define PATTERN_WIDTH 4
+#define PATTERN_WIDTH 5
         m_parser.add_var("pattern_width");
-#define TOTAL_INSTANCES 3
+#define TOTAL_INSTANCES 4
         m_parser.add_var("total_instances");
-#define SCOPE 2
+#define SCOPE 3
         m_parser.add_var("scope");
-#define NESTED_QUANTIFIERS 1
+#define NESTED_QUANTIFIERS 2
         m_parser.add_var("nested_quantifiers");
-#define CS_FACTOR 0
+#define CS_FACTOR 1
         m_parser.add_var("cs_factor");
+#define CONFLICTS 0
+        m_parser.add_var("conflicts");
     }
 
     q::quantifier_stat * qi_queue::set_values(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation, float cost) {
@@ -113,21 +117,38 @@ namespace smt {
         m_vals[SCOPE]              = static_cast<float>(m_context.get_scope_level());
         m_vals[NESTED_QUANTIFIERS] = static_cast<float>(stat->get_num_nested_quantifiers());
         m_vals[CS_FACTOR]          = static_cast<float>(stat->get_case_split_factor());
+        m_vals[CONFLICTS]          = static_cast<float>(stat->get_num_conflicts());
         TRACE(qi_queue_detail, for (unsigned i = 0; i < m_vals.size(); ++i) { tout << m_vals[i] << " "; } tout << "\n";);
         return stat;
     }
 
     float qi_queue::get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation) {
         q::quantifier_stat * stat = set_values(q, pat, generation, min_top_generation, max_top_generation, 0);
-        float r = m_evaluator(m_cost_function, m_vals.size(), m_vals.data());
+        float r = m_evaluator(m_cost_program, m_vals.size(), m_vals.data());
+        if (m_params.m_qi_adaptive)
+            r += get_adaptive_penalty(stat);
         stat->update_max_cost(r);
         return r;
     }
 
+    /**
+       \brief Cost added to the instances of a quantifier whose instances
+       rarely take part in conflicts. It is qi.adaptive_penalty when no
+       instance was used in a conflict, and it drops to zero when there
+       is a conflict for every ten instances.
+    */
+    float qi_queue::get_adaptive_penalty(q::quantifier_stat * stat) const {
+        unsigned num_instances = stat->get_num_instances();
+        if (num_instances < 10)
+            return 0.0f;
+        double ratio = std::min(1.0, 10.0 * stat->get_num_conflicts() / num_instances);
+        return static_cast<float>(m_params.m_qi_adaptive_penalty * (1.0 - ratio));
+    }
+
     unsigned qi_queue::get_new_gen(quantifier * q, unsigned generation, float cost) {
         // max_top_generation and min_top_generation are not available for computing inc_gen
         set_values(q, nullptr, generation, 0, 0, cost);
-        float r = m_evaluator(m_new_gen_function, m_vals.size(), m_vals.data());
+        float r = m_evaluator(m_new_gen_program, m_vals.size(), m_vals.data());
         if (q->get_weight() > 0 || r > 0)
             return static_cast<unsigned>(r);
         return std::max(generation + 1, static_cast<unsigned>(r));
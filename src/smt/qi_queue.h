@@ -50,6 +50,8 @@ namespace smt {
         expr_ref                      m_new_gen_function;
         cost_parser                   m_parser;
         cost_evaluator                m_evaluator;
+        cost_evaluator::program       m_cost_program;
+        cost_evaluator::program       m_new_gen_program;
         cached_var_subst              m_subst;
         svector<float>                m_vals;
         double                        m_eager_cost_threshold = 0;
@@ -75,6 +77,7 @@ namespace smt {
         void init_parser_vars();
         q::quantifier_stat * set_values(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation, float cost);
         float get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation);
+        float get_adaptive_penalty(q::quantifier_stat * stat) const;
         unsigned get_new_gen(quantifier * q, unsigned generation, float cost);
         void instantiate(entry & ent);
         void get_min_max_costs(float & min, float & max) const;
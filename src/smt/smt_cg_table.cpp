@@ -23,7 +23,7 @@ Revision History:
 namespace smt {
 
     // one table per func_decl implementation
-    unsigned cg_table::cg_hash::operator()(enode * n) const {
+    unsigned cg_table::nary_hash(enode * n) {
         SASSERT(n->get_decl()->is_flat_associative() || n->get_num_args() >= 3);
         unsigned a, b, c;
         a = b = 0x9e3779b9;
@@ -53,6 +53,8 @@ namespace smt {
 
     bool cg_table::cg_eq::operator()(enode * n1, enode * n2) const {
         SASSERT(n1->get_decl() == n2->get_decl());
+        if (n1->get_cg_hash() != n2->get_cg_hash())
+            return false;
         unsigned num = n1->get_num_args();
         if (num != n2->get_num_args()) {
             return false;
@@ -87,7 +89,7 @@ namespace smt {
                 return r;
             }
             else if (d->is_commutative()) {
-                r = TAG(void*, alloc(comm_table, cg_comm_hash(), cg_comm_eq(m_commutativity)), BINARY_COMM);
+                r = TAG(void*, alloc(comm_table, cg_cached_hash(), cg_comm_eq(m_commutativity)), BINARY_COMM);
                 SASSERT(GET_TAG(r) == BINARY_COMM);
                 return r;
             }
@@ -171,7 +173,7 @@ namespace smt {
         binary_table* tb = UNTAG(binary_table*, t);
         out << "b ";
         for (enode* n : *tb) {
-            out << n->get_owner_id() << " " << cg_binary_hash()(n) << " ";
+            out << n->get_owner_id() << " " << n->get_cg_hash() << " ";
         }
         out << "\n";
     }
@@ -204,7 +206,7 @@ namespace smt {
     }
 
 
-    enode_bool_pair cg_table::insert(enode * n) {
+    enode_bool_pair cg_table::insert_hashed(enode * n) {
         // it doesn't make sense to insert a constant.
         SASSERT(n->get_num_args() > 0);
         SASSERT(!m_manager.is_and(n->get_expr()));
@@ -217,7 +219,7 @@ namespace smt {
             return enode_bool_pair(n_prime, false);
         case BINARY:
             n_prime = UNTAG(binary_table*, t)->insert_if_not_there(n);
-            TRACE(cg_table, tout << "insert: " << n->get_owner_id() << " " << cg_binary_hash()(n) << " inserted: " << (n == n_prime) << " " << n_prime->get_owner_id() << "\n";
+            TRACE(cg_table, tout << "insert: " << n->get_owner_id() << " " << n->get_cg_hash() << " inserted: " << (n == n_prime) << " " << n_prime->get_owner_id() << "\n";
                   display_binary(tout, t); tout << "contains_ptr: " << contains_ptr(n) << "\n";); 
             return enode_bool_pair(n_prime, false);
         case BINARY_COMM:
@@ -230,6 +232,58 @@ namespace smt {
         }
     }
 
+    enode * cg_table::find_congruent(enode * n) const {
+        SASSERT(n->get_num_args() > 0);
+        void * t = const_cast<cg_table*>(this)->get_table(n);
+        enode * const * r;
+        switch (static_cast<table_kind>(GET_TAG(t))) {
+        case UNARY: {
+            unsigned h = unary_hash(n);
+            enode * a = n->get_arg(0)->get_root();
+            r = UNTAG(unary_table*, t)->find_core(h, [&](enode * e) {
+                return e->get_cg_hash() == h && e->get_arg(0)->get_root() == a;
+            });
+            break;
+        }
+        case BINARY: {
+            unsigned h = binary_hash(n);
+            enode * a = n->get_arg(0)->get_root();
+            enode * b = n->get_arg(1)->get_root();
+            r = UNTAG(binary_table*, t)->find_core(h, [&](enode * e) {
+                return e->get_cg_hash() == h && e->get_arg(0)->get_root() == a && e->get_arg(1)->get_root() == b;
+            });
+            break;
+        }
+        case BINARY_COMM: {
+            unsigned h = comm_hash(n);
+            enode * a = n->get_arg(0)->get_root();
+            enode * b = n->get_arg(1)->get_root();
+            r = UNTAG(comm_table*, t)->find_core(h, [&](enode * e) {
+                if (e->get_cg_hash() != h)
+                    return false;
+                enode * c1 = e->get_arg(0)->get_root();
+                enode * c2 = e->get_arg(1)->get_root();
+                return (c1 == a && c2 == b) || (c1 == b && c2 == a);
+            });
+            break;
+        }
+        default: {
+            unsigned h = nary_hash(n);
+            unsigned num = n->get_num_args();
+            r = UNTAG(table*, t)->find_core(h, [&](enode * e) {
+                if (e->get_cg_hash() != h || e->get_num_args() != num)
+                    return false;
+                for (unsigned i = 0; i < num; ++i)
+                    if (e->get_arg(i)->get_root() != n->get_arg(i)->get_root())
+                        return false;
+                return true;
+            });
+            break;
+        }
+        }
+        return r ? *r : nullptr;
+    }
+
     void cg_table::erase(enode * n) {
         SASSERT(n->get_num_args() > 0);
         void * t = get_table(n); 
@@ -238,7 +292,7 @@ namespace smt {
             UNTAG(unary_table*, t)->erase(n);
             break;
         case BINARY:
-            TRACE(cg_table, tout << "erase: " << n->get_owner_id() << " " << cg_binary_hash()(n) << " contains: " << contains_ptr(n) << "\n";);
+            TRACE(cg_table, tout << "erase: " << n->get_owner_id() << " " << n->get_cg_hash() << " contains: " << contains_ptr(n) << "\n";);
             UNTAG(binary_table*, t)->erase(n);
             break;
         case BINARY_COMM:
@@ -30,56 +30,69 @@ namespace smt {
 
     /**
        \brief Congruence table.
+
+       The hash code of an enode depends on the roots of its arguments. It
+       is computed when the enode is inserted or looked up, and cached in
+       the enode. The roots of the arguments of an enode do not change while
+       it is in the table (context::add_eq removes the parents of the
+       smaller class before merging), so erasing an enode and growing a
+       table use the cached code instead of visiting the arguments, and
+       the equality tests compare the cached codes first.
     */
     class cg_table {
-        struct cg_unary_hash {
+        struct cg_cached_hash {
             unsigned operator()(enode * n) const {
-                SASSERT(n->get_num_args() == 1);
-                return n->get_arg(0)->get_root()->hash();
+                return n->get_cg_hash();
             }
         };
 
+        static unsigned unary_hash(enode * n) {
+            SASSERT(n->get_num_args() == 1);
+            return n->get_arg(0)->get_root()->hash();
+        }
+
+        static unsigned binary_hash(enode * n) {
+            SASSERT(n->get_num_args() == 2);
+            return combine_hash(n->get_arg(0)->get_root()->hash(), n->get_arg(1)->get_root()->hash());
+        }
+
+        static unsigned comm_hash(enode * n) {
+            SASSERT(n->get_num_args() == 2);
+            unsigned h1 = n->get_arg(0)->get_root()->hash();
+            unsigned h2 = n->get_arg(1)->get_root()->hash();
+            if (h1 > h2)
+                std::swap(h1, h2);
+            return hash_u((h1 << 16) | (h2 & 0xFFFF));
+        }
+
+        static unsigned nary_hash(enode * n);
+
         struct cg_unary_eq {
             bool operator()(enode * n1, enode * n2) const {
                 SASSERT(n1->get_num_args() == 1);
                 SASSERT(n2->get_num_args() == 1);
                 SASSERT(n1->get_decl() == n2->get_decl());
-                return n1->get_arg(0)->get_root() == n2->get_arg(0)->get_root();
+                return 
+                    n1->get_cg_hash() == n2->get_cg_hash() &&
+                    n1->get_arg(0)->get_root() == n2->get_arg(0)->get_root();
             }
         };
 
-        typedef chashtable<enode *, cg_unary_hash, cg_unary_eq> unary_table;
+        typedef chashtable<enode *, cg_cached_hash, cg_unary_eq> unary_table;
         
-        struct cg_binary_hash {
-            unsigned operator()(enode * n) const {
-                SASSERT(n->get_num_args() == 2);
-                return combine_hash(n->get_arg(0)->get_root()->hash(), n->get_arg(1)->get_root()->hash());
-            }
-        };
-
         struct cg_binary_eq {
             bool operator()(enode * n1, enode * n2) const {
                 SASSERT(n1->get_num_args() == 2);
                 SASSERT(n2->get_num_args() == 2);
                 SASSERT(n1->get_decl() == n2->get_decl());
                 return 
+                    n1->get_cg_hash() == n2->get_cg_hash() &&
                     n1->get_arg(0)->get_root() == n2->get_arg(0)->get_root() &&
                     n1->get_arg(1)->get_root() == n2->get_arg(1)->get_root();
             }
         };
 
-        typedef chashtable<enode*, cg_binary_hash, cg_binary_eq> binary_table;
-        
-        struct cg_comm_hash {
-            unsigned operator()(enode * n) const {
-                SASSERT(n->get_num_args() == 2);
-                unsigned h1 = n->get_arg(0)->get_root()->hash();
-                unsigned h2 = n->get_arg(1)->get_root()->hash();
-                if (h1 > h2)
-                    std::swap(h1, h2);
-                return hash_u((h1 << 16) | (h2 & 0xFFFF));
-            }
-        };
+        typedef chashtable<enode*, cg_cached_hash, cg_binary_eq> binary_table;
         
         struct cg_comm_eq {
             bool & m_commutativity;
@@ -88,6 +101,8 @@ namespace smt {
                 SASSERT(n1->get_num_args() == 2);
                 SASSERT(n2->get_num_args() == 2);
                 SASSERT(n1->get_decl() == n2->get_decl());
+                if (n1->get_cg_hash() != n2->get_cg_hash())
+                    return false;
                 enode * c1_1 = n1->get_arg(0)->get_root();
                 enode * c1_2 = n1->get_arg(1)->get_root();
                 enode * c2_1 = n2->get_arg(0)->get_root();
@@ -103,17 +118,13 @@ namespace smt {
             }
         };
 
-        typedef chashtable<enode*, cg_comm_hash, cg_comm_eq> comm_table;
-
-        struct cg_hash {
-            unsigned operator()(enode * n) const;
-        };
+        typedef chashtable<enode*, cg_cached_hash, cg_comm_eq> comm_table;
 
         struct cg_eq {
             bool operator()(enode * n1, enode * n2) const;
         };
 
-        typedef chashtable<enode*, cg_hash, cg_eq> table;
+        typedef chashtable<enode*, cg_cached_hash, cg_eq> table;
 
         ast_manager &                 m_manager;
         bool                          m_commutativity; //!< true if the last found congruence used commutativity
@@ -138,6 +149,26 @@ namespace smt {
             return m_tables[tid];
         }
 
+        /**
+           \brief Compute the hash code of n for its table t and cache it in n.
+        */
+        static void set_hash(enode * n, void * t) {
+            switch (static_cast<table_kind>(GET_TAG(t))) {
+            case UNARY:
+                n->set_cg_hash(unary_hash(n));
+                break;
+            case BINARY:
+                n->set_cg_hash(binary_hash(n));
+                break;
+            case BINARY_COMM:
+                n->set_cg_hash(comm_hash(n));
+                break;
+            default:
+                n->set_cg_hash(nary_hash(n));
+                break;
+            }
+        }
+
     public:
         cg_table(ast_manager & m);
         ~cg_table();
@@ -148,55 +179,43 @@ namespace smt {
            return n' and a boolean indicating whether n and n' are congruence
            modulo commutativity, otherwise insert n and return (n,false).
         */
-        enode_bool_pair insert(enode * n);
+        enode_bool_pair insert(enode * n) {
+            update_hash(n);
+            return insert_hashed(n);
+        }
+
+        /**
+           \brief Compute the hash code of n from the current roots of its arguments.
+        */
+        void update_hash(enode * n) {
+            SASSERT(n->get_num_args() > 0);
+            set_hash(n, get_table(n));
+        }
+
+        /**
+           \brief Insert n using the hash code computed by the last update_hash(n).
+           The roots of the arguments of n must not have changed since then.
+        */
+        enode_bool_pair insert_hashed(enode * n);
 
         void erase(enode * n);
 
+        /**
+           \brief Return the enode of the table that is congruent to n, or null.
+           The hash code cached in n is not updated.
+        */
+        enode * find_congruent(enode * n) const;
+
         bool contains(enode * n) const {
-            SASSERT(n->get_num_args() > 0);
-            void * t = const_cast<cg_table*>(this)->get_table(n); 
-            switch (static_cast<table_kind>(GET_TAG(t))) {
-            case UNARY:
-                return UNTAG(unary_table*, t)->contains(n);
-            case BINARY:
-                return UNTAG(binary_table*, t)->contains(n);
-            case BINARY_COMM:
-                return UNTAG(comm_table*, t)->contains(n);
-            default:
-                return UNTAG(table*, t)->contains(n);
-            }
+            return find_congruent(n) != nullptr;
         }
 
         enode * find(enode * n) const {
-            SASSERT(n->get_num_args() > 0);
-            enode * r = nullptr;
-            void * t = const_cast<cg_table*>(this)->get_table(n); 
-            switch (static_cast<table_kind>(GET_TAG(t))) {
-            case UNARY:
-                return UNTAG(unary_table*, t)->find(n, r) ? r : nullptr;
-            case BINARY:
-                return UNTAG(binary_table*, t)->find(n, r) ? r : nullptr;
-            case BINARY_COMM:
-                return UNTAG(comm_table*, t)->find(n, r) ? r : nullptr;
-            default:
-                return UNTAG(table*, t)->find(n, r) ? r : nullptr;
-            }
+            return find_congruent(n);
         }
 
         bool contains_ptr(enode * n) const {
-            enode * r;
-            SASSERT(n->get_num_args() > 0);
-            void * t = const_cast<cg_table*>(this)->get_table(n); 
-            switch (static_cast<table_kind>(GET_TAG(t))) {
-            case UNARY:
-                return UNTAG(unary_table*, t)->find(n, r) && n == r;
-            case BINARY:
-                return UNTAG(binary_table*, t)->find(n, r) && n == r;
-            case BINARY_COMM:
-                return UNTAG(comm_table*, t)->find(n, r) && n == r;
-            default:
-                return UNTAG(table*, t)->find(n, r) && n == r;
-            }
+            return find_congruent(n) == n;
         }
 
         void reset();
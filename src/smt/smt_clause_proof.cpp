@@ -37,9 +37,12 @@ namespace smt {
             if (id > 0)
                 log_name = std::to_string(id) + log_name;
             ++id;
-            m_pp_out = alloc(std::ofstream, log_name);
+            bool binary = ctx.get_fparams().m_proof_log_binary;
+            m_pp_out = alloc(std::ofstream, log_name, binary ? std::ios::out | std::ios::binary : std::ios::out);
             if (!*m_pp_out)
                 throw default_exception(std::string("Could not open file ") + proof_log.str());
+            if (binary)
+                m_binary_out = alloc(proof_log_binary_writer, m, *m_pp_out);
         }
     }
 
@@ -188,6 +191,15 @@ namespace smt {
         m_pp.define_expr(out, e);
     }
 
+    void clause_proof::log_binary(status st, expr_ref_vector const& v, proof* p) {
+        proof_log_record r = proof_log_record::infer;
+        if (st == status::deleted)
+            r = proof_log_record::del;
+        else if (st == status::assumption && (!p || p->get_decl()->get_name() == "assumption"))
+            r = proof_log_record::assume;
+        m_binary_out->log(r, v.size(), v.data(), p);
+    }
+
     void clause_proof::update(status st, expr_ref_vector& v, proof* p) {
         TRACE(clause_proof, tout << m_trail.size() << " " << st << " " << v << "\n";);
         if (ctx.get_fparams().m_clause_proof)
@@ -197,6 +209,10 @@ namespace smt {
         
         if (m_has_log) {
             init_pp_out();
+            if (m_binary_out) {
+                log_binary(st, v, p);
+                return;
+            }
             auto& out = *m_pp_out;
             for (auto* e : v)
                 declare(out, e);
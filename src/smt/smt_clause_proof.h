@@ -27,6 +27,7 @@ Revision History:
 #pragma once
 
 #include "ast/ast_pp_util.h"
+#include "ast/proof_log_binary.h"
 #include "smt/smt_theory.h"
 #include "smt/smt_clause.h"
 #include "smt/smt_justification.h"
@@ -63,6 +64,7 @@ namespace smt {
         void*                           m_on_clause_ctx = nullptr;
         ast_pp_util                     m_pp;
         scoped_ptr<std::ofstream>       m_pp_out;
+        scoped_ptr<proof_log_binary_writer> m_binary_out;
         proof_ref m_assumption, m_rup, m_del, m_smt;
 
         void init_pp_out();
@@ -72,6 +74,7 @@ namespace smt {
         status kind2st(clause_kind k);
         proof_ref justification2proof(status st, justification* j);
         void log(status st, proof* p);
+        void log_binary(status st, expr_ref_vector const& v, proof* p);
         void declare(std::ostream& out, expr* e);
         std::ostream& display_literals(std::ostream& out, expr_ref_vector const& v);
         std::ostream& display_hint(std::ostream& out, proof* p);
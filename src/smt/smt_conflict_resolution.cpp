@@ -311,6 +311,10 @@ namespace smt {
         TRACE(conflict_, tout << "processing antecedent (level " << lvl << "):";
               m_ctx.display_literal(tout, antecedent);
               m_ctx.display_detailed_literal(tout << " ", antecedent) << "\n";);
+
+        // the clauses of quantifier instances contain the negation of the quantifier
+        if (m_params.m_qi_adaptive && !antecedent.sign() && m_ctx.get_bdata(var).is_quantifier())
+            m_ctx.quantifier_conflict_eh(to_quantifier(m_ctx.bool_var2expr(var)));
         
         if (!m_ctx.is_marked(var) && lvl > m_ctx.get_base_level()) {
             m_ctx.set_mark(var);
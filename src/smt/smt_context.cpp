@@ -44,6 +44,7 @@ Revision History:
 #include "smt/smt_model_finder.h"
 #include "smt/smt_parallel.h"
 #include "smt/smt_arith_value.h"
+#include "util/profile.h"
 #include <iostream>
 
 namespace smt {
@@ -663,6 +664,14 @@ namespace smt {
         enode_vector & r1_parents  = r1->m_parents;
         unsigned num_r1_parents = r1_parents.size();
         unsigned generation_cache_idx = 0;
+        // When a large class is merged, compute the hash codes of the parents
+        // in one pass over their arguments before probing the table.
+        bool batch = num_r1_parents >= 32;
+        if (batch) {
+            for (enode * parent : r1_parents)
+                if (parent->is_marked() && parent->is_cgc_enabled())
+                    m_cg_table.update_hash(parent);
+        }
         for (unsigned i = 0; i < num_r1_parents; ++i) {
             enode* parent = r1_parents[i];
             if (!parent->is_marked())
@@ -697,7 +706,7 @@ namespace smt {
                     parent_generation = g;
                 }
 
-                auto [parent_prime, used_commutativity] = m_cg_table.insert(parent);
+                auto [parent_prime, used_commutativity] = batch ? m_cg_table.insert_hashed(parent) : m_cg_table.insert(parent);
                 if (parent_prime == parent) {
                     SASSERT(parent);
                     SASSERT(parent->is_cgr());  
@@ -1813,6 +1822,7 @@ namespace smt {
        congruences cannot be retracted to a consistent state.
      */
     bool context::propagate() {
+        PROFILE_SCOPE("smt.propagate");
         TRACE(propagate, tout << "propagating... " << m_qhead << ":" << m_assigned_literals.size() << "\n");
         
         while (true) {
@@ -3628,6 +3638,7 @@ namespace smt {
             m_conflict = null_b_justification;
             r = l_true;
         }
+        finalize_sls();
         m_internal_completed = l_false;
         if (r == l_true && gparams::get_value("model_validate") == "true") {
             recfun::util u(m);
@@ -3704,6 +3715,17 @@ namespace smt {
         return r;
     }
 
+    /**
+       \brief Stop the local search threads at the end of a search.
+    */
+    void context::finalize_sls() {
+        if (!m_fparams.m_sls_enable)
+            return;
+        auto p = m_theories.get_plugin(m.get_family_id("sls"));
+        if (p)
+            static_cast<theory_sls*>(p)->finalize();
+    }
+
     bool context::has_sls_model() {
         if (!m_fparams.m_sls_enable)
             return false;
@@ -620,6 +620,13 @@ namespace smt {
             return m_qmanager->get_generation(q);
         }
 
+        /**
+           \brief Record that an instance of q was used to derive a conflict.
+        */
+        void quantifier_conflict_eh(quantifier * q) {
+            m_qmanager->conflict_eh(q);
+        }
+
         unsigned get_generation(enode * e) const  {
             // We don't support patterns with equality so there is no need to track generations for them.
             if (e->is_eq())
@@ -674,6 +681,8 @@ namespace smt {
 
         bool has_sls_model();
 
+        void finalize_sls();
+
         // -----------------------------------
         //
         // Backtracking support
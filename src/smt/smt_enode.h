@@ -67,6 +67,7 @@ namespace smt {
         unsigned            m_generation;    //!< Cached generation of the congruence class. Valid when is_cgr(), or when the enode does not use the cg_table (constants/leaves/true-eq nodes), where it directly stores the enode's generation.
 
         unsigned            m_func_decl_id; //!< Id generated by the congruence table for fast indexing.
+        unsigned            m_cg_hash;      //!< Congruence hash, computed by the congruence table when the enode is inserted or looked up.
 
         unsigned            m_mark:1;        //!< Multi-purpose auxiliary mark. 
         unsigned            m_mark2:1;       //!< Multi-purpose auxiliary mark. 
@@ -157,6 +158,14 @@ namespace smt {
             m_func_decl_id = id;
         }
 
+        unsigned get_cg_hash() const {
+            return m_cg_hash;
+        }
+
+        void set_cg_hash(unsigned h) {
+            m_cg_hash = h;
+        }
+
         void mark_as_interpreted() {
             SASSERT(!m_interpreted);
             SASSERT(m_class_size == 1);
@@ -34,7 +34,13 @@ Revision History:
 #include "smt/smt_context.h"
 #include "smt/smt_model_finder.h"
 #include "model/model_pp.h"
+#include "ast/ast_translation.h"
+#include "util/mutex.h"
 #include <tuple>
+#include <exception>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 namespace smt {
 
@@ -140,20 +146,19 @@ namespace smt {
     }
 
     /**
-       \brief Assert in m_aux_context, the constraint
+       \brief Add to fmls the constraint
 
          sk = e_1 OR ... OR sk = e_n
 
          where {e_1, ..., e_n} is the universe.
      */
-    void model_checker::restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe) {
+    void model_checker::restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe, expr_ref_vector & fmls) {
         SASSERT(!universe.empty());
         ptr_buffer<expr> eqs;
         for (expr * e : universe) {
             eqs.push_back(m.mk_eq(sk, e));
         }
-        expr_ref fml(m.mk_or(eqs), m);
-        m_aux_context->assert_expr(fml);
+        fmls.push_back(m.mk_or(eqs));
     }
 
     /**
@@ -163,6 +168,18 @@ namespace smt {
     */
 
     bool model_checker::assert_neg_q_m(quantifier * q, expr_ref_vector & sks) {
+        expr_ref_vector fmls(m);
+        if (!mk_neg_q_m(q, sks, fmls))
+            return false;
+        for (expr * f : fmls)
+            m_aux_context->assert_expr(f);
+        return true;
+    }
+
+    /**
+       \brief Store in fmls the constraints asserted by assert_neg_q_m.
+    */
+    bool model_checker::mk_neg_q_m(quantifier * q, expr_ref_vector & sks, expr_ref_vector & fmls) {
         expr_ref tmp(m);
         
         TRACE(model_checker, tout << "curr_model:\n"; model_pp(tout, *m_curr_model););
@@ -181,7 +198,7 @@ namespace smt {
             sks[num_decls - i - 1]        = sk;
             subst_args[num_decls - i - 1] = sk;
             if (m_curr_model->is_finite(s)) {
-                restrict_to_universe(sk, m_curr_model->get_known_universe(s));
+                restrict_to_universe(sk, m_curr_model->get_known_universe(s), fmls);
             }
         }
 
@@ -190,7 +207,7 @@ namespace smt {
         expr_ref r(m);
         r = m.mk_not(sk_body);
         TRACE(model_checker, tout << "mk_neg_q_m:\n" << mk_ismt2_pp(r, m) << "\n";);
-        m_aux_context->assert_expr(r);
+        fmls.push_back(r);
         return true;
     }
 
@@ -332,31 +349,42 @@ namespace smt {
 
     /**
        \brief Return true if q is satisfied by m_curr_model.
+       If pr is a counter-example found by check_parallel, the complete
+       model check is skipped and its model is used instead.
     */
 
-    bool model_checker::check(quantifier * q) {
+    bool model_checker::check(quantifier * q, parallel_result * pr) {
         SASSERT(!m_aux_context->relevancy());
         scoped_ctx_push _push(m_aux_context.get());
 
         quantifier * flat_q = get_flat_quantifier(q);
         TRACE(model_checker, tout << "model checking:\n" << expr_ref(flat_q->get_expr(), m) << "\n";);
         expr_ref_vector sks(m);
+        model_ref complete_cex;
 
-        if (!assert_neg_q_m(flat_q, sks))
-            return false;
-        TRACE(model_checker, tout << "skolems:\n" << sks << "\n";);
-
-        flet<bool> l1(m_aux_context->get_fparams().m_array_fake_support, true);
-        flet<bool> l2(m_aux_context->get_fparams().m_preprocess, true);
-        lbool r = m_aux_context->check();
-        
-        TRACE(model_checker, tout << "[complete] model-checker result: " << to_sat_str(r) << "\n";);
-        if (r != l_true) {
-            return is_safe_for_mbqi(q) && r == l_false; // quantifier is satisfied by m_curr_model
+        if (pr && pr->m_result == l_true) {
+            sks.append(pr->m_sks);
+            for (expr * f : pr->m_fmls)
+                m_aux_context->assert_expr(f);
+            complete_cex = pr->m_cex;
+            TRACE(model_checker, tout << "skolems:\n" << sks << "\n[complete] model-checker result: sat (parallel)\n";);
         }
+        else {
+            if (!assert_neg_q_m(flat_q, sks))
+                return false;
+            TRACE(model_checker, tout << "skolems:\n" << sks << "\n";);
 
-        model_ref complete_cex;
-        m_aux_context->get_model(complete_cex);
+            flet<bool> l1(m_aux_context->get_fparams().m_array_fake_support, true);
+            flet<bool> l2(m_aux_context->get_fparams().m_preprocess, true);
+            lbool r = m_aux_context->check();
+
+            TRACE(model_checker, tout << "[complete] model-checker result: " << to_sat_str(r) << "\n";);
+            if (r != l_true) {
+                return is_safe_for_mbqi(q) && r == l_false; // quantifier is satisfied by m_curr_model
+            }
+
+            m_aux_context->get_model(complete_cex);
+        }
 
         // try to find new instances using instantiation sets.
         m_model_finder.restrict_sks_to_inst_set(m_aux_context.get(), q, sks);
@@ -502,7 +530,130 @@ namespace smt {
     // using multi-patterns.
     //
 
+    /**
+       \brief Check the quantifiers qs against m_curr_model on m_mbqi_threads
+       auxiliary contexts, each with its own ast_manager.
+       results[i] is the outcome of the complete model check of qs[i], with
+       its skolem constants, its formulas and, if the negation of qs[i] is
+       satisfiable, the model translated back to m. results is empty if the
+       quantifiers are checked sequentially.
+       Instances are created afterwards by check(q, results[i]) in the calling
+       thread, in the order of qs, so the instances and the state of the model
+       finder do not depend on the scheduling of the threads.
+       An exception raised by a thread is rethrown here after all threads are joined.
+    */
+    void model_checker::check_parallel(ptr_vector<quantifier> const & qs, scoped_ptr_vector<parallel_result> & results) {
+        results.reset();
+#ifndef SINGLE_THREAD
+        unsigned num_threads = std::min(m_params.m_mbqi_threads, qs.size());
+        if (num_threads <= 1)
+            return;
+
+        struct worker {
+            ast_manager          m;
+            smt_params           m_fparams;
+            expr_ref_vector      m_fmls;
+            unsigned_vector      m_qidx;    // index of the quantifier in qs
+            unsigned_vector      m_begin;   // m_fmls[m_begin[k] .. m_begin[k+1]) belong to m_qidx[k]
+            svector<lbool>       m_results;
+            vector<model_ref>    m_models;  // counter-example for m_qidx[k] if m_results[k] is l_true
+            std::exception_ptr   m_ex;
+            worker(smt_params const & p): m_fparams(p), m_fmls(m) {
+                m_fparams.m_array_fake_support = true;
+                m_fparams.m_preprocess = true;
+                m_begin.push_back(0);
+            }
+        };
+
+        scoped_ptr_vector<worker> workers;
+        for (unsigned i = 0; i < num_threads; ++i)
+            workers.push_back(alloc(worker, *m_fparams));
+
+        // the formulas are built and translated in this thread.
+        // Quantifiers are assigned to workers round robin.
+        for (unsigned i = 0; i < qs.size(); ++i) {
+            results.push_back(alloc(parallel_result, m));
+            quantifier * q = qs[i];
+            if (!is_safe_for_mbqi(q))
+                continue;
+            parallel_result & pr = *results[i];
+            if (!mk_neg_q_m(get_flat_quantifier(q), pr.m_sks, pr.m_fmls))
+                continue;
+            worker & w = *workers[i % num_threads];
+            ast_translation tr(m, w.m);
+            for (expr * f : pr.m_fmls)
+                w.m_fmls.push_back(tr(f));
+            w.m_qidx.push_back(i);
+            w.m_begin.push_back(w.m_fmls.size());
+        }
+
+        scoped_limits sl(m.limit());
+        for (worker * w : workers)
+            sl.push_child(&w->m.limit());
+
+        auto run = [&](worker & w) {
+            try {
+                params_ref p;
+                p.set_bool("solver.axioms2files", false);
+                p.set_bool("solver.lemmas2console", false);
+                p.set_sym("solver.proof.log", symbol::null);
+                context ctx(w.m, w.m_fparams, p);
+                for (unsigned k = 0; k < w.m_qidx.size(); ++k) {
+                    ctx.push();
+                    for (unsigned j = w.m_begin[k]; j < w.m_begin[k + 1]; ++j)
+                        ctx.assert_expr(w.m_fmls.get(j));
+                    lbool r = ctx.check();
+                    model_ref mdl;
+                    if (r == l_true)
+                        ctx.get_model(mdl);
+                    ctx.pop(1);
+                    w.m_results.push_back(r);
+                    w.m_models.push_back(mdl);
+                    if (r == l_undef && !w.m.inc())
+                        return;
+                }
+            }
+            catch (...) {
+                w.m_ex = std::current_exception();
+            }
+        };
+
+        vector<std::thread> threads;
+        for (worker * w : workers)
+            threads.push_back(std::thread([&, w]() { run(*w); }));
+        for (auto & t : threads)
+            t.join();
+
+        for (worker * w : workers)
+            if (w->m_ex)
+                std::rethrow_exception(w->m_ex);
+
+        for (worker * w : workers) {
+            ast_translation tr(w->m, m);
+            for (unsigned k = 0; k < w->m_results.size(); ++k) {
+                parallel_result & pr = *results[w->m_qidx[k]];
+                pr.m_result = w->m_results[k];
+                if (pr.m_result == l_true && w->m_models[k])
+                    pr.m_cex = w->m_models[k]->translate(tr);
+                else if (pr.m_result == l_true)
+                    pr.m_result = l_undef;
+            }
+        }
+#endif
+    }
+
     void model_checker::check_quantifiers(bool& found_relevant, unsigned& num_failures) {
+        ptr_vector<quantifier> qs;
+        for (quantifier * q : *m_qm) {
+            if (m_qm->mbqi_enabled(q) &&
+                m_context->is_relevant(q) &&
+                m_context->get_assignment(q) == l_true)
+                qs.push_back(q);
+        }
+        scoped_ptr_vector<parallel_result> results;
+        check_parallel(qs, results);
+
+        unsigned i = 0;
         for (quantifier * q : *m_qm) {
             if (!(m_qm->mbqi_enabled(q) &&
                   m_context->is_relevant(q) &&
@@ -511,6 +662,12 @@ namespace smt {
                     ++num_failures;
                 continue;
             }
+            SASSERT(qs[i] == q);
+            parallel_result * pr = results.get(i++);
+            if (pr && pr->m_result == l_false) {
+                found_relevant = true;
+                continue;
+            }
 
             TRACE(model_checker,
                   tout << "Check: " << mk_pp(q, m) << "\n";
@@ -520,7 +677,7 @@ namespace smt {
                 IF_VERBOSE(1, verbose_stream() << "(smt.mbqi :checking " << q->get_qid() << ")\n");
             }
             found_relevant = true;
-            if (!check(q)) {
+            if (!check(q, pr)) {
                 if (m_params.m_mbqi_trace || get_verbosity_level() >= 5) {
                     IF_VERBOSE(0, verbose_stream() << "(smt.mbqi :failed " << q->get_qid() << ")\n");
                 }
@@ -21,6 +21,8 @@ Revision History:
 #pragma once
 
 #include "util/obj_hashtable.h"
+#include "util/ref.h"
+#include "util/scoped_ptr_vector.h"
 #include "ast/ast.h"
 #include "ast/array_decl_plugin.h"
 #include "params/qi_params.h"
@@ -60,11 +62,23 @@ namespace smt {
         expr * get_term_from_ctx(expr * val);
         expr * get_type_compatible_term(expr * val);
         expr_ref replace_value_from_ctx(expr * e);
-        void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe);
+        void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe, expr_ref_vector & fmls);
+        bool mk_neg_q_m(quantifier * q, expr_ref_vector & sks, expr_ref_vector & fmls);
         bool assert_neg_q_m(quantifier * q, expr_ref_vector & sks);
         bool add_blocking_clause(model * cex, expr_ref_vector & sks);
-        bool check(quantifier * q);
+
+        // result of checking a quantifier on an auxiliary thread of check_parallel.
+        struct parallel_result {
+            lbool           m_result = l_undef;
+            expr_ref_vector m_sks;   // skolem constants of the flat quantifier
+            expr_ref_vector m_fmls;  // negation of the quantifier in m_curr_model
+            ref<model>      m_cex;   // model of m_fmls if m_result is l_true
+            parallel_result(ast_manager & m): m_sks(m), m_fmls(m) {}
+        };
+
+        bool check(quantifier * q, parallel_result * pr = nullptr);
         void check_quantifiers(bool& found_relevant, unsigned& num_failures);
+        void check_parallel(ptr_vector<quantifier> const & qs, scoped_ptr_vector<parallel_result> & results);
 
         struct instance {
             quantifier * m_q;
@@ -1487,6 +1487,12 @@ namespace smt {
 
         release_worker_lease_unlocked(worker_id, lease);
 
+        if (did_split && m_work_stealing) {
+            auto& q = m_worker_queues[worker_id];
+            q.push_back(leased_node->right());
+            q.push_back(leased_node->left());
+        }
+
         if (did_split) {
             ++m_stats.m_num_cubes;
             m_stats.m_max_cube_depth = std::max(m_stats.m_max_cube_depth, leased_node->depth() + 1);
@@ -1826,7 +1832,13 @@ namespace smt {
             return false;
         }
         
-        node *t = is_first_run ? m_search_tree.activate_root() : m_search_tree.activate_best_node();
+        node *t = nullptr;
+        if (is_first_run)
+            t = m_search_tree.activate_root();
+        else if (m_work_stealing)
+            t = activate_queued_node_unlocked(id);
+        if (!t && !is_first_run)
+            t = m_search_tree.activate_best_node();
         
         if (!t)
             return false;
@@ -1850,6 +1862,38 @@ namespace smt {
         return true;
     }
 
+    parallel::node* parallel::batch_manager::activate_queued_node_unlocked(unsigned worker_id) {
+        if (worker_id >= m_worker_queues.size())
+            return nullptr;
+        // queued nodes may have been closed by backtracking or activated by other workers meanwhile
+        auto& own = m_worker_queues[worker_id];
+        while (!own.empty()) {
+            node* n = own.pop_back();
+            if (m_search_tree.activate(n)) {
+                ++m_stats.m_num_local_cubes;
+                return n;
+            }
+        }
+        while (true) {
+            unsigned victim = UINT_MAX;
+            for (unsigned i = 0; i < m_worker_queues.size(); ++i)
+                if (i != worker_id && !m_worker_queues[i].empty() &&
+                    (victim == UINT_MAX || m_worker_queues[i].size() > m_worker_queues[victim].size()))
+                    victim = i;
+            if (victim == UINT_MAX)
+                return nullptr;
+            auto& q = m_worker_queues[victim];
+            while (!q.empty()) {
+                node* n = q.pop_front();
+                if (m_search_tree.activate(n)) {
+                    ++m_stats.m_num_stolen_cubes;
+                    IF_VERBOSE(2, verbose_stream() << "Worker " << worker_id << " stole cube from worker " << victim << "\n");
+                    return n;
+                }
+            }
+        }
+    }
+
     void parallel::batch_manager::initialize(unsigned num_global_bb_threads, unsigned initial_max_thread_conflicts) {
         m_state = state::is_running;
 
@@ -1869,6 +1913,9 @@ namespace smt {
         
         parallel_params pp(p.ctx.m_params);
         m_ablate_backtracking = pp.ablate_backtracking();
+        m_work_stealing = pp.work_stealing();
+        m_worker_queues.reset();
+        m_worker_queues.resize(p.m_workers.size());
         m_canceled = false;
     }
 
@@ -1880,6 +1927,8 @@ namespace smt {
         st.update("parallel-core-min-jobs-published", m_stats.m_core_min_jobs_published);
         st.update("parallel-core-min-jobs-skipped", m_stats.m_core_min_jobs_skipped);
         st.update("parallel-core-min-global-unsat", m_stats.m_core_min_global_unsat);
+        st.update("parallel-local-cubes", m_stats.m_num_local_cubes);
+        st.update("parallel-stolen-cubes", m_stats.m_num_stolen_cubes);
     }
 
     lbool parallel::operator()(expr_ref_vector const &asms) {
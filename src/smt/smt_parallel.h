@@ -94,6 +94,8 @@ namespace smt {
                 unsigned m_core_min_jobs_published = 0;
                 unsigned m_core_min_jobs_skipped = 0;
                 unsigned m_core_min_global_unsat = 0;
+                unsigned m_num_local_cubes = 0;
+                unsigned m_num_stolen_cubes = 0;
             };
             struct core_min_job {
                 node* source = nullptr;
@@ -107,6 +109,23 @@ namespace smt {
             stats m_stats;
             search_tree::tree<cube_config> m_search_tree;
             vector<node_lease> m_worker_leases;
+
+            // Work stealing: children created by a split are queued at the splitting worker.
+            // A worker resumes from the back of its own queue (deepest cube first) and
+            // steals from the front (shallowest cube) of the longest queue of another worker.
+            // Only when all queues are exhausted is the search tree scanned for a best node.
+            struct cube_queue {
+                ptr_vector<node> m_nodes;
+                unsigned m_head = 0;
+                bool empty() const { return m_head == m_nodes.size(); }
+                unsigned size() const { return m_nodes.size() - m_head; }
+                void push_back(node* n) { m_nodes.push_back(n); }
+                node* pop_back() { node* n = m_nodes.back(); m_nodes.pop_back(); if (empty()) reset(); return n; }
+                node* pop_front() { node* n = m_nodes[m_head++]; if (empty()) reset(); return n; }
+                void reset() { m_nodes.reset(); m_head = 0; }
+            };
+            bool m_work_stealing = false;
+            vector<cube_queue> m_worker_queues;
             
             unsigned m_exception_code = 0;
             std::string m_exception_msg;
@@ -194,6 +213,7 @@ namespace smt {
                                                    vector<node_lease>& targets);
             node* find_core_source_unlocked(ast_translation& l2g, node* source, expr_ref_vector const& core);
             unsigned select_best_core_min_job_unlocked() const;
+            node* activate_queued_node_unlocked(unsigned worker_id);
 
         public:
             batch_manager(ast_manager& m, parallel& p) : m(m), p(p), m_search_tree(expr_ref(m)) { }
@@ -136,6 +136,9 @@ namespace smt {
         ptr_vector<quantifier>                 m_quantifiers;
         scoped_ptr<quantifier_manager_plugin>  m_plugin;
         unsigned                               m_num_instances = 0;
+        instance_cache                         m_instance_cache;
+        bool                                   m_replay_cache = false;
+        bool                                   m_replaying = false;
 
         imp(quantifier_manager & wrapper, context & ctx, smt_params & p, quantifier_manager_plugin * plugin):
             m_wrapper(wrapper),
@@ -143,7 +146,8 @@ namespace smt {
             m_params(p),
             m_qi_queue(m_wrapper, ctx, p),
             m_qstat_gen(ctx.get_manager(), ctx.get_region()),
-            m_plugin(plugin) {
+            m_plugin(plugin),
+            m_instance_cache(ctx.get_manager()) {
             m_qi_queue.setup();
         }
 
@@ -160,6 +164,12 @@ namespace smt {
             return s ? s->get_data().get_value()->get_generation() : 0;
         }
 
+        void conflict_eh(quantifier * q) {
+            auto* s = m_quantifier_stat.find_core(q);
+            if (s)
+                s->get_data().get_value()->inc_num_conflicts();
+        }
+
         void add(quantifier * q, unsigned generation) {
             q::quantifier_stat * stat = m_qstat_gen(q, generation);
             m_quantifier_stat.insert(q, stat);
@@ -189,6 +199,8 @@ namespace smt {
                 out.width(3);
                 out << max_generation << " : " << max_cost << "\n";
             }
+            if (m_params.m_qi_adaptive && s->get_num_conflicts() > 0)
+                out << "[quantifier_conflicts] " << q->get_qid().str() << " : " << s->get_num_conflicts() << "\n";
         }
 
         void del(quantifier * q) {
@@ -197,6 +209,8 @@ namespace smt {
             }
             m_quantifiers.pop_back();
             m_quantifier_stat.erase(q);
+            if (m_quantifiers.empty())
+                m_instance_cache.reset();
         }
 
         bool empty() const {
@@ -328,6 +342,8 @@ namespace smt {
                 }
                 m_qi_queue.insert(f, pat, max_generation, min_top_generation, max_top_generation); // TODO
                 m_num_instances++;
+                if (m_params.m_qi_cache && !m_replaying)
+                    insert_instance_cache(q, *f, max_generation);
             }
 
             CTRACE(bindings, f != nullptr, 
@@ -341,6 +357,22 @@ namespace smt {
             return f != nullptr;
         }
 
+        /**
+           \brief Record the instance in the cache. When the cache reaches
+           qi.cache_max_size, keep only the instances that were derived again
+           for quantifiers that are still asserted, and clear it if that does
+           not free at least half of it.
+        */
+        void insert_instance_cache(quantifier * q, fingerprint const & f, unsigned generation) {
+            unsigned max_size = m_params.m_qi_cache_max_size;
+            if (m_instance_cache.size() >= max_size) {
+                m_instance_cache.compact([&](quantifier * q) { return m_quantifier_stat.contains(q); });
+                if (2 * m_instance_cache.size() >= max_size)
+                    m_instance_cache.reset();
+            }
+            m_instance_cache.insert(q, f, generation);
+        }
+
         void init_search_eh() {
             m_num_instances = 0;
             for (quantifier * q : m_quantifiers) {
@@ -348,9 +380,43 @@ namespace smt {
             }
             m_qi_queue.init_search_eh();
             m_plugin->init_search_eh();
+            if (m_replay_cache)
+                replay_cache();
             TRACE(smt_params, m_params.display(tout); );
         }
 
+        /**
+           \brief Re-assert the cached instances that were derived again at
+           least qi.cache_replay times, for the quantifiers that are still
+           asserted. The instances that are in the current scope are
+           filtered by the fingerprints.
+        */
+        void replay_cache() {
+            m_replay_cache = false;
+            flet<bool> _replaying(m_replaying, true);
+            ptr_buffer<enode> bindings;
+            vector<std::tuple<enode *, enode *>> dummy;
+            for (instance_cache::entry const & e : m_instance_cache.entries()) {
+                if (m_context.inconsistent())
+                    break;
+                quantifier * q = e.m_q;
+                if (e.m_hits < m_params.m_qi_cache_replay || !m_quantifier_stat.contains(q))
+                    continue;
+                if (!m_context.b_internalized(q) || m_context.get_assignment(q) != l_true)
+                    continue;
+                bindings.reset();
+                expr * const * exprs = m_instance_cache.get_bindings(e);
+                for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+                    if (!m_context.e_internalized(exprs[i]))
+                        m_context.internalize(exprs[i], false, e.m_generation);
+                    bindings.push_back(m_context.get_enode(exprs[i]));
+                }
+                unsigned gen = e.m_generation;
+                if (add_instance(q, nullptr, bindings.size(), bindings.data(), gen, gen, gen, dummy))
+                    m_instance_cache.inc_replays();
+            }
+        }
+
         void assign_eh(quantifier * q) {
             m_plugin->assign_eh(q);
         }
@@ -379,6 +445,7 @@ namespace smt {
         void pop(unsigned num_scopes) {
             m_plugin->pop(num_scopes);
             m_qi_queue.pop_scope(num_scopes);
+            m_replay_cache = m_params.m_qi_cache && m_instance_cache.size() > 0;
         }
 
         bool can_propagate() {
@@ -489,6 +556,10 @@ namespace smt {
         return m_imp->get_generation(q);
     }
 
+    void quantifier_manager::conflict_eh(quantifier * q) {
+        m_imp->conflict_eh(q);
+    }
+
     bool quantifier_manager::add_instance(quantifier * q, app * pat,
                                           unsigned num_bindings,
                                           enode * const * bindings,
@@ -590,6 +661,8 @@ namespace smt {
     void quantifier_manager::collect_statistics(::statistics & st) const {
         m_imp->m_qi_queue.collect_statistics(st);
         m_imp->m_plugin->collect_statistics(st);
+        if (m_imp->m_params.m_qi_cache)
+            m_imp->m_instance_cache.collect_statistics(st);
     }
 
     void quantifier_manager::reset_statistics() {
@@ -54,6 +54,7 @@ namespace smt {
 
         q::quantifier_stat * get_stat(quantifier * q) const;
         unsigned get_generation(quantifier * q) const;
+        void conflict_eh(quantifier * q);
 
         static void log_justification_to_root(std::ostream & log, enode *en, obj_hashtable<enode> &already_visited, context &ctx, ast_manager &m);
 
@@ -754,6 +754,39 @@ namespace smt {
     }
 
 
+    /**
+       \brief Multipliers and dividers are cached by the bits of their arguments
+       when bv.blast_cache is set. Terms that are internalized again after a pop
+       reuse the circuit expressions, but their gates still get new literals and
+       clauses, so the gain is limited to the construction of the circuit.
+    */
+    bool theory_bv::use_blast_cache(app * n) const {
+        if (!params().m_bv_blast_cache)
+            return false;
+        switch (n->get_decl_kind()) {
+        case OP_BMUL:
+        case OP_BUDIV_I:
+        case OP_BSDIV_I:
+        case OP_BUREM_I:
+        case OP_BSREM_I:
+        case OP_BSMOD_I:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool theory_bv::find_blast(app * n, expr_ref_vector const & arg1_bits, expr * const * arg2_bits, expr_ref_vector & bits) {
+        return use_blast_cache(n) && m_bb_cache.find(n->get_decl_kind(), arg1_bits.size(), arg1_bits.data(), arg2_bits, bits);
+    }
+
+    void theory_bv::insert_blast(app * n, expr_ref_vector const & arg1_bits, expr * const * arg2_bits, expr_ref_vector const & bits) {
+        if (use_blast_cache(n)) {
+            m_bb_cache.set_max_size(params().m_bv_blast_cache_max_size);
+            m_bb_cache.insert(n->get_decl_kind(), arg1_bits.size(), arg1_bits.data(), arg2_bits, bits);
+        }
+    }
+
 #define MK_UNARY(NAME, BLAST_OP)                                        \
     void theory_bv::NAME(app * n) {                                     \
         SASSERT(!ctx.e_internalized(n));                      \
@@ -776,7 +809,10 @@ namespace smt {
         get_arg_bits(e, 0, arg1_bits);                                                  \
         get_arg_bits(e, 1, arg2_bits);                                                  \
         SASSERT(arg1_bits.size() == arg2_bits.size());                                  \
-        m_bb.BLAST_OP(arg1_bits.size(), arg1_bits.data(), arg2_bits.data(), bits);    \
+        if (!find_blast(n, arg1_bits, arg2_bits.data(), bits)) {                        \
+            m_bb.BLAST_OP(arg1_bits.size(), arg1_bits.data(), arg2_bits.data(), bits);  \
+            insert_blast(n, arg1_bits, arg2_bits.data(), bits);                         \
+        }                                                                               \
         init_bits(e, bits);                                                             \
     }
 
@@ -799,7 +835,10 @@ namespace smt {
             get_arg_bits(e, i, arg_bits);                                                       \
             SASSERT(arg_bits.size() == bits.size());                                            \
             new_bits.reset();                                                                   \
-            m_bb.BLAST_OP(arg_bits.size(), arg_bits.data(), bits.data(), new_bits);           \
+            if (!find_blast(n, arg_bits, bits.data(), new_bits)) {                              \
+                m_bb.BLAST_OP(arg_bits.size(), arg_bits.data(), bits.data(), new_bits);         \
+                insert_blast(n, arg_bits, bits.data(), new_bits);                               \
+            }                                                                                   \
             bits.swap(new_bits);                                                                \
         }                                                                                       \
         init_bits(e, bits);                                                                     \
@@ -1488,9 +1527,14 @@ namespace smt {
         pop_scope_eh(m_trail_stack.get_num_scopes());
         m_bool_var2atom.reset();
         m_fixed_var_table.reset();
+        m_bb_cache.reset();
         theory::reset_eh();
     }
 
+    void theory_bv::flush_eh() {
+        m_bb_cache.reset();
+    }
+
     bool theory_bv::include_func_interp(func_decl* f) {
         SASSERT(f->get_family_id() == get_family_id());
         switch (f->get_decl_kind()) {
@@ -1515,6 +1559,7 @@ namespace smt {
         m_util(ctx.get_manager()),
         m_autil(ctx.get_manager()),
         m_bb(ctx.get_manager(), ctx.get_fparams()),
+        m_bb_cache(ctx.get_manager()),
         m_trail_stack(),
         m_find(*this),
         m_approximates_large_bvs(false) {
@@ -1912,6 +1957,8 @@ namespace smt {
         st.update("bv bit2core", m_stats.m_num_bit2core);
         st.update("bv->core eq", m_stats.m_num_th2core_eq);
         st.update("bv dynamic eqs", m_stats.m_num_eq_dynamic);
+        if (params().m_bv_blast_cache)
+            m_bb_cache.collect_statistics(st);
     }
 
     theory_bv::var_enode_pos theory_bv::get_bv_with_theory(bool_var v, theory_id id) const {
@@ -19,6 +19,7 @@ Revision History:
 #pragma once
 
 #include "ast/rewriter/bit_blaster/bit_blaster.h"
+#include "ast/rewriter/bit_blaster/bit_blaster_cache.h"
 #include "util/trail.h"
 #include "util/union_find.h"
 #include "ast/arith_decl_plugin.h"
@@ -104,6 +105,7 @@ namespace smt {
         bv_util                  m_util;
         arith_util               m_autil;
         bit_blaster              m_bb;
+        bit_blaster_cache        m_bb_cache;
         trail_stack              m_trail_stack;
         th_union_find            m_find;
         vector<literal_vector>   m_bits;     // per var, the bits of a given variable.
@@ -155,6 +157,9 @@ namespace smt {
         friend class mk_atom_trail;
         void mk_bit2bool(app * n);
         void process_args(app * n);
+        bool use_blast_cache(app * n) const;
+        bool find_blast(app * n, expr_ref_vector const & arg1_bits, expr * const * arg2_bits, expr_ref_vector & bits);
+        void insert_blast(app * n, expr_ref_vector const & arg1_bits, expr * const * arg2_bits, expr_ref_vector const & bits);
         enode * mk_enode(app * n);
         theory_var get_var(enode * n);
         enode * get_arg(enode * n, unsigned idx);
@@ -246,6 +251,7 @@ namespace smt {
         void pop_scope_eh(unsigned num_scopes) override;
         final_check_status final_check_eh(unsigned) override;
         void reset_eh() override;
+        void flush_eh() override;
         bool include_func_interp(func_decl* f) override;
         svector<theory_var>   m_merge_aux[2]; //!< auxiliary vector used in merge_zero_one_bits
         bool merge_zero_one_bits(theory_var r1, theory_var r2);
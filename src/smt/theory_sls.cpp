@@ -80,13 +80,19 @@ namespace smt {
         m_init_search = true;
     }
 
-    void theory_sls::finalize() const {
+    void theory_sls::finalize() {
+        for (auto* w : m_walkers) {
+            model_ref mdl;
+            w->finalize(mdl, m_st);
+        }
+        m_walkers.reset();
         if (!m_smt_plugin)
             return;
         m_smt_plugin->finalize(m_model, m_st);
         m_model = nullptr;
         m_smt_plugin = nullptr;        
         m_init_search = false;
+        m_checking = false;
     }
 
     void theory_sls::propagate() {
@@ -102,6 +108,11 @@ namespace smt {
             vector<sat::literal_vector> clauses;
             m_smt_plugin->check(fmls, clauses);
             m_smt_plugin->get_shared_clauses(m_shared_clauses);
+            start_walkers(fmls);
+        }
+        else if (m_parallel_mode && !m_walkers.empty()) {
+            check_walkers();
+            propagate_local_search();
         }
         else if (m_parallel_mode && m_smt_plugin->completed()) {
             m_smt_plugin->finalize(m_model, m_st);
@@ -113,14 +124,115 @@ namespace smt {
         
     }    
 
+    void theory_sls::start_walkers(expr_ref_vector const& fmls) {
+        if (!m_parallel_mode)
+            return;
+        vector<sat::literal_vector> clauses;
+        for (unsigned i = 1; i < m_num_threads; ++i) {
+            auto* w = alloc(sls::smt_plugin, *this);
+            w->set_seed_offset(i);
+            w->check(fmls, clauses);
+            m_walkers.push_back(w);
+        }
+        // the walkers start from the initial values of the SMT engine
+        if (!m_walkers.empty())
+            smt_values_to_sls();
+    }
+
+    /**
+     * The values and phase of the walker with the fewest unsatisfied clauses
+     * among those that saved a new assignment are handed to the SMT engine
+     * and to the other walkers.
+     */
+    void theory_sls::exchange_best_assignment() {
+        sls::smt_plugin* best = nullptr;
+        auto consider = [&](sls::smt_plugin* w) {
+            if (w->has_new_sls_values() && (!best || w->min_unsat_size() < best->min_unsat_size()))
+                best = w;
+        };
+        consider(m_smt_plugin);
+        for (auto* w : m_walkers)
+            consider(w);
+        vector<std::pair<expr_ref, expr_ref>> values;
+        if (!best || !best->get_sls_values(values))
+            return;
+        sat::literal_vector phase;
+        best->get_sls_phase(phase);
+        ++m_stats.m_num_best_exchanges;
+        for (auto const& [t, v] : values)
+            set_value(t, v);
+        for (auto lit : phase)
+            force_phase(lit);
+        auto to_walker = [&](sls::smt_plugin* w) {
+            if (w == best)
+                return;
+            w->values_to_sls(values);
+            w->phase_to_sls(phase);
+            ++m_stats.m_num_walker_values;
+        };
+        to_walker(m_smt_plugin);
+        for (auto* w : m_walkers)
+            to_walker(w);
+    }
+
+    /**
+     * The first walker that finds a model wins and the others are canceled.
+     * Walkers that give up are dropped, and if the primary walker gives up
+     * another walker takes its place in the exchange with the SMT engine.
+     */
+    void theory_sls::check_walkers() {
+        auto* winner = m_smt_plugin->completed() && m_smt_plugin->result() == l_true ? m_smt_plugin : nullptr;
+        for (auto* w : m_walkers)
+            if (!winner && w->completed() && w->result() == l_true)
+                winner = w;
+        if (winner) {
+            winner->finalize(m_model, m_st);
+            m_walkers.push_back(m_smt_plugin);
+            for (auto* w : m_walkers) {
+                model_ref mdl;
+                if (w != winner)
+                    w->finalize(mdl, m_st);
+            }
+            m_walkers.reset();
+            m_smt_plugin = nullptr;
+            m_init_search = false;
+            return;
+        }
+        unsigned j = 0;
+        for (auto* w : m_walkers) {
+            if (w->completed()) {
+                model_ref mdl;
+                w->finalize(mdl, m_st);
+            }
+            else
+                m_walkers[j++] = w;
+        }
+        m_walkers.shrink(j);
+        if (m_smt_plugin->completed()) {
+            m_smt_plugin->finalize(m_model, m_st);
+            m_smt_plugin = nullptr;
+            if (m_walkers.empty()) {
+                m_init_search = false;
+                return;
+            }
+            m_smt_plugin = m_walkers.back();
+            m_walkers.pop_back();
+            m_smt_plugin->get_shared_clauses(m_shared_clauses);
+        }
+        exchange_best_assignment();
+    }
+
     void theory_sls::pop_scope_eh(unsigned n) {
         if (!m_smt_plugin)
             return;
         
         if (ctx.get_search_level() == ctx.get_scope_level() - n) {
             auto& lits = ctx.assigned_literals();
-            for (; m_trail_lim < lits.size() && ctx.get_assign_level(lits[m_trail_lim]) == ctx.get_search_level(); ++m_trail_lim) 
-                m_smt_plugin->add_unit(lits[m_trail_lim]);            
+            for (; m_trail_lim < lits.size() && ctx.get_assign_level(lits[m_trail_lim]) == ctx.get_search_level(); ++m_trail_lim) {
+                m_smt_plugin->add_unit(lits[m_trail_lim]);
+                for (auto* w : m_walkers)
+                    w->add_unit(lits[m_trail_lim]);
+            }
         }
 
         check_for_unassigned_clause_after_resolve();
@@ -155,7 +267,7 @@ namespace smt {
 
     void theory_sls::update_propagation_scope() {
         if (m_propagation_scope > ctx.get_scope_level() && m_propagation_scope == m_max_propagation_scope) {
-            m_smt_plugin->smt_values_to_sls();
+            smt_values_to_sls();
         }
         m_propagation_scope = ctx.get_scope_level();
         m_max_propagation_scope = std::max(m_max_propagation_scope, m_propagation_scope);
@@ -181,10 +293,29 @@ namespace smt {
         run_guided_sls();
     }
 
-    void theory_sls::run_guided_sls() {
+    /**
+     * Hand the current SMT values to the primary walker and to every other walker
+     * of the portfolio.
+     */
+    void theory_sls::smt_values_to_sls() {
         m_smt_plugin->smt_values_to_sls();
-        if (m_parallel_mode) 
+        for (auto* w : m_walkers) {
+            w->smt_values_to_sls();
+            ++m_stats.m_num_walker_values;
+        }
+    }
+
+    /**
+     * In parallel mode the walkers run on their own threads, so guiding them
+     * only exchanges values and phases. Otherwise the primary walker runs for
+     * a bounded number of steps.
+     */
+    void theory_sls::run_guided_sls() {
+        smt_values_to_sls();
+        if (m_parallel_mode) {
+            exchange_best_assignment();
             return;
+        }
         
         ++m_stats.m_num_guided_sls;
         m_smt_plugin->smt_phase_to_sls();
@@ -205,16 +336,18 @@ namespace smt {
             finalize();
         smt_params p(ctx.get_fparams());
         m_parallel_mode = p.m_sls_parallel;
+        m_num_threads = std::max(1u, p.m_sls_threads);
         m_smt_plugin = nullptr;
         m_checking = false;
         m_init_search = false;
     }
 
     void theory_sls::collect_statistics(::statistics& st) const {
-        finalize();
         st.copy(m_st);
         st.update("sls-num-guided-search", m_stats.m_num_guided_sls);
         st.update("sls-num-restart-search", m_stats.m_num_restart_sls);
+        st.update("sls-num-walker-values", m_stats.m_num_walker_values);
+        st.update("sls-num-best-exchanges", m_stats.m_num_best_exchanges);
     }
 
     void theory_sls::restart_eh() {
@@ -31,6 +31,7 @@ namespace smt {
     public:
         theory_sls(context& ctx);
         model_ref get_model() { return m_model; }
+        void finalize() {}
         char const* get_name() const override { return "sls"; }
         smt::theory* mk_fresh(context* new_ctx) override { return alloc(theory_sls, *new_ctx); }
         void display(std::ostream& out) const override {}
@@ -52,10 +53,15 @@ namespace smt {
         struct stats {
             unsigned m_num_guided_sls = 0;
             unsigned m_num_restart_sls = 0;
+            unsigned m_num_walker_values = 0;
+            unsigned m_num_best_exchanges = 0;
         };
         stats m_stats;
-        mutable model_ref m_model;
-        mutable sls::smt_plugin* m_smt_plugin = nullptr;
+        model_ref m_model;
+        sls::smt_plugin* m_smt_plugin = nullptr;
+        // further walkers of the portfolio in parallel mode, with other seeds
+        ptr_vector<sls::smt_plugin> m_walkers;
+        unsigned m_num_threads = 1;
         unsigned m_trail_lim = 0;
         bool m_checking = false;
         bool m_parallel_mode = true;
@@ -73,8 +79,8 @@ namespace smt {
         unsigned m_resolve_gap = 0;
         unsigned m_max_propagation_scope = 0;
         unsigned m_propagation_scope = 0;
-        mutable bool     m_init_search = false;
-        mutable ::statistics m_st;
+        bool     m_init_search = false;
+        ::statistics m_st;
         vector<sat::literal_vector> m_shared_clauses;
 
 
@@ -93,7 +99,10 @@ namespace smt {
         void propagate_local_search();
 
         void run_guided_sls();
-        void finalize() const;
+        void smt_values_to_sls();
+        void start_walkers(expr_ref_vector const& fmls);
+        void check_walkers();
+        void exchange_best_assignment();
 
         void update_propagation_scope();
 
@@ -103,6 +112,9 @@ namespace smt {
 
         model_ref get_model() { return m_model; }
 
+        // stop the walkers at the end of a search and collect their statistics
+        void finalize();
+
         // smt::theory interface
         char const* get_name() const override { return "sls"; }
         void init() override;
@@ -0,0 +1,715 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    query_cache_solver.cpp
+
+Abstract:
+
+    Implements a solver that caches check-sat results in a file.
+
+--*/
+
+#include "solver/solver.h"
+#include "solver/query_cache_solver.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/ast_translation.h"
+#include "model/model.h"
+#include "params/solver_params.hpp"
+#include <algorithm>
+#include <fstream>
+
+// ------------------------------------
+// query_canonizer
+
+unsigned query_canonizer::shape(app* a) const {
+    func_decl* f = a->get_decl();
+    if (is_uninterp_const(a))
+        return hash_u_u(a->get_sort()->get_name().hash(), 17);
+    unsigned h = hash_u_u(f->get_name().hash(), a->get_num_args());
+    for (parameter const& p : f->parameters()) {
+        if (p.is_int())
+            h = combine_hash(h, static_cast<unsigned>(p.get_int()));
+        else if (p.is_rational())
+            h = combine_hash(h, p.get_rational().hash());
+        else if (p.is_symbol())
+            h = combine_hash(h, p.get_symbol().hash());
+    }
+    if (f->is_commutative()) {
+        unsigned_vector hs;
+        for (expr* arg : *a)
+            hs.push_back(m_shape[arg]);
+        std::sort(hs.begin(), hs.end());
+        for (unsigned ha : hs)
+            h = combine_hash(h, ha);
+    }
+    else {
+        for (expr* arg : *a)
+            h = combine_hash(h, m_shape[arg]);
+    }
+    return h;
+}
+
+bool query_canonizer::compute_shape(expr* e) {
+    m_todo.push_back(e);
+    while (!m_todo.empty()) {
+        expr* t = m_todo.back();
+        if (m_shape.contains(t)) {
+            m_todo.pop_back();
+            continue;
+        }
+        if (!is_app(t)) {
+            m_todo.reset();
+            return false;
+        }
+        app* a = to_app(t);
+        bool visited = true;
+        for (expr* arg : *a) {
+            if (!m_shape.contains(arg)) {
+                m_todo.push_back(arg);
+                visited = false;
+            }
+        }
+        if (!visited)
+            continue;
+        m_todo.pop_back();
+        m_shape.insert(t, shape(a));
+    }
+    return true;
+}
+
+void query_canonizer::sort_by_shape(ptr_vector<expr>& es) const {
+    std::stable_sort(es.begin(), es.end(), [&](expr* a, expr* b) {
+        return m_shape[a] < m_shape[b];
+    });
+}
+
+void query_canonizer::sorted_args(app* a, ptr_buffer<expr>& args) const {
+    args.reset();
+    args.append(a->get_num_args(), a->get_args());
+    if (a->get_decl()->is_commutative())
+        std::stable_sort(args.begin(), args.end(), [&](expr* x, expr* y) {
+            return m_shape[x] < m_shape[y];
+        });
+}
+
+void query_canonizer::display_symbol(symbol const& s) {
+    if (s.is_numerical())
+        m_out << 'N' << s.get_num();
+    else if (s.is_null())
+        m_out << 'Z';
+    else {
+        std::string str = s.str();
+        m_out << 'S' << str.size() << ':' << str;
+    }
+}
+
+bool query_canonizer::display_param(parameter const& p) {
+    if (p.is_int())
+        m_out << 'i' << p.get_int();
+    else if (p.is_rational())
+        m_out << 'q' << p.get_rational();
+    else if (p.is_symbol()) {
+        m_out << 's';
+        display_symbol(p.get_symbol());
+    }
+    else if (p.is_ast() && is_sort(p.get_ast())) {
+        m_out << 't';
+        return display_sort(to_sort(p.get_ast()));
+    }
+    else
+        return false;
+    return true;
+}
+
+bool query_canonizer::display_sort(sort* s) {
+    display_symbol(s->get_name());
+    if (s->get_num_parameters() == 0)
+        return true;
+    m_out << '[';
+    for (parameter const& p : s->parameters()) {
+        if (!display_param(p))
+            return false;
+        m_out << ',';
+    }
+    m_out << ']';
+    return true;
+}
+
+bool query_canonizer::emit_head(app* a) {
+    func_decl* f = a->get_decl();
+    if (is_uninterp_const(a)) {
+        unsigned idx;
+        if (!m_const2idx.find(f, idx)) {
+            idx = m_consts.size();
+            m_consts.push_back(f);
+            m_const2idx.insert(f, idx);
+        }
+        m_out << 'c' << idx;
+    }
+    else {
+        if (f->get_family_id() == null_family_id) {
+            m_has_uninterp_funs = true;
+            m_out << 'u';
+            display_symbol(f->get_name());
+            m_out << '(';
+            for (sort* s : *f) {
+                if (!display_sort(s))
+                    return false;
+                m_out << ',';
+            }
+            m_out << ')';
+        }
+        else {
+            m_out << 'f';
+            display_symbol(m.get_family_name(f->get_family_id()));
+            display_symbol(f->get_name());
+        }
+        if (f->get_num_parameters() > 0) {
+            m_out << '[';
+            for (parameter const& p : f->parameters()) {
+                if (!display_param(p))
+                    return false;
+                m_out << ',';
+            }
+            m_out << ']';
+        }
+    }
+    m_out << ':';
+    return display_sort(a->get_sort());
+}
+
+/**
+   \brief Emit the sub-terms of e in post-order. Each term is assigned
+   the position of its definition, which is used to refer to it,
+   such that shared sub-terms are printed once.
+*/
+bool query_canonizer::emit(expr* e) {
+    ptr_buffer<expr> args;
+    m_todo.push_back(e);
+    while (!m_todo.empty()) {
+        expr* t = m_todo.back();
+        if (m_index.contains(t)) {
+            m_todo.pop_back();
+            continue;
+        }
+        app* a = to_app(t);
+        sorted_args(a, args);
+        bool visited = true;
+        for (unsigned i = args.size(); i-- > 0; ) {
+            if (!m_index.contains(args[i])) {
+                m_todo.push_back(args[i]);
+                visited = false;
+            }
+        }
+        if (!visited)
+            continue;
+        m_todo.pop_back();
+        if (!emit_head(a)) {
+            m_todo.reset();
+            return false;
+        }
+        for (expr* arg : args)
+            m_out << ' ' << m_index[arg];
+        m_out << ";";
+        m_index.insert(t, m_index.size());
+    }
+    return true;
+}
+
+bool query_canonizer::operator()(expr_ref_vector const& fmls, expr_ref_vector const& asms, std::string& key) {
+    for (expr* f : fmls)
+        if (!compute_shape(f))
+            return false;
+    for (expr* a : asms)
+        if (!compute_shape(a))
+            return false;
+
+    // assertions are a set, assumptions are ordered because
+    // unsat cores refer to them by position.
+    ptr_vector<expr> roots;
+    expr_fast_mark1 seen;
+    for (expr* f : fmls) {
+        if (!seen.is_marked(f)) {
+            seen.mark(f);
+            roots.push_back(f);
+        }
+    }
+    sort_by_shape(roots);
+
+    for (expr* f : roots)
+        if (!emit(f))
+            return false;
+    for (expr* a : asms)
+        if (!emit(a))
+            return false;
+    m_out << "|A";
+    for (expr* f : roots)
+        m_out << ' ' << m_index[f];
+    m_out << "|S";
+    for (expr* a : asms)
+        m_out << ' ' << m_index[a];
+    key = std::move(m_out).str();
+    return true;
+}
+
+// ------------------------------------
+// query_cache
+
+static char const* query_cache_header = "z3-query-cache 1";
+
+static lbool int2lbool(int r) {
+    return r == 1 ? l_true : (r == -1 ? l_false : l_undef);
+}
+
+/**
+   \brief Read the entry at the current position of in.
+   Return false at the end of the log or at a truncated entry, caused by an
+   interrupted write.
+*/
+static bool read_entry(std::istream& in, std::string& key, query_cache_entry& e) {
+    int result;
+    size_t key_len;
+    unsigned num_values, num_core;
+    if (!(in >> result >> key_len >> num_values >> num_core) || in.get() != '\n')
+        return false;
+    key.resize(key_len);
+    if (!in.read(key.data(), key_len) || in.get() != '\n')
+        return false;
+    e = query_cache_entry();
+    e.m_result = int2lbool(result);
+    for (unsigned i = 0; i < num_values; ++i) {
+        unsigned idx;
+        std::string value;
+        if (!(in >> idx >> value))
+            return false;
+        e.m_value_idx.push_back(idx);
+        e.m_values.push_back(std::move(value));
+    }
+    for (unsigned i = 0; i < num_core; ++i) {
+        unsigned pos;
+        if (!(in >> pos))
+            return false;
+        e.m_core.push_back(pos);
+    }
+    return in.get() == '\n' && e.m_result != l_undef;
+}
+
+uint64_t query_cache::key_hash(std::string const& key) {
+    return (static_cast<uint64_t>(string_hash(key, 17)) << 32) | string_hash(key, 31);
+}
+
+void query_cache::load() {
+    if (m_loaded)
+        return;
+    m_loaded = true;
+    m_in.open(m_file, std::ios::binary);
+    if (!m_in)
+        return;
+    std::string line;
+    if (!std::getline(m_in, line))
+        return;
+    if (line != query_cache_header) {
+        IF_VERBOSE(1, verbose_stream() << "(query-cache ignoring " << m_file << ": not a query cache)\n");
+        m_writable = false;
+        m_in.close();
+        return;
+    }
+    query_cache_entry e;
+    while (true) {
+        uint64_t offset = static_cast<uint64_t>(m_in.tellg());
+        if (!read_entry(m_in, m_key, e))
+            break;
+        m_index.emplace(key_hash(m_key), offset);
+    }
+}
+
+bool query_cache::find(std::string const& key, query_cache_entry& e) {
+    load();
+    auto [begin, end] = m_index.equal_range(key_hash(key));
+    for (auto it = begin; it != end; ++it) {
+        m_in.clear();
+        m_in.seekg(static_cast<std::streamoff>(it->second));
+        if (read_entry(m_in, m_key, e) && m_key == key)
+            return true;
+    }
+    return false;
+}
+
+void query_cache::insert(std::string const& key, query_cache_entry const& e) {
+    query_cache_entry old;
+    if (!m_writable || find(key, old))
+        return;
+    std::ofstream out(m_file, std::ios::binary | std::ios::app);
+    if (!out) {
+        IF_VERBOSE(1, verbose_stream() << "(query-cache could not open " << m_file << ")\n");
+        m_writable = false;
+        return;
+    }
+    out.seekp(0, std::ios::end);
+    if (out.tellp() == 0)
+        out << query_cache_header << "\n";
+    uint64_t offset = static_cast<uint64_t>(out.tellp());
+    out << (e.m_result == l_true ? 1 : -1) << ' ' << key.size() << ' ' << e.m_values.size() << ' ' << e.m_core.size() << '\n';
+    out << key << '\n';
+    for (unsigned i = 0; i < e.m_values.size(); ++i)
+        out << e.m_value_idx[i] << ' ' << e.m_values[i] << '\n';
+    for (unsigned pos : e.m_core)
+        out << pos << ' ';
+    out << '\n';
+    out.close();
+    if (!out)
+        return;
+    if (!m_in.is_open())
+        m_in.open(m_file, std::ios::binary);
+    m_index.emplace(key_hash(key), offset);
+}
+
+// ------------------------------------
+// query_cache_solver
+
+/**
+   \brief Serialize a model value of Boolean, arithmetic or bit-vector sort.
+*/
+static bool serialize_value(ast_manager& m, expr* v, std::string& out) {
+    arith_util a(m);
+    bv_util bv(m);
+    rational r;
+    bool is_int;
+    unsigned sz;
+    if (m.is_true(v))
+        out = "b1";
+    else if (m.is_false(v))
+        out = "b0";
+    else if (a.is_numeral(v, r, is_int))
+        out = (is_int ? "i" : "r") + r.to_string();
+    else if (bv.is_numeral(v, r, sz))
+        out = "v" + r.to_string();
+    else
+        return false;
+    return true;
+}
+
+static expr_ref parse_value(ast_manager& m, sort* s, std::string const& v) {
+    arith_util a(m);
+    bv_util bv(m);
+    expr_ref r(m);
+    if (v.empty())
+        return r;
+    char const* num = v.c_str() + 1;
+    switch (v[0]) {
+    case 'b':
+        if (m.is_bool(s))
+            r = m.mk_bool_val(v == "b1");
+        break;
+    case 'i':
+    case 'r':
+        if (a.is_int_real(s) && a.is_int(s) == (v[0] == 'i'))
+            r = a.mk_numeral(rational(num), a.is_int(s));
+        break;
+    case 'v':
+        if (bv.is_bv_sort(s))
+            r = bv.mk_numeral(rational(num), s);
+        break;
+    default:
+        break;
+    }
+    return r;
+}
+
+class query_cache_solver : public solver {
+    struct stats {
+        unsigned m_num_hits = 0;
+        unsigned m_num_misses = 0;
+        unsigned m_num_bypass = 0;
+        unsigned m_num_stored = 0;
+    };
+    ast_manager&     m;
+    solver_ref       s;
+    std::string      m_file;
+    scoped_ptr<query_cache> m_cache;
+    expr_ref_vector  m_assertions;
+    unsigned_vector  m_assertions_lim;
+    unsigned         m_num_tracked = 0;
+    unsigned_vector  m_num_tracked_lim;
+    bool             m_has_user_propagator = false;
+    bool             m_from_cache = false;
+    model_ref        m_model;
+    expr_ref_vector  m_core;
+    stats            m_stats;
+
+    bool restore(query_cache_entry const& e, ptr_vector<func_decl> const& consts, unsigned n, expr* const* asms) {
+        m_model = nullptr;
+        m_core.reset();
+        if (e.m_result == l_true) {
+            model_ref mdl = alloc(model, m);
+            for (unsigned i = 0; i < e.m_values.size(); ++i) {
+                unsigned idx = e.m_value_idx[i];
+                if (idx >= consts.size())
+                    return false;
+                expr_ref v = parse_value(m, consts[idx]->get_range(), e.m_values[i]);
+                if (!v)
+                    return false;
+                mdl->register_decl(consts[idx], v);
+            }
+            m_model = mdl;
+        }
+        else {
+            for (unsigned pos : e.m_core) {
+                if (pos >= n)
+                    return false;
+                m_core.push_back(asms[pos]);
+            }
+        }
+        return true;
+    }
+
+    void store(lbool r, query_canonizer const& canon, std::string const& key, unsigned n, expr* const* asms) {
+        query_cache_entry e;
+        e.m_result = r;
+        if (r == l_true) {
+            model_ref mdl;
+            s->get_model(mdl);
+            if (!mdl || canon.has_uninterpreted_functions())
+                return;
+            auto const& consts = canon.consts();
+            std::string value;
+            for (unsigned i = 0; i < consts.size(); ++i) {
+                expr* v = mdl->get_const_interp(consts[i]);
+                if (!v)
+                    continue;
+                if (!serialize_value(m, v, value))
+                    return;
+                e.m_value_idx.push_back(i);
+                e.m_values.push_back(value);
+            }
+        }
+        else if (r == l_false) {
+            expr_ref_vector core(m);
+            s->get_unsat_core(core);
+            // an empty core under assumptions is also what solvers without
+            // core extraction report, so it is not trusted.
+            if (n > 0 && core.empty())
+                return;
+            for (expr* c : core) {
+                unsigned pos = 0;
+                while (pos < n && asms[pos] != c)
+                    ++pos;
+                if (pos == n)
+                    return;
+                e.m_core.push_back(pos);
+            }
+        }
+        else
+            return;
+        m_cache->insert(key, e);
+        ++m_stats.m_num_stored;
+    }
+
+public:
+
+    query_cache_solver(solver* s, std::string const& file) :
+        solver(s->get_manager()),
+        m(s->get_manager()),
+        s(s),
+        m_file(file),
+        m_cache(alloc(query_cache, file)),
+        m_assertions(m),
+        m_core(m) {
+    }
+
+    void assert_expr_core2(expr* t, expr* a) override {
+        if (!a)
+            assert_expr_core(t);
+        else {
+            // tracked assertions contribute to unsat cores by name and are not cached.
+            ++m_num_tracked;
+            s->assert_expr(t, a);
+        }
+    }
+
+    void assert_expr_core(expr* t) override {
+        m_assertions.push_back(t);
+        s->assert_expr(t);
+    }
+
+    void push() override {
+        m_assertions_lim.push_back(m_assertions.size());
+        m_num_tracked_lim.push_back(m_num_tracked);
+        s->push();
+    }
+
+    void pop(unsigned n) override {
+        unsigned lvl = m_assertions_lim.size() - n;
+        m_assertions.shrink(m_assertions_lim[lvl]);
+        m_num_tracked = m_num_tracked_lim[lvl];
+        m_assertions_lim.shrink(lvl);
+        m_num_tracked_lim.shrink(lvl);
+        s->pop(n);
+    }
+
+    lbool check_sat_core(unsigned num_assumptions, expr* const* assumptions) override {
+        m_from_cache = false;
+        query_canonizer canon(m);
+        std::string key;
+        expr_ref_vector asms(m, num_assumptions, assumptions);
+        if (m_file.empty() || m_num_tracked > 0 || m_has_user_propagator || !canon(m_assertions, asms, key)) {
+            ++m_stats.m_num_bypass;
+            return s->check_sat_core(num_assumptions, assumptions);
+        }
+        query_cache_entry e;
+        if (m_cache->find(key, e) && restore(e, canon.consts(), num_assumptions, assumptions)) {
+            ++m_stats.m_num_hits;
+            m_from_cache = true;
+            return e.m_result;
+        }
+        ++m_stats.m_num_misses;
+        lbool r = s->check_sat_core(num_assumptions, assumptions);
+        store(r, canon, key, num_assumptions, assumptions);
+        return r;
+    }
+
+    void collect_statistics_core(statistics& st) const override {
+        s->collect_statistics(st);
+        st.update("query-cache hits", m_stats.m_num_hits);
+        st.update("query-cache misses", m_stats.m_num_misses);
+        st.update("query-cache bypass", m_stats.m_num_bypass);
+        st.update("query-cache stored", m_stats.m_num_stored);
+    }
+
+    void get_model_core(model_ref& mdl) override {
+        if (m_from_cache)
+            mdl = m_model;
+        else
+            s->get_model_core(mdl);
+    }
+
+    proof* get_proof_core() override { return m_from_cache ? nullptr : s->get_proof(); }
+
+    void get_unsat_core(expr_ref_vector& r) override {
+        if (m_from_cache)
+            r.append(m_core);
+        else
+            s->get_unsat_core(r);
+    }
+
+    solver* translate(ast_manager& m, params_ref const& p) override {
+        solver* new_s = s->translate(m, p);
+        query_cache_solver* result = alloc(query_cache_solver, new_s, m_file);
+        ast_translation tr(get_manager(), m);
+        unsigned i = 0;
+        for (unsigned lim : m_assertions_lim) {
+            for (; i < lim; ++i)
+                result->m_assertions.push_back(tr(m_assertions.get(i)));
+            result->m_assertions_lim.push_back(lim);
+        }
+        for (; i < m_assertions.size(); ++i)
+            result->m_assertions.push_back(tr(m_assertions.get(i)));
+        result->m_num_tracked = m_num_tracked;
+        result->m_num_tracked_lim.append(m_num_tracked_lim);
+        return result;
+    }
+
+    void updt_params(params_ref const& p) override {
+        s->updt_params(p);
+        if (!p.contains("cache.file"))
+            return;
+        std::string file = solver_params(p).cache_file().str();
+        if (file != m_file) {
+            m_file = file;
+            m_cache = alloc(query_cache, file);
+        }
+    }
+
+    model_converter_ref get_model_converter() const override { return m_from_cache ? model_converter_ref() : s->get_model_converter(); }
+
+    unsigned get_num_assertions() const override { return s->get_num_assertions(); }
+    expr* get_assertion(unsigned idx) const override { return s->get_assertion(idx); }
+    std::string reason_unknown() const override { return s->reason_unknown(); }
+    void set_reason_unknown(char const* msg) override { s->set_reason_unknown(msg); }
+    void get_labels(svector<symbol>& r) override { s->get_labels(r); }
+    ast_manager& get_manager() const override { return s->get_manager(); }
+    void reset_params(params_ref const& p) override { s->reset_params(p); }
+    params_ref const& get_params() const override { return s->get_params(); }
+    void collect_param_descrs(param_descrs& r) override { s->collect_param_descrs(r); }
+    void push_params() override { s->push_params(); }
+    void pop_params() override { s->pop_params(); }
+    void set_produce_models(bool f) override { s->set_produce_models(f); }
+    void set_phase(expr* e) override { s->set_phase(e); }
+    void move_to_front(expr* e) override { s->move_to_front(e); }
+    phase* get_phase() override { return s->get_phase(); }
+    void set_phase(phase* p) override { s->set_phase(p); }
+    unsigned get_num_assumptions() const override { return s->get_num_assumptions(); }
+    expr* get_assumption(unsigned idx) const override { return s->get_assumption(idx); }
+    unsigned get_scope_level() const override { return s->get_scope_level(); }
+    void set_progress_callback(progress_callback* callback) override { s->set_progress_callback(callback); }
+
+    lbool get_consequences(expr_ref_vector const& asms, expr_ref_vector const& vars, expr_ref_vector& consequences) override {
+        m_from_cache = false;
+        return s->get_consequences(asms, vars, consequences);
+    }
+
+    lbool check_sat_cc(expr_ref_vector const& cube, vector<expr_ref_vector> const& clauses) override {
+        m_from_cache = false;
+        return s->check_sat_cc(cube, clauses);
+    }
+
+    lbool find_mutexes(expr_ref_vector const& vars, vector<expr_ref_vector>& mutexes) override {
+        return s->find_mutexes(vars, mutexes);
+    }
+
+    lbool preferred_sat(expr_ref_vector const& asms, vector<expr_ref_vector>& cores) override {
+        m_from_cache = false;
+        return s->preferred_sat(asms, cores);
+    }
+
+    expr_ref_vector cube(expr_ref_vector& vars, unsigned backtrack_level) override {
+        return s->cube(vars, backtrack_level);
+    }
+
+    expr* congruence_root(expr* e) override { return s->congruence_root(e); }
+    expr* congruence_next(expr* e) override { return s->congruence_next(e); }
+    expr_ref congruence_explain(expr* a, expr* b) override { return s->congruence_explain(a, b); }
+    std::ostream& display(std::ostream& out, unsigned n, expr* const* assumptions) const override {
+        return s->display(out, n, assumptions);
+    }
+    void get_units_core(expr_ref_vector& units) override { s->get_units_core(units); }
+    expr_ref_vector get_trail(unsigned max_level) override { return s->get_trail(max_level); }
+    void get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) override { s->get_levels(vars, depth); }
+
+    void register_on_clause(void* ctx, user_propagator::on_clause_eh_t& on_clause) override {
+        s->register_on_clause(ctx, on_clause);
+    }
+
+    void user_propagate_init(
+        void*                ctx,
+        user_propagator::push_eh_t&   push_eh,
+        user_propagator::pop_eh_t&    pop_eh,
+        user_propagator::fresh_eh_t&  fresh_eh) override {
+        // results depend on the callbacks, so the cache is bypassed from here on.
+        m_has_user_propagator = true;
+        s->user_propagate_init(ctx, push_eh, pop_eh, fresh_eh);
+    }
+    void user_propagate_register_fixed(user_propagator::fixed_eh_t& fixed_eh) override { s->user_propagate_register_fixed(fixed_eh); }
+    void user_propagate_register_final(user_propagator::final_eh_t& final_eh) override { s->user_propagate_register_final(final_eh); }
+    void user_propagate_register_eq(user_propagator::eq_eh_t& eq_eh) override { s->user_propagate_register_eq(eq_eh); }
+    void user_propagate_register_diseq(user_propagator::eq_eh_t& diseq_eh) override { s->user_propagate_register_diseq(diseq_eh); }
+    void user_propagate_register_on_binding(user_propagator::binding_eh_t& binding_eh) override { s->user_propagate_register_on_binding(binding_eh); }
+    void user_propagate_register_expr(expr* e) override { s->user_propagate_register_expr(e); }
+    void user_propagate_register_created(user_propagator::created_eh_t& r) override { s->user_propagate_register_created(r); }
+    void user_propagate_register_decide(user_propagator::decide_eh_t& r) override { s->user_propagate_register_decide(r); }
+    void user_propagate_initialize_value(expr* var, expr* value) override { s->user_propagate_initialize_value(var, value); }
+};
+
+solver * mk_query_cache_solver(solver * s) {
+    if (dynamic_cast<query_cache_solver*>(s))
+        return s;
+    solver_params sp(s->get_params());
+    symbol file = sp.cache_file();
+    if (file.is_non_empty_string())
+        return alloc(query_cache_solver, s, file.str());
+    else
+        return s;
+}
@@ -0,0 +1,120 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    query_cache_solver.h
+
+Abstract:
+
+    Implements a solver that caches check-sat results in a file.
+
+    The asserted formulas and assumptions are canonicalized: uninterpreted
+    constants are renamed by order of first occurrence and arguments of
+    commutative operators are sorted by a name-independent shape hash.
+    Structurally identical queries, up to renaming of constants and
+    permutation of commutative arguments, therefore share a key.
+    The key records every symbol, parameter and sort of the query, so
+    a hit is only possible when the queries are alpha-equivalent.
+
+    The file is an append-only log of entries. An entry stores the key,
+    sat or unsat, the values of the renamed constants for sat, and the
+    positions of the assumptions in the unsat core for unsat. Entries are
+    indexed in memory by a hash of their key and read from the file on a
+    lookup, which compares the stored key with the key of the query.
+
+    The cache is enabled by setting solver.cache.file.
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "util/obj_hashtable.h"
+#include "util/lbool.h"
+#include <fstream>
+#include <string>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+class solver;
+
+/**
+   \brief Compute a key for a quantifier-free query that is invariant
+   under renaming of uninterpreted constants and permutation of
+   arguments of commutative operators.
+*/
+class query_canonizer {
+    ast_manager&             m;
+    obj_map<expr, unsigned>  m_shape;
+    obj_map<expr, unsigned>  m_index;
+    obj_map<func_decl, unsigned> m_const2idx;
+    ptr_vector<func_decl>    m_consts;
+    ptr_vector<expr>         m_todo;
+    std::ostringstream       m_out;
+    bool                     m_has_uninterp_funs = false;
+
+    bool compute_shape(expr* e);
+    unsigned shape(app* a) const;
+    void sorted_args(app* a, ptr_buffer<expr>& args) const;
+    bool emit(expr* e);
+    bool emit_head(app* a);
+    bool display_sort(sort* s);
+    bool display_param(parameter const& p);
+    void display_symbol(symbol const& s);
+    void sort_by_shape(ptr_vector<expr>& es) const;
+
+public:
+    query_canonizer(ast_manager& m): m(m) {}
+
+    /**
+       \brief Produce the key for the conjunction of fmls under the ordered assumptions asms.
+       Return false if the query contains quantifiers, bound variables or
+       parameters that cannot be printed independently of the current process.
+    */
+    bool operator()(expr_ref_vector const& fmls, expr_ref_vector const& asms, std::string& key);
+
+    /**
+       \brief Uninterpreted constants of the query, ordered by their canonical index.
+    */
+    ptr_vector<func_decl> const& consts() const { return m_consts; }
+
+    bool has_uninterpreted_functions() const { return m_has_uninterp_funs; }
+};
+
+struct query_cache_entry {
+    lbool                    m_result = l_undef;
+    unsigned_vector          m_value_idx;   // canonical constant index
+    std::vector<std::string> m_values;      // serialized value of the constant
+    unsigned_vector          m_core;        // positions of assumptions in the unsat core
+};
+
+/**
+   \brief Append-only file of query results.
+   The file is scanned once when the first lookup is made, to index the
+   entries by a 64-bit hash of their key. Only the hashes and the offsets
+   of the entries are kept in memory.
+*/
+class query_cache {
+    std::string   m_file;
+    bool          m_loaded = false;
+    bool          m_writable = true;
+    std::unordered_multimap<uint64_t, uint64_t> m_index;   // hash of the key -> offset of the entry
+    std::ifstream m_in;
+    std::string   m_key;                                   // key of the last entry read
+
+    static uint64_t key_hash(std::string const& key);
+    void load();
+public:
+    query_cache(std::string const& file): m_file(file) {}
+    bool find(std::string const& key, query_cache_entry& e);
+    void insert(std::string const& key, query_cache_entry const& e);
+    unsigned size() { load(); return static_cast<unsigned>(m_index.size()); }
+};
+
+/**
+   \brief Wrap s in a query cache if solver.cache.file is set in its parameters.
+   A query cache solver is returned unchanged; it follows changes of
+   solver.cache.file through updt_params.
+*/
+solver * mk_query_cache_solver(solver * s);
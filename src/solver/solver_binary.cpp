@@ -0,0 +1,71 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    solver_binary.cpp
+
+Abstract:
+
+    Binary serialization of solver assertions using ast_binary.
+
+    The stream holds the number of scopes, the number of assertions
+    below each scope, and the assertions of all scopes in order.
+
+--*/
+
+#include "solver/solver_binary.h"
+#include "solver/solver.h"
+#include "ast/datatype_decl_plugin.h"
+#include "ast/for_each_expr.h"
+
+static bool has_datatype(datatype_util& dt, sort* s) {
+    if (dt.is_datatype(s))
+        return true;
+    for (unsigned i = 0; i < s->get_num_parameters(); ++i) {
+        parameter const& p = s->get_parameter(i);
+        if (p.is_ast() && is_sort(p.get_ast()) && has_datatype(dt, to_sort(p.get_ast())))
+            return true;
+    }
+    return false;
+}
+
+void solver2binary(solver const& s, unsigned_vector const& scope_lim, ast_binary_writer& out) {
+    ast_manager& m = s.get_manager();
+    expr_ref_vector fmls(m);
+    s.get_assertions(fmls);
+    if (scope_lim.size() != s.get_scope_level())
+        throw default_exception("the scopes of the solver are not known");
+    datatype_util dt(m);
+    auto check = [&](sort* srt) {
+        if (has_datatype(dt, srt))
+            throw default_exception("the binary solver format does not support datatypes, use the SMT-LIB2 format instead");
+    };
+    for (expr* e : subterms::all(fmls)) {
+        check(e->get_sort());
+        if (is_quantifier(e))
+            for (unsigned i = 0; i < to_quantifier(e)->get_num_decls(); ++i)
+                check(to_quantifier(e)->get_decl_sort(i));
+    }
+    out.write_unsigned(scope_lim.size());
+    for (unsigned lim : scope_lim)
+        out.write_unsigned(lim);
+    out.write_exprs(fmls);
+}
+
+void binary2assertions(ast_binary_reader& in, expr_ref_vector& fmls, unsigned_vector& scope_lim) {
+    ast_manager& m = fmls.get_manager();
+    uint64_t num_scopes = in.read_unsigned();
+    for (uint64_t i = 0; i < num_scopes; ++i) {
+        uint64_t lim = in.read_unsigned();
+        if (lim > UINT_MAX || (!scope_lim.empty() && lim < scope_lim.back()))
+            throw default_exception("invalid binary solver scopes");
+        scope_lim.push_back(static_cast<unsigned>(lim));
+    }
+    in.read_exprs(fmls);
+    if (!scope_lim.empty() && scope_lim.back() > fmls.size())
+        throw default_exception("invalid binary solver scopes");
+    for (expr* f : fmls)
+        if (!m.is_bool(f))
+            throw default_exception("invalid binary solver assertions");
+}
@@ -0,0 +1,29 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    solver_binary.h
+
+Abstract:
+
+    Binary serialization of solver assertions using ast_binary.
+
+--*/
+#pragma once
+
+#include "ast/ast_binary.h"
+
+class solver;
+
+/**
+   \brief Write the assertions of s and the scopes they belong to.
+   scope_lim[i] is the number of assertions of s when its (i+1)-th scope was
+   pushed. Datatypes are not supported and raise an exception.
+*/
+void solver2binary(solver const& s, unsigned_vector const& scope_lim, ast_binary_writer& out);
+
+/**
+   \brief Read the assertions and scope limits written by solver2binary.
+*/
+void binary2assertions(ast_binary_reader& in, expr_ref_vector& fmls, unsigned_vector& scope_lim);
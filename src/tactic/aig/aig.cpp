@@ -20,6 +20,8 @@ Notes:
 #include "tactic/goal.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_util.h"
+#include "util/map.h"
+#include "sat/sat_solver.h"
 
 #define USE_TWO_LEVEL_RULES
 #define FIRST_NODE_ID (UINT_MAX/2)
@@ -1310,6 +1312,481 @@ struct aig_manager::imp {
         }
     };
 
+    /**
+       \brief Functional reduction (FRAIG) of an AIG.
+
+       Nodes are visited in topological order and merged into an earlier
+       node that computes the same function or its complement.
+
+       - Cut enumeration gives every node cuts of at most four leaves, with
+         the truth table of the node over the leaves. Nodes with the same
+         leaves and truth table are equivalent, and so are a node and the
+         constant or leaf its truth table reduces to. The leaves of merged
+         nodes are replaced by their representatives.
+
+       - The remaining nodes are partitioned by the signatures of random
+         simulation. A node is merged into a node of its class if a SAT
+         query with a conflict budget confirms the equivalence.
+
+       The graph is rebuilt bottom-up with every merged node replaced by its
+       representative.
+    */
+    struct fraig_proc {
+        static const unsigned max_cut_size   = 4;
+        static const unsigned max_cuts       = 8;
+        static const unsigned num_words      = 4;  // 64 simulation patterns per word
+        static const unsigned max_candidates = 2;  // SAT queries per node
+
+        struct cut {
+            unsigned m_size = 0;
+            unsigned m_leaves[max_cut_size];
+            uint16_t m_tt = 0;
+        };
+
+        struct cut_hash {
+            unsigned operator()(cut const & c) const {
+                unsigned h = c.m_tt;
+                for (unsigned i = 0; i < c.m_size; ++i)
+                    h = combine_hash(h, c.m_leaves[i]);
+                return h;
+            }
+        };
+
+        struct cut_eq {
+            bool operator()(cut const & a, cut const & b) const {
+                if (a.m_size != b.m_size || a.m_tt != b.m_tt)
+                    return false;
+                for (unsigned i = 0; i < a.m_size; ++i)
+                    if (a.m_leaves[i] != b.m_leaves[i])
+                        return false;
+                return true;
+            }
+        };
+
+        struct repr {
+            unsigned m_node     = UINT_MAX;  // position of the representative
+            bool     m_inverted = false;
+        };
+
+        struct node_info {
+            unsigned m_child[2];
+            bool     m_inverted[2];
+        };
+
+        imp &                                 m;
+        unsigned                              m_max_conflicts;
+        ptr_vector<aig>                       m_nodes;  // topological order, the constant first
+        u_map<unsigned>                       m_pos;    // node id -> position in m_nodes
+        svector<node_info>                    m_info;
+        vector<svector<cut>>                  m_cuts;
+        map<cut, repr, cut_hash, cut_eq>      m_cut_table;
+        svector<repr>                         m_repr;
+        svector<uint64_t>                     m_sim;
+        scoped_ptr<sat::solver>               m_solver;
+        svector<sat::bool_var>                m_vars;
+        unsigned                              m_num_cut_merges = 0;
+        unsigned                              m_num_sat_merges = 0;
+        unsigned                              m_num_sat_calls  = 0;
+
+        fraig_proc(imp & _m, unsigned max_conflicts): m(_m), m_max_conflicts(max_conflicts) {}
+
+        bool is_merged(unsigned p) const { return m_repr[p].m_node != UINT_MAX; }
+
+        void collect(aig * root) {
+            aig * t = m.m_true.ptr();
+            m_pos.insert(t->m_id, 0);
+            m_nodes.push_back(t);
+            ptr_vector<aig> todo;
+            todo.push_back(root);
+            while (!todo.empty()) {
+                aig * n = todo.back();
+                if (m_pos.contains(n->m_id)) {
+                    todo.pop_back();
+                    continue;
+                }
+                bool visited = true;
+                if (!is_var(n)) {
+                    for (unsigned i = 0; i < 2; ++i) {
+                        aig * c = n->m_children[i].ptr();
+                        if (!m_pos.contains(c->m_id)) {
+                            todo.push_back(c);
+                            visited = false;
+                        }
+                    }
+                }
+                if (!visited)
+                    continue;
+                todo.pop_back();
+                m_pos.insert(n->m_id, m_nodes.size());
+                m_nodes.push_back(n);
+            }
+            m_info.resize(m_nodes.size());
+            for (unsigned p = 0; p < m_nodes.size(); ++p) {
+                aig * n = m_nodes[p];
+                if (p == 0 || is_var(n))
+                    continue;
+                for (unsigned i = 0; i < 2; ++i) {
+                    m_info[p].m_child[i]    = m_pos[n->m_children[i].ptr()->m_id];
+                    m_info[p].m_inverted[i] = n->m_children[i].is_inverted();
+                }
+            }
+            m_repr.resize(m_nodes.size());
+        }
+
+        // -----------------------------------
+        //
+        // Cuts
+        //
+        // -----------------------------------
+
+        static uint16_t var_tt(unsigned i) {
+            static const uint16_t tts[max_cut_size] = { 0xAAAA, 0xCCCC, 0xF0F0, 0xFF00 };
+            return tts[i];
+        }
+
+        static bool merge(cut const & a, cut const & b, cut & r) {
+            unsigned i = 0, j = 0;
+            r.m_size = 0;
+            while (i < a.m_size || j < b.m_size) {
+                unsigned l;
+                if (j == b.m_size || (i < a.m_size && a.m_leaves[i] < b.m_leaves[j]))
+                    l = a.m_leaves[i++];
+                else if (i == a.m_size || b.m_leaves[j] < a.m_leaves[i])
+                    l = b.m_leaves[j++];
+                else {
+                    l = a.m_leaves[i++];
+                    ++j;
+                }
+                if (r.m_size == max_cut_size)
+                    return false;
+                r.m_leaves[r.m_size++] = l;
+            }
+            return true;
+        }
+
+        /**
+           \brief Truth table of c over the leaves of r, which include the leaves of c.
+        */
+        static uint16_t expand(cut const & c, cut const & r) {
+            unsigned idx[max_cut_size];
+            for (unsigned i = 0, j = 0; i < c.m_size; ++i) {
+                while (r.m_leaves[j] != c.m_leaves[i])
+                    ++j;
+                idx[i] = j;
+            }
+            uint16_t tt = 0;
+            for (unsigned mt = 0; mt < 16; ++mt) {
+                unsigned k = 0;
+                for (unsigned i = 0; i < c.m_size; ++i)
+                    if (mt & (1u << idx[i]))
+                        k |= 1u << i;
+                if (c.m_tt & (1u << k))
+                    tt |= 1u << mt;
+            }
+            return tt;
+        }
+
+        cut trivial_cut(unsigned p) const {
+            cut c;
+            repr r = m_repr[p];
+            if (r.m_node == UINT_MAX)
+                r.m_node = p;
+            if (r.m_node == 0) {
+                c.m_tt = r.m_inverted ? 0x0000 : 0xFFFF;
+                return c;
+            }
+            c.m_size = 1;
+            c.m_leaves[0] = r.m_node;
+            c.m_tt = r.m_inverted ? static_cast<uint16_t>(~var_tt(0)) : var_tt(0);
+            return c;
+        }
+
+        void set_repr(unsigned p, unsigned q, bool inverted) {
+            SASSERT(q < p);
+            if (is_merged(q)) {
+                inverted ^= m_repr[q].m_inverted;
+                q = m_repr[q].m_node;
+            }
+            m_repr[p].m_node = q;
+            m_repr[p].m_inverted = inverted;
+        }
+
+        /**
+           \brief Compute the cuts of the AND node at position p and merge it
+           if one of them determines an equivalent node.
+        */
+        void process_cuts(unsigned p) {
+            svector<cut> & cuts = m_cuts[p];
+            node_info const & info = m_info[p];
+            svector<cut> const & cuts0 = m_cuts[info.m_child[0]];
+            svector<cut> const & cuts1 = m_cuts[info.m_child[1]];
+            for (unsigned i = 0; i < cuts0.size() && cuts.size() < max_cuts; ++i) {
+                for (unsigned j = 0; j < cuts1.size() && cuts.size() < max_cuts; ++j) {
+                    cut c;
+                    if (!merge(cuts0[i], cuts1[j], c))
+                        continue;
+                    uint16_t t0 = expand(cuts0[i], c);
+                    uint16_t t1 = expand(cuts1[j], c);
+                    if (info.m_inverted[0])
+                        t0 = ~t0;
+                    if (info.m_inverted[1])
+                        t1 = ~t1;
+                    c.m_tt = t0 & t1;
+                    bool dup = any_of(cuts, [&](cut const & d) {
+                        return d.m_size == c.m_size && std::equal(c.m_leaves, c.m_leaves + c.m_size, d.m_leaves);
+                    });
+                    if (!dup)
+                        cuts.push_back(c);
+                }
+            }
+            for (cut const & c : cuts) {
+                bool inverted = (c.m_tt & 1) != 0;
+                cut key = c;
+                if (inverted)
+                    key.m_tt = ~key.m_tt;
+                if (key.m_tt == 0) {
+                    set_repr(p, 0, !inverted);
+                    break;
+                }
+                unsigned i = 0;
+                for (; i < key.m_size && key.m_tt != var_tt(i); ++i)
+                    ;
+                if (i < key.m_size) {
+                    set_repr(p, key.m_leaves[i], inverted);
+                    break;
+                }
+                repr r;
+                if (m_cut_table.find(key, r)) {
+                    set_repr(p, r.m_node, inverted != r.m_inverted);
+                    break;
+                }
+                r.m_node = p;
+                r.m_inverted = inverted;
+                m_cut_table.insert(key, r);
+            }
+            if (is_merged(p))
+                ++m_num_cut_merges;
+            cuts.push_back(trivial_cut(p));
+        }
+
+        void sweep_cuts() {
+            m_cuts.resize(m_nodes.size());
+            for (unsigned p = 0; p < m_nodes.size(); ++p) {
+                m.checkpoint();
+                if (p == 0 || is_var(m_nodes[p]))
+                    m_cuts[p].push_back(trivial_cut(p));
+                else
+                    process_cuts(p);
+            }
+            m_cuts.finalize();
+            m_cut_table.reset();
+        }
+
+        // -----------------------------------
+        //
+        // Simulation and SAT sweeping
+        //
+        // -----------------------------------
+
+        uint64_t * sim(unsigned p) { return m_sim.data() + p * num_words; }
+
+        void simulate() {
+            random_gen rand(0);
+            auto random64 = [&]() {
+                uint64_t r = 0;
+                for (unsigned i = 0; i < 5; ++i)
+                    r = (r << 15) ^ static_cast<uint64_t>(rand());
+                return r;
+            };
+            m_sim.resize(num_words * m_nodes.size());
+            for (unsigned p = 0; p < m_nodes.size(); ++p) {
+                uint64_t * s = sim(p);
+                if (p == 0) {
+                    for (unsigned w = 0; w < num_words; ++w)
+                        s[w] = ~static_cast<uint64_t>(0);
+                }
+                else if (is_var(m_nodes[p])) {
+                    for (unsigned w = 0; w < num_words; ++w)
+                        s[w] = random64();
+                }
+                else {
+                    node_info const & info = m_info[p];
+                    uint64_t const * s0 = sim(info.m_child[0]);
+                    uint64_t const * s1 = sim(info.m_child[1]);
+                    uint64_t m0 = info.m_inverted[0] ? ~static_cast<uint64_t>(0) : 0;
+                    uint64_t m1 = info.m_inverted[1] ? ~static_cast<uint64_t>(0) : 0;
+                    for (unsigned w = 0; w < num_words; ++w)
+                        s[w] = (s0[w] ^ m0) & (s1[w] ^ m1);
+                }
+            }
+        }
+
+        sat::literal lit(unsigned p) {
+            if (!m_solver) {
+                params_ref ps;
+                ps.set_uint("max_conflicts", m_max_conflicts);
+                m_solver = alloc(sat::solver, ps, m.m().limit());
+                // nodes are created between checks and passed as assumptions,
+                // so in-processing must not eliminate or substitute them.
+                m_solver->set_incremental(true);
+            }
+            m_vars.reserve(m_nodes.size(), sat::null_bool_var);
+            unsigned_vector todo;
+            todo.push_back(p);
+            while (!todo.empty()) {
+                unsigned q = todo.back();
+                if (m_vars[q] != sat::null_bool_var) {
+                    todo.pop_back();
+                    continue;
+                }
+                if (q == 0 || is_var(m_nodes[q])) {
+                    m_vars[q] = m_solver->mk_var(true, true);
+                    if (q == 0) {
+                        sat::literal t(m_vars[q], false);
+                        m_solver->mk_clause(1, &t);
+                    }
+                    todo.pop_back();
+                    continue;
+                }
+                node_info const & info = m_info[q];
+                bool visited = true;
+                for (unsigned i = 0; i < 2; ++i) {
+                    if (m_vars[info.m_child[i]] == sat::null_bool_var) {
+                        todo.push_back(info.m_child[i]);
+                        visited = false;
+                    }
+                }
+                if (!visited)
+                    continue;
+                todo.pop_back();
+                m_vars[q] = m_solver->mk_var(true, true);
+                sat::literal v(m_vars[q], false);
+                sat::literal a(m_vars[info.m_child[0]], info.m_inverted[0]);
+                sat::literal b(m_vars[info.m_child[1]], info.m_inverted[1]);
+                m_solver->mk_clause(~v, a);
+                m_solver->mk_clause(~v, b);
+                m_solver->mk_clause(v, ~a, ~b);
+            }
+            return sat::literal(m_vars[p], false);
+        }
+
+        /**
+           \brief Check that p and q, or its complement if inverted, are equivalent.
+        */
+        bool check_equiv(unsigned p, unsigned q, bool inverted) {
+            sat::literal a = lit(p);
+            sat::literal b = lit(q);
+            if (inverted)
+                b.neg();
+            for (unsigned i = 0; i < 2; ++i) {
+                sat::literal asms[2] = { a, ~b };
+                ++m_num_sat_calls;
+                if (m_solver->check(2, asms) != l_false)
+                    return false;
+                std::swap(a, b);
+            }
+            // record the equivalence for later queries
+            m_solver->mk_clause(~a, b);
+            m_solver->mk_clause(a, ~b);
+            return true;
+        }
+
+        void sweep_sat() {
+            simulate();
+            u_map<unsigned> heads;
+            unsigned_vector next(m_nodes.size(), UINT_MAX);
+            auto phase = [&](unsigned p) { return (sim(p)[0] & 1) != 0; };
+            auto hash = [&](unsigned p) {
+                uint64_t mask = phase(p) ? ~static_cast<uint64_t>(0) : 0;
+                unsigned h = 0;
+                for (unsigned w = 0; w < num_words; ++w) {
+                    uint64_t s = sim(p)[w] ^ mask;
+                    h = combine_hash(h, static_cast<unsigned>(s) ^ static_cast<unsigned>(s >> 32));
+                }
+                return h;
+            };
+            auto same_sim = [&](unsigned p, unsigned q) {
+                uint64_t mask = phase(p) != phase(q) ? ~static_cast<uint64_t>(0) : 0;
+                for (unsigned w = 0; w < num_words; ++w)
+                    if (sim(p)[w] != (sim(q)[w] ^ mask))
+                        return false;
+                return true;
+            };
+            for (unsigned p = 0; p < m_nodes.size(); ++p) {
+                m.checkpoint();
+                if (is_merged(p))
+                    continue;
+                unsigned h = hash(p);
+                unsigned head = UINT_MAX;
+                heads.find(h, head);
+                if (p != 0 && !is_var(m_nodes[p])) {
+                    unsigned num_checks = 0;
+                    for (unsigned q = head; q != UINT_MAX && num_checks < max_candidates; q = next[q]) {
+                        if (!same_sim(p, q))
+                            continue;
+                        ++num_checks;
+                        bool inverted = phase(p) != phase(q);
+                        if (check_equiv(p, q, inverted)) {
+                            set_repr(p, q, inverted);
+                            ++m_num_sat_merges;
+                            break;
+                        }
+                    }
+                    if (is_merged(p))
+                        continue;
+                }
+                next[p] = head;
+                heads.insert(h, p);
+            }
+        }
+
+        aig_lit rebuild(aig_lit root) {
+            svector<aig_lit> new_lits;
+            for (unsigned p = 0; p < m_nodes.size(); ++p) {
+                aig * n = m_nodes[p];
+                aig_lit r;
+                if (is_merged(p)) {
+                    r = new_lits[m_repr[p].m_node];
+                    if (m_repr[p].m_inverted)
+                        r.invert();
+                }
+                else if (p == 0 || is_var(n))
+                    r = aig_lit(n);
+                else {
+                    node_info const & info = m_info[p];
+                    aig_lit a = new_lits[info.m_child[0]];
+                    aig_lit b = new_lits[info.m_child[1]];
+                    if (info.m_inverted[0])
+                        a.invert();
+                    if (info.m_inverted[1])
+                        b.invert();
+                    r = m.mk_and(a, b);
+                }
+                m.inc_ref(r);
+                new_lits.push_back(r);
+            }
+            aig_lit r = new_lits[m_pos[root.ptr()->m_id]];
+            if (root.is_inverted())
+                r.invert();
+            m.inc_ref(r);
+            for (aig_lit const & l : new_lits)
+                m.dec_ref(l);
+            m.dec_ref_result(r);
+            return r;
+        }
+
+        aig_lit operator()(aig_lit root) {
+            collect(root.ptr());
+            sweep_cuts();
+            sweep_sat();
+            IF_VERBOSE(2, verbose_stream() << "(aig.fraig :nodes " << m_nodes.size()
+                       << " :cut-merges " << m_num_cut_merges
+                       << " :sat-merges " << m_num_sat_merges
+                       << " :sat-calls " << m_num_sat_calls << ")\n";);
+            return rebuild(root);
+        }
+    };
+
 public:
     imp(ast_manager & m, unsigned long long max_memory, bool default_gate_encoding):
         m_var_id_gen(0),
@@ -1553,6 +2030,11 @@ public:
         return p(l);
     }
 
+    aig_lit fraig(aig_lit l, unsigned max_conflicts) {
+        fraig_proc p(*this, max_conflicts);
+        return p(l);
+    }
+
     void display_ref(std::ostream & out, aig * r) const {
         if (is_var(r)) 
             out << "#" << r->m_id;
@@ -1735,6 +2217,10 @@ void aig_manager::max_sharing(aig_ref & r) {
 }
 
 
+void aig_manager::fraig(aig_ref & r, unsigned max_conflicts) {
+    r = aig_ref(*this, m_imp->fraig(aig_lit(r), max_conflicts));
+}
+
 void aig_manager::to_formula(aig_ref const & r, expr_ref & res) {
     return m_imp->to_formula(aig_lit(r), res);
 }
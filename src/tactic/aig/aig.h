@@ -67,6 +67,13 @@ public:
     aig_ref mk_iff(aig_ref const & r1, aig_ref const & r2);
     aig_ref mk_ite(aig_ref const & r1, aig_ref const & r2, aig_ref const & r3);
     void max_sharing(aig_ref & r);
+    /**
+       \brief Merge the nodes of r that compute the same function, up to
+       complement. Candidate equivalences that are not established by
+       4-input cuts are checked by SAT queries with at most max_conflicts
+       conflicts each.
+    */
+    void fraig(aig_ref & r, unsigned max_conflicts = 1000);
     void to_formula(aig_ref const & r, expr_ref & result);
     void to_formula(aig_ref const & r, goal & result);
     void display(std::ostream & out, aig_ref const & r) const;
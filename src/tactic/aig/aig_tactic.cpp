@@ -27,6 +27,8 @@ class aig_manager;
 class aig_tactic : public tactic {
     unsigned long long m_max_memory;
     bool               m_aig_gate_encoding;
+    bool               m_fraig;
+    unsigned           m_fraig_max_conflicts;
     aig_manager *      m_aig_manager;
 
     struct mk_aig_manager {
@@ -44,26 +46,37 @@ class aig_tactic : public tactic {
     };
 
 public:
-    aig_tactic(params_ref const & p = params_ref()):m_aig_manager(nullptr) {
+    aig_tactic(params_ref const & p = params_ref(), bool fraig = false):m_fraig(fraig), m_aig_manager(nullptr) {
         updt_params(p); 
     }
 
-    char const* name() const override { return "aig"; }
+    char const* name() const override { return m_fraig ? "fraig" : "aig"; }
     
     tactic * translate(ast_manager & m) override {
         aig_tactic * t = alloc(aig_tactic);
         t->m_max_memory = m_max_memory;
         t->m_aig_gate_encoding = m_aig_gate_encoding;
+        t->m_fraig = m_fraig;
+        t->m_fraig_max_conflicts = m_fraig_max_conflicts;
         return t;
     }
 
     void updt_params(params_ref const & p) override {
         m_max_memory        = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
         m_aig_gate_encoding = p.get_bool("aig_default_gate_encoding", true);
+        m_fraig_max_conflicts = p.get_uint("fraig_max_conflicts", 1000);
     }
 
     void collect_param_descrs(param_descrs & r) override {
         insert_max_memory(r);
+        if (m_fraig)
+            r.insert("fraig_max_conflicts", CPK_UINT, "maximum number of conflicts of a SAT query that checks the equivalence of two nodes", "1000");
+    }
+
+    void simplify(aig_ref & r) {
+        m_aig_manager->max_sharing(r);
+        if (m_fraig)
+            m_aig_manager->fraig(r, m_fraig_max_conflicts);
     }
 
     void operator()(goal_ref const & g) {
@@ -80,7 +93,7 @@ public:
             }
             else {
                 aig_ref r = m_aig_manager->mk_aig(g->form(i));
-                m_aig_manager->max_sharing(r);
+                simplify(r);
                 expr_ref new_f(m);
                 m_aig_manager->to_formula(r, new_f);
                 unsigned old_sz = get_num_exprs(g->form(i));
@@ -93,7 +106,7 @@ public:
         if (!nodeps.empty()) {
             expr_ref conj(::mk_and(nodeps));
             aig_ref r = m_aig_manager->mk_aig(conj);
-            m_aig_manager->max_sharing(r);
+            simplify(r);
             expr_ref new_f(m);
             m_aig_manager->to_formula(r, new_f);
             unsigned old_sz = get_num_exprs(conj);
@@ -107,8 +120,8 @@ public:
     }
     
     void operator()(goal_ref const & g, goal_ref_buffer & result) override {
-        fail_if_proof_generation("aig", g);
-        tactic_report report("aig", *g);
+        fail_if_proof_generation(name(), g);
+        tactic_report report(name(), *g);
         operator()(g);
         g->inc_depth();
         result.push_back(g.get());
@@ -121,3 +134,7 @@ public:
 tactic * mk_aig_tactic(params_ref const & p) {
     return clean(alloc(aig_tactic, p));
 }
+
+tactic * mk_fraig_tactic(params_ref const & p) {
+    return clean(alloc(aig_tactic, p, true));
+}
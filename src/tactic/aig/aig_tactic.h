@@ -39,6 +39,31 @@ and do not represent a high-quality circuit minimization approach.
 (apply aig)
 ```
 
+## Tactic fraig
+
+### Short Description
+
+Simplify Boolean structure using AIGs and merge functionally equivalent nodes.
+
+### Long Description
+
+Performs the simplifications of `aig` and then sweeps the circuit for nodes that compute
+the same function, or its complement. Nodes are first merged when a cut of at most four inputs
+has the same truth table as the cut of an earlier node. The remaining candidates are the nodes
+with equal signatures under random simulation, and two such nodes are merged if a SAT query
+with at most `fraig_max_conflicts` conflicts establishes that they are equivalent.
+The tactic is intended to run on bit-blasted goals before they are passed to the SAT solver.
+
+### Example
+
+```z3
+(declare-const a Bool)
+(declare-const b Bool)
+(declare-const c Bool)
+(assert (xor (and a (or b c)) (or (and a b) (and a c))))
+(apply fraig)
+```
+
 --*/
 #pragma once
 
@@ -49,3 +74,8 @@ tactic * mk_aig_tactic(params_ref const & p = params_ref());
 /*
   ADD_TACTIC("aig", "simplify Boolean structure using AIGs.", "mk_aig_tactic()")
 */
+
+tactic * mk_fraig_tactic(params_ref const & p = params_ref());
+/*
+  ADD_TACTIC("fraig", "simplify Boolean structure using AIGs and merge functionally equivalent nodes.", "mk_fraig_tactic(p)")
+*/
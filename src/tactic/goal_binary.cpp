@@ -0,0 +1,56 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    goal_binary.cpp
+
+Abstract:
+
+    Binary serialization of goals using ast_binary.
+
+    A goal is written as its precision and flags followed by the
+    formulas with their proofs and the leaves of their dependencies.
+    Proofs are dropped when the reading manager does not produce proofs.
+
+--*/
+
+#include "tactic/goal_binary.h"
+
+void goal2binary(goal const& g, ast_binary_writer& out) {
+    ast_manager& m = g.m();
+    out.write_unsigned(g.prec());
+    out.write_unsigned((g.models_enabled() ? 1 : 0) | (g.proofs_enabled() ? 2 : 0) | (g.unsat_core_enabled() ? 4 : 0));
+    out.write_unsigned(g.size());
+    ptr_vector<expr> leaves;
+    for (unsigned i = 0; i < g.size(); ++i) {
+        out.write_ast(g.form(i));
+        out.write_ast(g.pr(i));
+        leaves.reset();
+        m.linearize(g.dep(i), leaves);
+        out.write_exprs(leaves.size(), leaves.data());
+    }
+}
+
+goal_ref binary2goal(ast_manager& m, ast_binary_reader& in) {
+    uint64_t prec = in.read_unsigned();
+    uint64_t flags = in.read_unsigned();
+    if (prec > goal::UNDER_OVER)
+        throw default_exception("invalid binary goal");
+    bool proofs_enabled = (flags & 2) != 0 && m.proofs_enabled();
+    goal_ref g = alloc(goal, m, proofs_enabled, (flags & 1) != 0, (flags & 4) != 0);
+    g->set_prec(static_cast<goal::precision>(prec));
+    uint64_t sz = in.read_unsigned();
+    expr_ref_vector leaves(m);
+    for (uint64_t i = 0; i < sz; ++i) {
+        expr* f = in.read_expr();
+        expr* p = in.read_expr();
+        leaves.reset();
+        in.read_exprs(leaves);
+        if (!f || !m.is_bool(f) || (p && !m.is_proof(p)))
+            throw default_exception("invalid binary goal");
+        expr_dependency* d = leaves.empty() ? nullptr : m.mk_join(leaves.size(), leaves.data());
+        g->assert_expr(f, proofs_enabled && p ? to_app(p) : nullptr, d);
+    }
+    return g;
+}
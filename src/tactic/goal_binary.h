@@ -0,0 +1,20 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    goal_binary.h
+
+Abstract:
+
+    Binary serialization of goals using ast_binary.
+
+--*/
+#pragma once
+
+#include "ast/ast_binary.h"
+#include "tactic/goal.h"
+
+void goal2binary(goal const& g, ast_binary_writer& out);
+
+goal_ref binary2goal(ast_manager& m, ast_binary_reader& in);
@@ -0,0 +1,133 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    aig.cpp
+
+Abstract:
+
+    Tests for functional reduction of AIGs.
+
+--*/
+
+#include "tactic/aig/aig.h"
+#include "tactic/aig/aig_tactic.h"
+#include "tactic/core/simplify_tactic.h"
+#include "tactic/bv/bit_blaster_tactic.h"
+#include "tactic/tactical.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/ast_util.h"
+#include "smt/smt_context.h"
+#include "util/util.h"
+#include <iostream>
+
+static expr_ref fraig(ast_manager & m, expr * f) {
+    aig_manager mng(m);
+    aig_ref r = mng.mk_aig(f);
+    mng.fraig(r);
+    expr_ref result(m);
+    mng.to_formula(r, result);
+    return result;
+}
+
+static bool equivalent(ast_manager & m, expr * f, expr * g) {
+    smt_params p;
+    smt::context ctx(m, p);
+    ctx.assert_expr(m.mk_not(m.mk_eq(f, g)));
+    return ctx.check() == l_false;
+}
+
+static void tst_cut_merge() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref a(m.mk_const("a", m.mk_bool_sort()), m);
+    expr_ref b(m.mk_const("b", m.mk_bool_sort()), m);
+    expr_ref c(m.mk_const("c", m.mk_bool_sort()), m);
+    // a & (b | c) and (a & b) | (a & c) have the same truth table over {a, b, c}
+    expr_ref f(m.mk_xor(m.mk_and(a, m.mk_or(b, c)), m.mk_or(m.mk_and(a, b), m.mk_and(a, c))), m);
+    expr_ref r = fraig(m, f);
+    ENSURE(m.is_false(r));
+}
+
+static void tst_sat_merge() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector xs(m);
+    for (unsigned i = 0; i < 6; ++i)
+        xs.push_back(m.mk_fresh_const("x", m.mk_bool_sort()));
+    // two parity chains over six inputs, too wide for a single cut
+    expr_ref p1(xs.get(0), m), p2(xs.get(5), m);
+    for (unsigned i = 1; i < 6; ++i) {
+        p1 = m.mk_xor(p1, xs.get(i));
+        p2 = m.mk_xor(xs.get(5 - i), p2);
+    }
+    expr_ref f(m.mk_xor(p1, p2), m);
+    expr_ref r = fraig(m, f);
+    ENSURE(m.is_false(r));
+    f = m.mk_xor(p1, m.mk_not(p2));
+    r = fraig(m, f);
+    ENSURE(m.is_true(r));
+}
+
+static void tst_random() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    random_gen rand(0);
+    for (unsigned round = 0; round < 20; ++round) {
+        expr_ref_vector es(m);
+        for (unsigned i = 0; i < 5; ++i)
+            es.push_back(m.mk_fresh_const("x", m.mk_bool_sort()));
+        for (unsigned i = 0; i < 40; ++i) {
+            expr * x = es.get(rand(es.size()));
+            expr * y = es.get(rand(es.size()));
+            switch (rand(4)) {
+            case 0: es.push_back(m.mk_and(x, y)); break;
+            case 1: es.push_back(m.mk_or(x, y)); break;
+            case 2: es.push_back(m.mk_xor(x, y)); break;
+            default: es.push_back(m.mk_not(m.mk_eq(x, m.mk_not(y)))); break;
+            }
+        }
+        expr_ref f(::mk_and(m, es.size() - 5, es.data() + 5), m);
+        expr_ref r = fraig(m, f);
+        ENSURE(equivalent(m, f, r));
+    }
+}
+
+static goal_ref fraig_bvmul_distributivity(ast_manager & m, unsigned sz) {
+    bv_util bv(m);
+    expr_ref x(m.mk_const("x", bv.mk_sort(sz)), m);
+    expr_ref y(m.mk_const("y", bv.mk_sort(sz)), m);
+    expr_ref z(m.mk_const("z", bv.mk_sort(sz)), m);
+    expr_ref lhs(bv.mk_bv_mul(x, bv.mk_bv_add(y, z)), m);
+    expr_ref rhs(bv.mk_bv_add(bv.mk_bv_mul(x, y), bv.mk_bv_mul(x, z)), m);
+    goal_ref g = alloc(goal, m);
+    g->assert_expr(m.mk_not(m.mk_eq(lhs, rhs)));
+    tactic_ref t = and_then(mk_simplify_tactic(m), mk_bit_blaster_tactic(m), mk_fraig_tactic());
+    goal_ref_buffer result;
+    (*t)(g, result);
+    ENSURE(result.size() == 1);
+    return result[0];
+}
+
+static void tst_bvmul_distributivity() {
+    // the equivalence checks reuse one SAT solver, so its in-processing must
+    // not eliminate variables that later checks pass as assumptions.
+    ast_manager m;
+    reg_decl_plugins(m);
+    goal_ref g = fraig_bvmul_distributivity(m, 8);
+    ENSURE(!g->is_decided_sat());
+    g = fraig_bvmul_distributivity(m, 4);
+    expr_ref_vector fmls(m);
+    g->get_formulas(fmls);
+    expr_ref f(::mk_and(fmls), m);
+    ENSURE(equivalent(m, f, m.mk_false()));
+}
+
+void tst_aig() {
+    tst_cut_merge();
+    tst_sat_merge();
+    tst_random();
+    tst_bvmul_distributivity();
+}
@@ -0,0 +1,72 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    api_solver_binary.cpp
+
+Abstract:
+
+    Test saving and loading solvers in the binary format.
+
+--*/
+#include "api/z3.h"
+#include "util/debug.h"
+#include <filesystem>
+#include <string>
+
+static void no_error_handler(Z3_context, Z3_error_code) {}
+
+void tst_api_solver_binary() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    Z3_set_error_handler(ctx, no_error_handler);
+    std::string file = (std::filesystem::temp_directory_path() / "z3_api_solver_binary.bin").string();
+
+    Z3_sort int_sort = Z3_mk_int_sort(ctx);
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), int_sort);
+    Z3_ast zero = Z3_mk_int(ctx, 0, int_sort);
+    Z3_ast ten = Z3_mk_int(ctx, 10, int_sort);
+
+    // x > 0; push; x < 10; push; push; x = 0
+    Z3_solver s = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_solver_assert(ctx, s, Z3_mk_gt(ctx, x, zero));
+    Z3_solver_push(ctx, s);
+    Z3_solver_assert(ctx, s, Z3_mk_lt(ctx, x, ten));
+    Z3_solver_push(ctx, s);
+    Z3_solver_push(ctx, s);
+    Z3_solver_assert(ctx, s, Z3_mk_eq(ctx, x, zero));
+    Z3_solver_to_binary(ctx, s, file.c_str());
+    ENSURE(Z3_get_error_code(ctx) == Z3_OK);
+
+    Z3_solver t = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, t);
+    Z3_solver_from_binary(ctx, t, file.c_str());
+    ENSURE(Z3_get_error_code(ctx) == Z3_OK);
+    ENSURE(Z3_solver_get_num_scopes(ctx, t) == 3);
+    ENSURE(Z3_solver_check(ctx, t) == Z3_L_FALSE);
+    Z3_solver_pop(ctx, t, 1);
+    ENSURE(Z3_solver_check(ctx, t) == Z3_L_TRUE);
+    Z3_solver_pop(ctx, t, 2);
+    Z3_ast_vector fmls = Z3_solver_get_assertions(ctx, t);
+    Z3_ast_vector_inc_ref(ctx, fmls);
+    ENSURE(Z3_ast_vector_size(ctx, fmls) == 1);
+    Z3_ast_vector_dec_ref(ctx, fmls);
+
+    // datatypes are rejected when saving
+    Z3_symbol names[1] = { Z3_mk_string_symbol(ctx, "C") };
+    Z3_func_decl consts[1];
+    Z3_func_decl testers[1];
+    Z3_sort e = Z3_mk_enumeration_sort(ctx, Z3_mk_string_symbol(ctx, "E"), 1, names, consts, testers);
+    Z3_ast y = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "y"), e);
+    Z3_solver_assert(ctx, t, Z3_mk_eq(ctx, y, Z3_mk_app(ctx, consts[0], 0, nullptr)));
+    Z3_solver_to_binary(ctx, t, file.c_str());
+    ENSURE(Z3_get_error_code(ctx) == Z3_EXCEPTION);
+
+    Z3_solver_dec_ref(ctx, t);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_context(ctx);
+    std::filesystem::remove(file);
+}
@@ -17,6 +17,8 @@ Revision History:
 
 --*/
 #include "ast/ast.h"
+#include "ast/arith_decl_plugin.h"
+#include <thread>
 
 static void tst1() {
     ast_manager m;
@@ -131,6 +133,93 @@ static void tst5() {
     m.del(arr3);
 }
 
+static void tst6() {
+    // concurrent hash-consing over a shared manager
+    ast_manager m;
+    sort_ref b(m.mk_bool_sort(), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), b, b, b), m);
+    expr_ref a(m.mk_const(symbol("a"), b), m);
+    expr_ref c(m.mk_const(symbol("c"), b), m);
+    unsigned const num_threads = 4, depth = 2000;
+    vector<expr_ref_vector> results;
+    for (unsigned i = 0; i < num_threads; ++i)
+        results.push_back(expr_ref_vector(m));
+    m.set_concurrent(true);
+    {
+        vector<std::thread> threads;
+        for (unsigned i = 0; i < num_threads; ++i) {
+            threads.push_back(std::thread([&, i]() {
+                expr_ref t(a, m);
+                for (unsigned j = 0; j < depth; ++j) {
+                    t = m.mk_app(f.get(), t.get(), (j % 3 == 0) ? c.get() : a.get());
+                    expr_ref tmp(m.mk_app(f.get(), c.get(), t.get()), m); // released again
+                    results[i].push_back(t);
+                }
+            }));
+        }
+        for (auto& th : threads)
+            th.join();
+    }
+    m.set_concurrent(false);
+    for (unsigned i = 1; i < num_threads; ++i) 
+        for (unsigned j = 0; j < depth; ++j) 
+            ENSURE(results[0].get(j) == results[i].get(j));
+    unsigned num_asts = m.get_num_asts();
+    results.reset();
+    ENSURE(m.get_num_asts() < num_asts);
+}
+
+static void tst7() {
+    // terms released by registered threads are reclaimed while the manager is in
+    // concurrent mode, and theory plugins are used from several threads.
+    ast_manager m;
+    m.register_plugin(symbol("arith"), alloc(arith_decl_plugin));
+    arith_util a(m);
+    sort_ref s(a.mk_int(), m);
+    expr_ref zero(a.mk_int(0), m);
+    unsigned const num_threads = 4, rounds = 100, width = 100;
+    unsigned base = m.get_num_asts();
+    vector<expr_ref_vector> kept;
+    for (unsigned i = 0; i < num_threads; ++i)
+        kept.push_back(expr_ref_vector(m));
+    m.set_concurrent(true);
+    {
+        vector<std::thread> threads;
+        for (unsigned i = 0; i < num_threads; ++i) {
+            threads.push_back(std::thread([&, i]() {
+                scoped_concurrent_thread thread(m);
+                arith_util au(m);
+                expr_ref_vector terms(m);
+                for (unsigned r = 0; r < rounds; ++r) {
+                    for (unsigned j = 0; j < width; ++j) {
+                        expr_ref x(m.mk_const(symbol((i * rounds + r) * width + j), s), m);
+                        terms.push_back(au.mk_add(x, au.mk_int(j % 20)));
+                    }
+                    if (r % 10 == 0)
+                        kept[i].push_back(terms.get(i));
+                    terms.reset();
+                    m.concurrent_checkpoint();
+                }
+            }));
+        }
+        for (auto& th : threads)
+            th.join();
+    }
+    // each thread created 3 * rounds * width nodes
+    ENSURE(m.get_num_asts() < base + rounds * width * num_threads);
+    m.set_concurrent(false);
+    for (unsigned i = 0; i < num_threads; ++i) {
+        for (unsigned k = 0; k < kept[i].size(); ++k) {
+            expr * t = kept[i].get(k);
+            ENSURE(a.is_add(t));
+            ENSURE(to_app(to_app(t)->get_arg(0))->get_decl()->get_name() == symbol((i * rounds + 10 * k) * width + i));
+        }
+    }
+    kept.reset();
+    // only the cached numerals remain
+    ENSURE(m.get_num_asts() <= base + 40);
+}
+
 
 struct foo {
     unsigned       m_id; 
@@ -153,5 +242,7 @@ void tst_ast() {
     tst3();
     tst4();
     tst5();
+    tst6();
+    tst7();
 }
 
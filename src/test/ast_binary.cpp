@@ -0,0 +1,187 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.cpp
+
+Abstract:
+
+    Round-trip tests for the binary AST format.
+
+--*/
+
+#include "ast/ast_binary.h"
+#include "ast/ast_translation.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/array_decl_plugin.h"
+#include "ast/seq_decl_plugin.h"
+#include "model/model_binary.h"
+#include "model/func_interp.h"
+#include "tactic/goal_binary.h"
+#include <iostream>
+#include <sstream>
+
+static void tst_exprs() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    bv_util bv(m);
+    array_util ar(m);
+    seq_util sq(m);
+    sort* I = a.mk_int();
+    sort* B = bv.mk_sort(8);
+    sort* U = m.mk_uninterpreted_sort(symbol("U"));
+    sort* arr = ar.mk_array_sort(I, B);
+    func_decl* f = m.mk_func_decl(symbol("f"), I, U, I);
+    expr_ref x(m.mk_const("x", I), m);
+    expr_ref u(m.mk_const("u", U), m);
+    expr_ref A(m.mk_const("A", arr), m);
+    expr_ref s(m.mk_const("s", sq.str.mk_string_sort()), m);
+    expr_ref_vector fmls(m);
+    expr_ref fx(m.mk_app(f, x, u), m);
+    fmls.push_back(a.mk_gt(a.mk_add(fx, fx, a.mk_numeral(rational("123456789012345678901234567890"), true)), a.mk_real(rational(-3, 7))));
+    fmls.push_back(m.mk_eq(ar.mk_select(A, x), bv.mk_bv_add(bv.mk_numeral(rational(200), 8), bv.mk_extract(7, 0, bv.mk_numeral(rational(5), 16)))));
+    fmls.push_back(m.mk_eq(s, sq.str.mk_string(zstring("hello"))));
+    expr_ref v0(m.mk_var(0, I), m);
+    expr_ref body(a.mk_ge(m.mk_app(f, v0, u), v0), m);
+    app* pat_arg = to_app(m.mk_app(f, v0, u));
+    expr* pat = m.mk_pattern(1, &pat_arg);
+    symbol n("y");
+    fmls.push_back(m.mk_forall(1, &I, &n, body, 3, symbol("q"), symbol::null, 1, &pat));
+    fmls.push_back(m.mk_exists(1, &I, &n, m.mk_not(body)));
+
+    ast_binary_writer out(m);
+    out.write_exprs(fmls);
+    out.write_exprs(fmls);
+
+    ast_manager m2;
+    reg_decl_plugins(m2);
+    ast_binary_reader in(m2, out.data().data(), out.data().size());
+    expr_ref_vector r1(m2), r2(m2);
+    in.read_exprs(r1);
+    in.read_exprs(r2);
+    ENSURE(in.at_end());
+    ast_translation tr(m, m2);
+    ENSURE(r1.size() == fmls.size());
+    for (unsigned i = 0; i < fmls.size(); ++i) {
+        ENSURE(tr(fmls.get(i)) == r1.get(i));
+        ENSURE(r1.get(i) == r2.get(i));
+    }
+
+    // the second copy only consists of references
+    ast_binary_writer out2(m);
+    out2.write_exprs(fmls);
+    ENSURE(out.data().size() < 2 * out2.data().size());
+}
+
+static void tst_model() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    sort* I = a.mk_int();
+    func_decl* c = m.mk_const_decl(symbol("c"), I);
+    func_decl* g = m.mk_func_decl(symbol("g"), I, I);
+    model_ref mdl = alloc(model, m);
+    mdl->register_decl(c, a.mk_int(4));
+    func_interp* fi = alloc(func_interp, m, 1);
+    expr* one = a.mk_int(1);
+    fi->insert_new_entry(&one, a.mk_int(2));
+    fi->set_else(a.mk_int(7));
+    mdl->register_decl(g, fi);
+
+    ast_binary_writer out(m);
+    model2binary(*mdl, out);
+    ast_binary_reader in(m, out.data().data(), out.data().size());
+    model_ref mdl2 = binary2model(m, in);
+    expr_ref r(m);
+    r = (*mdl2)(m.mk_app(g, a.mk_int(1)));
+    ENSURE(a.is_numeral(r) && r == a.mk_int(2));
+    r = (*mdl2)(m.mk_app(g, m.mk_const(c)));
+    ENSURE(r == a.mk_int(7));
+    ENSURE(mdl2->get_const_interp(c) == a.mk_int(4));
+}
+
+static void tst_goal() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref x(m.mk_const("x", a.mk_int()), m);
+    expr_ref p(m.mk_const("p", m.mk_bool_sort()), m);
+    goal_ref g = alloc(goal, m, false, true, true);
+    g->assert_expr(a.mk_le(x, a.mk_int(3)), p);
+    g->assert_expr(a.mk_ge(x, a.mk_int(1)));
+    ast_binary_writer out(m);
+    goal2binary(*g, out);
+    ast_binary_reader in(m, out.data().data(), out.data().size());
+    goal_ref g2 = binary2goal(m, in);
+    ENSURE(g2->size() == g->size());
+    ENSURE(g2->unsat_core_enabled());
+    for (unsigned i = 0; i < g->size(); ++i) {
+        ENSURE(g->form(i) == g2->form(i));
+        ptr_vector<expr> d1, d2;
+        m.linearize(g->dep(i), d1);
+        m.linearize(g2->dep(i), d2);
+        ENSURE(d1 == d2);
+    }
+}
+
+static void tst_invalid() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    ast_binary_writer out(m);
+    expr_ref_vector fmls(m);
+    fmls.push_back(a.mk_le(m.mk_const("x", a.mk_int()), a.mk_int(3)));
+    out.write_exprs(fmls);
+    std::string data = out.data();
+    data.pop_back();
+    try {
+        ast_binary_reader in(m, data.data(), data.size());
+        expr_ref_vector r(m);
+        in.read_exprs(r);
+        ENSURE(false);
+    }
+    catch (default_exception&) {
+    }
+}
+
+static void tst_flush() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    ast_binary_writer out(m);
+    std::ostringstream strm;
+    expr_ref x(m.mk_const("x", a.mk_int()), m);
+    expr_ref le(a.mk_le(x, a.mk_int(3)), m);
+    expr_ref ge(a.mk_ge(x, a.mk_int(5)), m);
+    out.write_ast(le);
+    out.flush(strm);
+    ENSURE(out.data().empty());
+    // the second value refers to terms written before the flush
+    out.write_ast(m.mk_or(m.mk_not(le), ge));
+    out.write_ast(x);
+    out.flush(strm);
+    std::string data = strm.str();
+    ast_manager m2;
+    reg_decl_plugins(m2);
+    ast_translation tr(m, m2);
+    ast_binary_reader in(m2, data.data(), data.size());
+    expr_ref r1(in.read_expr(), m2);
+    expr_ref r2(in.read_expr(), m2);
+    expr_ref r3(in.read_expr(), m2);
+    ENSURE(in.at_end());
+    ENSURE(r1 == tr(le.get()));
+    ENSURE(r2 == tr(m.mk_or(m.mk_not(le), ge)));
+    ENSURE(r3 == tr(x.get()));
+}
+
+void tst_ast_binary() {
+    tst_exprs();
+    tst_model();
+    tst_goal();
+    tst_invalid();
+    tst_flush();
+}
@@ -0,0 +1,98 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    bound_analyzer.cpp
+
+Abstract:
+
+    Compare the implied bounds of bound_analyzer_on_row_block with
+    those of bound_analyzer_on_row.
+
+--*/
+
+#include "math/lp/lar_solver.h"
+#include "math/lp/bound_analyzer_on_row_block.h"
+#include <tuple>
+
+using namespace lp;
+
+namespace {
+    struct bound_recorder {
+        lar_solver& m_lar;
+        std::vector<std::tuple<unsigned, rational, bool, bool>> m_bounds;
+        bound_recorder(lar_solver& s): m_lar(s) {}
+        lar_solver& lp() { return m_lar; }
+        void add_bound(rational const& v, unsigned j, bool is_low, bool strict, std::function<u_dependency* ()>) {
+            m_bounds.push_back({ j, v, is_low, strict });
+        }
+    };
+}
+
+static void add_random_bounds(random_gen& r, lar_solver& s, lpvar x) {
+    int lo = static_cast<int>(r(21)) - 10;
+    int hi = lo + static_cast<int>(r(10));
+    switch (r(5)) {
+    case 0:
+        break;
+    case 1:
+        s.add_var_bound(x, r(2) ? GE : GT, rational(lo));
+        break;
+    case 2:
+        s.add_var_bound(x, r(2) ? LE : LT, rational(hi));
+        break;
+    case 3:
+        s.add_var_bound(x, GE, rational(lo));
+        s.add_var_bound(x, LE, rational(hi));
+        break;
+    default:
+        s.add_var_bound(x, GE, rational(lo));
+        s.add_var_bound(x, LE, rational(lo));
+        break;
+    }
+}
+
+void tst_bound_analyzer() {
+    typedef row_strip<rational> row;
+    random_gen r(1);
+    for (unsigned iter = 0; iter < 200; ++iter) {
+        lar_solver s;
+        unsigned num_vars = 8;
+        for (unsigned j = 0; j < num_vars; ++j) {
+            lpvar x = s.add_var(j, false);
+            add_random_bounds(r, s, x);
+        }
+        std::vector<row> rows;
+        for (unsigned i = 0; i < 10; ++i) {
+            row rw;
+            for (unsigned j = 0; j < num_vars; ++j) {
+                if (r(3) != 0)
+                    continue;
+                int a = static_cast<int>(r(11)) - 5;
+                if (a == 0)
+                    a = 1;
+                rw.push_back(row_cell<rational>(j, 0, rational(a)));
+            }
+            if (r(10) == 0 && !rw.empty())
+                rw.back().coeff() /= rational(2);
+            rows.push_back(rw);
+        }
+        bound_recorder b1(s), b2(s);
+        bound_analyzer_on_row_block<row, bound_recorder> block(b2);
+        for (row const& rw : rows) {
+            bound_analyzer_on_row<row, bound_recorder>::analyze_row(rw, zero_of_type<numeric_pair<rational>>(), b1);
+            bool all_int = true;
+            for (auto const& c : rw)
+                all_int &= c.coeff().is_int();
+            bool added = block.add_row(rw);
+            ENSURE(added == all_int);
+            if (!added) {
+                block.analyze();
+                bound_analyzer_on_row<row, bound_recorder>::analyze_row(rw, zero_of_type<numeric_pair<rational>>(), b2);
+            }
+        }
+        block.analyze();
+        ENSURE(b1.m_bounds == b2.m_bounds);
+    }
+}
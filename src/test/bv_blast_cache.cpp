@@ -0,0 +1,70 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    bv_blast_cache.cpp
+
+Abstract:
+
+    Tests for the cache of bit-blasted multipliers and dividers.
+
+--*/
+
+#include "smt/smt_context.h"
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "util/statistics.h"
+#include <sstream>
+
+// multipliers that are internalized again after a pop reuse their circuits.
+static void tst_reuse(ast_manager& m) {
+    cmd_context cmd(false, &m);
+    std::istringstream is("(declare-const x (_ BitVec 16))\n(declare-const y (_ BitVec 16))\n"
+                          "(assert (= (bvmul x y) #x0006))\n");
+    VERIFY(parse_smt2_commands(cmd, is));
+    smt_params ps;
+    ps.m_bv_blast_cache = true;
+    smt::context ctx(m, ps);
+    for (unsigned i = 0; i < 3; ++i) {
+        ctx.push();
+        ctx.assert_expr(cmd.assertions().get(0));
+        VERIFY(l_true == ctx.check());
+        ctx.pop(1);
+    }
+    statistics st;
+    ctx.collect_statistics(st);
+    VERIFY(st.get_uint("bv blast cache misses") == 1);
+    VERIFY(st.get_uint("bv blast cache hits") >= 2);
+}
+
+// the circuit cache is cleared instead of growing beyond bv.blast_cache_max_size.
+static void tst_bounded(ast_manager& m) {
+    cmd_context cmd(false, &m);
+    std::istringstream is("(declare-const x (_ BitVec 16))\n(declare-const y (_ BitVec 16))\n"
+                          "(declare-const z (_ BitVec 16))\n"
+                          "(assert (= (bvmul x y) #x0006))\n(assert (= (bvmul x z) #x0006))\n");
+    VERIFY(parse_smt2_commands(cmd, is));
+    smt_params ps;
+    ps.m_bv_blast_cache = true;
+    ps.m_bv_blast_cache_max_size = 64;
+    smt::context ctx(m, ps);
+    for (unsigned i = 0; i < 4; ++i) {
+        ctx.push();
+        ctx.assert_expr(cmd.assertions().get(i % 2));
+        VERIFY(l_true == ctx.check());
+        ctx.pop(1);
+    }
+    statistics st;
+    ctx.collect_statistics(st);
+    VERIFY(st.get_uint("bv blast cache resets") >= 3);
+    VERIFY(st.get_uint("bv blast cache hits") == 0);
+}
+
+void tst_bv_blast_cache() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    tst_reuse(m);
+    tst_bounded(m);
+}
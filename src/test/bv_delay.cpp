@@ -0,0 +1,84 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    bv_delay.cpp
+
+Abstract:
+
+    Tests for delayed internalization of bit-vector operations
+    in the sat.euf core.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "solver/solver.h"
+#include "util/gparams.h"
+#include "util/statistics.h"
+#include <sstream>
+
+// the sat.euf core reads its configuration from the global parameters
+class scoped_gparam {
+    std::string m_name, m_old;
+public:
+    scoped_gparam(char const* name, char const* value): m_name(name), m_old(gparams::get_value(name)) {
+        gparams::set(name, value);
+    }
+    ~scoped_gparam() { gparams::set(m_name.c_str(), m_old.c_str()); }
+};
+
+static lbool solve(char const* script, statistics& st) {
+    scoped_gparam smt("sat.smt", "true");
+    scoped_gparam delay("smt.bv.delay", "true");
+    ast_manager m;
+    reg_decl_plugins(m);
+    cmd_context cmd(false, &m);
+    std::istringstream is(script);
+    VERIFY(parse_smt2_commands(cmd, is));
+    ref<solver> s = mk_smt2_solver(m, params_ref(), symbol::null);
+    for (expr* a : cmd.assertions())
+        s->assert_expr(a);
+    lbool r = s->check_sat(0, nullptr);
+    if (r == l_true) {
+        model_ref mdl;
+        s->get_model(mdl);
+        for (expr* a : cmd.assertions())
+            VERIFY(mdl->is_true(a));
+    }
+    s->collect_statistics(st);
+    return r;
+}
+
+#define DECLS "(declare-const x (_ BitVec 32))\n(declare-const y (_ BitVec 32))\n(declare-const z (_ BitVec 32))\n"
+
+static void check(char const* script, lbool expected, bool blasted) {
+    statistics st;
+    ENSURE(solve(script, st) == expected);
+    unsigned num_delayed = st.get_uint("bv delayed");
+    ENSURE(num_delayed > 0);
+    ENSURE(st.get_uint("bv delayed lemmas") > 0);
+    ENSURE((st.get_uint("bv delayed blasted") > 0) == blasted);
+    ENSURE(st.get_uint("bv delayed blasted") + st.get_uint("bv delayed never blasted") == num_delayed);
+}
+
+void tst_bv_delay() {
+    // the unsatisfiable cases are refuted by word-level lemmas without bit-blasting.
+    // division and remainder by zero, with the divisor only known to be zero after search
+    check(DECLS
+          "(assert (= (bvand y #x0000ffff) #x00000000))\n(assert (bvult y #x00010000))\n"
+          "(assert (or (not (= (bvudiv x y) #xffffffff)) (not (= (bvurem x y) x))))\n", l_false, false);
+    // shifts by at least the bit-width
+    check(DECLS
+          "(assert (bvuge y #x00000020))\n"
+          "(assert (or (not (= (bvshl x y) #x00000000)) (not (= (bvlshr x y) #x00000000))))\n", l_false, false);
+    // the product of odd numbers is odd
+    check(DECLS
+          "(assert (= (bvmul (bvor x #x00000001) (bvor y #x00000001)) (bvshl z #x00000001)))\n", l_false, false);
+    // satisfiable, the model is checked against the assertions
+    check(DECLS
+          "(assert (= (bvmul x y) #x0000a5e1))\n(assert (bvugt x #x00000001))\n(assert (bvugt y #x00000001))\n"
+          "(assert (= (bvlshr z y) #x00000003))\n(assert (= (bvurem z x) #x00000005))\n", l_true, true);
+}
@@ -0,0 +1,110 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    cg_table_bench.cpp
+
+Abstract:
+
+    Opt-in micro-benchmark for congruence closure in smt::context.
+    Creates constants x_i of an uninterpreted sort and unary, binary,
+    commutative and ternary applications over them. Every round pushes a
+    scope, asserts random equalities between the constants, checks and
+    pops. Each round merges classes whose parents must be removed from
+    and reinserted into the congruence table.
+
+    Usage: test-z3 /a cg_table_bench [-n constants] [-e equalities] [-r rounds] [-s seed]
+
+    Reports the number of merged classes and merges per second.
+
+--*/
+
+#include "smt/smt_context.h"
+#include "ast/reg_decl_plugins.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include <iostream>
+
+void tst_cg_table_bench(char ** argv, int argc, int& i) {
+    unsigned n = 2000, num_eqs = 200, rounds = 200, seed = 0;
+    while (i + 2 < argc && argv[i + 1][0] == '-') {
+        switch (argv[i + 1][1]) {
+        case 'n': n = atoi(argv[i + 2]); break;
+        case 'e': num_eqs = atoi(argv[i + 2]); break;
+        case 'r': rounds = atoi(argv[i + 2]); break;
+        case 's': seed = atoi(argv[i + 2]); break;
+        default: std::cout << "unknown option " << argv[i + 1] << "\n"; return;
+        }
+        i += 2;
+    }
+    if (n < 2) {
+        std::cout << "require at least two constants\n";
+        return;
+    }
+
+    ast_manager m;
+    reg_decl_plugins(m);
+    smt_params params;
+    smt::context ctx(m, params);
+    random_gen rand(seed);
+
+    sort_ref u(m.mk_uninterpreted_sort(symbol("U")), m);
+    sort * u1[1] = { u.get() };
+    sort * u2[2] = { u.get(), u.get() };
+    sort * u3[3] = { u.get(), u.get(), u.get() };
+    func_decl_ref f(m.mk_func_decl(symbol("f"), 1, u1, u), m);
+    func_decl_ref g(m.mk_func_decl(symbol("g"), 2, u2, u), m);
+    func_decl_ref h(m.mk_func_decl(symbol("h"), 3, u3, u), m);
+    func_decl_ref p(m.mk_func_decl(symbol("p"), 1, u1, m.mk_bool_sort()), m);
+    func_decl_info comm_info(null_family_id, null_decl_kind);
+    comm_info.set_commutative();
+    func_decl_ref c(m.mk_func_decl(symbol("c"), 2, u2, u, comm_info), m);
+
+    expr_ref_vector xs(m);
+    for (unsigned k = 0; k < n; ++k)
+        xs.push_back(m.mk_fresh_const("x", u));
+    auto x = [&](unsigned k) { return xs.get(k % n); };
+    for (unsigned k = 0; k < n; ++k) {
+        expr_ref fx(m.mk_app(f, x(k)), m);
+        expr_ref gx(m.mk_app(g, x(k), x(k + 1)), m);
+        expr_ref cx(m.mk_app(c, x(k), x(rand(n))), m);
+        expr * hargs[3] = { x(k), x(rand(n)), fx.get() };
+        expr_ref hx(m.mk_app(h.get(), 3, hargs), m);
+        ctx.assert_expr(m.mk_app(p.get(), m.mk_app(f.get(), fx.get())));
+        ctx.assert_expr(m.mk_app(p.get(), m.mk_app(g.get(), gx.get(), cx.get())));
+        ctx.assert_expr(m.mk_app(p.get(), hx.get()));
+    }
+    if (ctx.check() != l_true) {
+        std::cout << "unexpected result\n";
+        return;
+    }
+
+    auto num_merges = [&]() {
+        statistics st;
+        ctx.collect_statistics(st);
+        return st.get_uint("added eqs");
+    };
+
+    unsigned merges = num_merges();
+    stopwatch sw;
+    sw.start();
+    for (unsigned r = 0; r < rounds; ++r) {
+        ctx.push();
+        for (unsigned k = 0; k < num_eqs; ++k)
+            ctx.assert_expr(m.mk_eq(x(rand(n)), x(rand(n))));
+        VERIFY(ctx.check() == l_true);
+        ctx.pop(1);
+    }
+    sw.stop();
+    merges = num_merges() - merges;
+
+    double secs = sw.get_seconds();
+    std::cout << "(cg-table-bench :constants " << n
+              << "\n  :enodes " << ctx.enodes().size()
+              << "\n  :rounds " << rounds
+              << "\n  :merges " << merges
+              << "\n  :time " << secs
+              << "\n  :merges-per-second " << (secs > 0 ? merges / secs : 0.0)
+              << ")\n";
+}
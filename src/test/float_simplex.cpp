@@ -0,0 +1,118 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    float_simplex.cpp
+
+Abstract:
+
+    Compare lar_solver with and without the double precision simplex.
+
+--*/
+
+#include "math/lp/lar_solver.h"
+#include "util/rational.h"
+
+using namespace lp;
+
+struct term_bound {
+    vector<std::pair<rational, lpvar>> m_coeffs;
+    lconstraint_kind                   m_kind;
+    rational                           m_bound;
+};
+
+// small enough for the rational baseline to stay fast, the test only compares outcomes
+static unsigned const num_vars = 12, num_terms = 24;
+
+static lp_status solve_random(unsigned seed, bool use_float, bool add_conflict, lar_solver& solver, vector<term_bound>& bounds) {
+    random_gen rand(seed);
+    solver.settings().float_simplex() = use_float;
+    solver.settings().float_simplex_min_rows() = 0;
+    for (unsigned j = 0; j < num_vars; ++j) {
+        lpvar x = solver.add_var(j, false);
+        solver.add_var_bound(x, GE, rational(0));
+        solver.add_var_bound(x, LE, rational(10));
+    }
+    for (unsigned k = 0; k < num_terms; ++k) {
+        vector<std::pair<rational, lpvar>> coeffs;
+        for (unsigned j = 0; j < num_vars; ++j)
+            if (rand(3) == 0)
+                coeffs.push_back({ rational(static_cast<int>(rand(7)) - 3, 1 + rand(2)), j });
+        if (coeffs.empty())
+            continue;
+        lpvar t = solver.add_term(coeffs, num_vars + k);
+        // x = 1,...,1 satisfies t >= sum - 1
+        rational sum(0);
+        for (auto const& [c, j] : coeffs)
+            sum += c;
+        solver.add_var_bound(t, GE, sum - rational(1));
+        bounds.push_back({ coeffs, GE, sum - rational(1) });
+        if (rand(2) == 0) {
+            solver.add_var_bound(t, LT, sum + rational(2));
+            bounds.push_back({ coeffs, LT, sum + rational(2) });
+        }
+    }
+    if (add_conflict) {
+        vector<std::pair<rational, lpvar>> coeffs;
+        coeffs.push_back({ rational(1), 0 });
+        coeffs.push_back({ rational(1), 1 });
+        lpvar t = solver.add_term(coeffs, num_vars + num_terms);
+        solver.add_var_bound(t, GT, rational(20));
+        bounds.push_back({ coeffs, GT, rational(20) });
+    }
+    return solver.find_feasible_solution();
+}
+
+static bool holds(lar_solver& solver, vector<term_bound> const& bounds) {
+    std::unordered_map<lpvar, rational> values;
+    solver.get_model(values);
+    for (auto const& b : bounds) {
+        rational v(0);
+        for (auto const& [c, j] : b.m_coeffs)
+            v += c * values[j];
+        switch (b.m_kind) {
+        case GE: if (v < b.m_bound) return false; break;
+        case GT: if (v <= b.m_bound) return false; break;
+        case LT: if (v >= b.m_bound) return false; break;
+        default: break;
+        }
+    }
+    for (unsigned j = 0; j < num_vars; ++j)
+        if (values[j] < rational(0) || values[j] > rational(10))
+            return false;
+    return true;
+}
+
+void tst_float_simplex() {
+    unsigned calls = 0;
+    for (unsigned seed = 0; seed < 8; ++seed) {
+        for (bool conflict : { false, true }) {
+            lar_solver s1, s2;
+            vector<term_bound> b1, b2;
+            lp_status r1 = solve_random(seed, false, conflict, s1, b1);
+            lp_status r2 = solve_random(seed, true, conflict, s2, b2);
+            calls += s2.settings().stats().m_float_simplex_calls;
+            ENSURE((r1 == lp_status::INFEASIBLE) == (r2 == lp_status::INFEASIBLE));
+            if (r2 == lp_status::INFEASIBLE) {
+                ENSURE(conflict);
+                explanation ex;
+                s2.get_infeasibility_explanation(ex);
+                ENSURE(ex.size() > 0);
+            }
+            else
+                ENSURE(holds(s2, b2));
+        }
+    }
+    ENSURE(calls > 0);
+
+    // the first search uses the double precision simplex, a search after one
+    // with fewer pivots than the threshold does not
+    lar_solver s;
+    vector<term_bound> b;
+    lp_status r = solve_random(0, true, false, s, b);
+    ENSURE(s.settings().stats().m_float_simplex_calls == 1);
+    s.settings().float_simplex_min_pivots() = UINT_MAX;
+    ENSURE(s.find_feasible_solution() == r);
+    ENSURE(s.settings().stats().m_float_simplex_calls == 1);
+}
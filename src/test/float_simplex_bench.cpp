@@ -0,0 +1,133 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    float_simplex_bench.cpp
+
+Abstract:
+
+    Opt-in micro-benchmark for the double precision simplex of lar_solver.
+    Creates variables in [0, 10] and sparse terms over them whose bounds
+    hold at x = 1. After an initial feasibility check, every round pushes a
+    scope, tightens the bounds of a few random terms, checks and pops.
+    The same instance is solved without the double precision simplex, with
+    it at its default pivot threshold and with it before every check.
+
+    Usage: test-z3 /a float_simplex_bench [-n vars] [-m terms] [-r rounds] [-s seed]
+
+    Reports the time, the checks, the double precision simplex calls and
+    the exact pivots of each configuration.
+
+--*/
+
+#include "math/lp/lar_solver.h"
+#include "util/stopwatch.h"
+#include "util/rational.h"
+#include <iostream>
+
+using namespace lp;
+
+namespace {
+    struct bench_config {
+        char const * m_name;
+        bool         m_float;
+        unsigned     m_min_pivots;
+    };
+
+    struct bench_result {
+        double   m_seconds = 0;
+        unsigned m_sat = 0, m_unsat = 0, m_calls = 0, m_pivots = 0;
+    };
+}
+
+static bench_result run_bench(bench_config const& cfg, unsigned n, unsigned m, unsigned rounds, unsigned seed) {
+    random_gen rand(seed);
+    lar_solver s;
+    s.settings().float_simplex() = cfg.m_float;
+    s.settings().float_simplex_min_pivots() = cfg.m_min_pivots;
+    for (unsigned j = 0; j < n; ++j) {
+        lpvar x = s.add_var(j, false);
+        s.add_var_bound(x, GE, rational(0));
+        s.add_var_bound(x, LE, rational(10));
+    }
+    vector<lpvar> terms;
+    vector<rational> sums;
+    for (unsigned k = 0; k < m; ++k) {
+        vector<std::pair<rational, lpvar>> coeffs;
+        rational sum(0);
+        for (unsigned l = 0; l < 6; ++l) {
+            rational c(static_cast<int>(rand(9)) - 4, 1 + rand(3));
+            if (c.is_zero())
+                continue;
+            coeffs.push_back({ c, rand(n) });
+            sum += c;
+        }
+        if (coeffs.empty())
+            continue;
+        lpvar t = s.add_term(coeffs, n + k);
+        // x = 1,...,1 satisfies the bounds
+        s.add_var_bound(t, GE, sum - rational(1 + rand(3)));
+        s.add_var_bound(t, LE, sum + rational(1 + rand(3)));
+        terms.push_back(t);
+        sums.push_back(sum);
+    }
+    bench_result r;
+    stopwatch sw;
+    sw.start();
+    auto check = [&]() {
+        if (s.find_feasible_solution() == lp_status::INFEASIBLE)
+            ++r.m_unsat;
+        else
+            ++r.m_sat;
+    };
+    check();
+    for (unsigned i = 0; i < rounds; ++i) {
+        s.push();
+        for (unsigned l = 0; l < 4; ++l) {
+            unsigned k = rand(terms.size());
+            // usually satisfiable, sometimes conflicting with other bounds
+            s.add_var_bound(terms[k], GE, sums[k] + rational(static_cast<int>(rand(5)) - 3));
+        }
+        check();
+        s.pop(1);
+    }
+    sw.stop();
+    r.m_seconds = sw.get_seconds();
+    r.m_calls = s.settings().stats().m_float_simplex_calls;
+    r.m_pivots = s.settings().stats().m_total_iterations;
+    return r;
+}
+
+void tst_float_simplex_bench(char ** argv, int argc, int& i) {
+    unsigned n = 300, m = 600, rounds = 200, seed = 0;
+    while (i + 2 < argc && argv[i + 1][0] == '-') {
+        switch (argv[i + 1][1]) {
+        case 'n': n = atoi(argv[i + 2]); break;
+        case 'm': m = atoi(argv[i + 2]); break;
+        case 'r': rounds = atoi(argv[i + 2]); break;
+        case 's': seed = atoi(argv[i + 2]); break;
+        default: std::cout << "unknown option " << argv[i + 1] << "\n"; return;
+        }
+        i += 2;
+    }
+    if (n == 0) {
+        std::cout << "require at least one variable\n";
+        return;
+    }
+    lp_settings defaults;
+    bench_config configs[] = {
+        { "exact",  false, 0 },
+        { "gated",  true,  defaults.float_simplex_min_pivots() },
+        { "always", true,  0 },
+    };
+    for (auto const& cfg : configs) {
+        bench_result r = run_bench(cfg, n, m, rounds, seed);
+        std::cout << "(float-simplex-bench :config " << cfg.m_name
+                  << "\n  :time " << r.m_seconds
+                  << "\n  :sat " << r.m_sat
+                  << "\n  :unsat " << r.m_unsat
+                  << "\n  :float-calls " << r.m_calls
+                  << "\n  :exact-pivots " << r.m_pivots << ")\n";
+    }
+}
@@ -54,6 +54,8 @@
     X(rational) \
     X(inf_rational) \
     X(ast) \
+    X(ast_binary) \
+    X(aig) \
     X(optional) \
     X(bit_vector) \
     X(fixed_bit_vector) \
@@ -70,8 +72,10 @@
     X(small_object_allocator) \
     X(timeout) \
     X(proof_checker) \
+    X(proof_log_binary) \
     X(simplifier) \
     X(bit_blaster) \
+    X(bv_delay) \
     X(var_subst) \
     X(simple_parser) \
     X(scanner_io) \
@@ -85,9 +89,11 @@
     X(api_algebraic) \
     X(api_polynomial) \
     X(api_pb) \
+    X(api_solver_binary) \
     X(api_datalog) \
     X(parametric_datatype) \
     X(cube_clause) \
+    X(query_cache) \
     X(old_interval) \
     X(get_implied_equalities) \
     X(arith_simplifier_plugin) \
@@ -122,6 +128,13 @@
     X(seq_monadic_bench) \
     X(check_assumptions) \
     X(smt_context) \
+    X(smt_parallel) \
+    X(smt2_streaming) \
+    X(smt2_parallel_parser) \
+    X(mbqi_threads) \
+    X(qi_cache) \
+    X(bv_blast_cache) \
+    X(sls_walkers) \
     X(theory_dl) \
     X(model_retrieval) \
     X(model_based_opt) \
@@ -138,6 +151,7 @@
     X(nla_intervals) \
     X(horner) \
     X(prime_generator) \
+    X(profile) \
     X(permutation) \
     X(nlsat) \
     X(13) \
@@ -176,7 +190,14 @@
     X(sorting_network) \
     X(theory_pb) \
     X(simplex) \
+    X(float_simplex) \
+    X_ARGV(float_simplex_bench) \
+    X(bound_analyzer) \
     X(sat_user_scope) \
+    X(sat_proof_trim) \
+    X(sat_arena) \
+    X(sat_async_simplifier) \
+    X(sat_sim_sweep) \
     X_ARGV(ddnf) \
     X(ddnf1) \
     X(model_evaluator) \
@@ -184,6 +205,9 @@
     X(pb2bv) \
     X_ARGV(sat_lookahead) \
     X_ARGV(sat_local_search) \
+    X_ARGV(sat_propagate_bench) \
+    X_ARGV(cg_table_bench) \
+    X_ARGV(mam_bench) \
     X_ARGV(cnf_backbones) \
     X(bdd) \
     X(pdd) \
@@ -0,0 +1,133 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    mam_bench.cpp
+
+Abstract:
+
+    Opt-in micro-benchmark for the E-matching code tree interpreters.
+    Creates constants a_i of an uninterpreted sort and ground terms
+    f(g(a_i), h(a_j)) for random j. The pattern f(g(x), h(x)) of the
+    quantifier only matches terms whose arguments were merged, and the
+    instances only add literals over existing terms. Every round pushes
+    a scope, asserts random equalities between the constants, checks and
+    pops, so most of the time goes to matching the new merges.
+
+    Usage: test-z3 /a mam_bench [-n constants] [-e equalities] [-r rounds] [-s seed] [-euf]
+
+    -euf uses the SAT based core (sat.smt=true) and its interpreter in
+    ast/euf/euf_mam.cpp instead of the one in smt/mam.cpp.
+
+    Reports the instances and instances per second. Every instance is a
+    match of the interpreter that was not filtered as a duplicate.
+
+--*/
+
+#include "smt/smt_solver.h"
+#include "sat/sat_solver/inc_sat_solver.h"
+#include "ast/reg_decl_plugins.h"
+#include "util/stopwatch.h"
+#include "util/statistics.h"
+#include <iostream>
+#include <cstring>
+
+void tst_mam_bench(char ** argv, int argc, int& i) {
+    unsigned n = 1000, num_eqs = 100, rounds = 100, seed = 0;
+    bool euf = false;
+    while (i + 1 < argc && argv[i + 1][0] == '-') {
+        if (strcmp(argv[i + 1], "-euf") == 0) {
+            euf = true;
+            i += 1;
+            continue;
+        }
+        if (i + 2 >= argc)
+            break;
+        switch (argv[i + 1][1]) {
+        case 'n': n = atoi(argv[i + 2]); break;
+        case 'e': num_eqs = atoi(argv[i + 2]); break;
+        case 'r': rounds = atoi(argv[i + 2]); break;
+        case 's': seed = atoi(argv[i + 2]); break;
+        default: std::cout << "unknown option " << argv[i + 1] << "\n"; return;
+        }
+        i += 2;
+    }
+    if (n < 2) {
+        std::cout << "require at least two constants\n";
+        return;
+    }
+
+    ast_manager m;
+    reg_decl_plugins(m);
+    params_ref p;
+    p.set_bool("auto_config", false);
+    p.set_bool("mbqi", false);
+    solver_ref s;
+    if (euf) {
+        p.set_bool("smt", true);
+        s = mk_inc_sat_solver(m, p);
+    }
+    else
+        s = mk_smt_solver(m, p, symbol::null);
+    random_gen rand(seed);
+
+    sort_ref u(m.mk_uninterpreted_sort(symbol("U")), m);
+    sort * u1[1] = { u.get() };
+    sort * u2[2] = { u.get(), u.get() };
+    func_decl_ref f(m.mk_func_decl(symbol("f"), 2, u2, u), m);
+    func_decl_ref g(m.mk_func_decl(symbol("g"), 1, u1, u), m);
+    func_decl_ref h(m.mk_func_decl(symbol("h"), 1, u1, u), m);
+    func_decl_ref q(m.mk_func_decl(symbol("q"), 1, u1, m.mk_bool_sort()), m);
+    func_decl_ref r(m.mk_func_decl(symbol("r"), 1, u1, m.mk_bool_sort()), m);
+
+    expr_ref_vector xs(m);
+    for (unsigned k = 0; k < n; ++k)
+        xs.push_back(m.mk_fresh_const("a", u));
+    for (unsigned k = 0; k < n; ++k) {
+        expr_ref t(m.mk_app(f, m.mk_app(g, xs.get(k)), m.mk_app(h, xs.get(rand(n)))), m);
+        s->assert_expr(m.mk_app(q, t.get()));
+        s->assert_expr(m.mk_app(r, xs.get(k)));
+    }
+    // forall x. r(x) or not q(f(g(x), h(x))), with pattern f(g(x), h(x))
+    expr_ref x(m.mk_var(0, u), m);
+    expr_ref pat_t(m.mk_app(f, m.mk_app(g, x.get()), m.mk_app(h, x.get())), m);
+    app_ref pat(m.mk_pattern(to_app(pat_t)), m);
+    expr_ref body(m.mk_or(m.mk_app(r, x.get()), m.mk_not(m.mk_app(q, pat_t.get()))), m);
+    symbol x_name("x");
+    expr * pats[1] = { pat.get() };
+    s->assert_expr(m.mk_forall(1, u1, &x_name, body, 0, symbol("mam_bench"), symbol::null, 1, pats));
+    if (s->check_sat() != l_true) {
+        std::cout << "unexpected result\n";
+        return;
+    }
+
+    char const * key = euf ? "q instantiations" : "quant instantiations";
+    auto num_instances = [&]() {
+        statistics st;
+        s->collect_statistics(st);
+        return st.get_uint(key);
+    };
+
+    unsigned instances = num_instances();
+    stopwatch sw;
+    sw.start();
+    for (unsigned k = 0; k < rounds; ++k) {
+        s->push();
+        for (unsigned l = 0; l < num_eqs; ++l)
+            s->assert_expr(m.mk_eq(xs.get(rand(n)), xs.get(rand(n))));
+        VERIFY(s->check_sat() == l_true);
+        s->pop(1);
+    }
+    sw.stop();
+    instances = num_instances() - instances;
+
+    double secs = sw.get_seconds();
+    std::cout << "(mam-bench :core " << (euf ? "euf" : "smt")
+              << "\n  :constants " << n
+              << "\n  :rounds " << rounds
+              << "\n  :instances " << instances
+              << "\n  :time " << secs
+              << "\n  :instances-per-second " << (secs > 0 ? instances / secs : 0.0)
+              << ")\n";
+}
@@ -0,0 +1,49 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    mbqi_threads.cpp
+
+Abstract:
+
+    Tests for checking MBQI quantifiers on several threads.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "solver/solver.h"
+#include <sstream>
+
+// checking quantifiers on several threads does not change the results of MBQI.
+static void tst_threads(ast_manager& m) {
+    std::ostringstream script;
+    script << "(declare-sort U 0)\n(declare-fun f (U) U)\n(declare-fun P (U) Bool)\n(declare-const a U)\n"
+           << "(assert (forall ((x U)) (= (f (f x)) x)))\n"
+           << "(assert (forall ((x U)) (=> (P x) (not (P (f x))))))\n"
+           << "(assert (P a))\n";
+    for (unsigned i = 0; i < 12; ++i)
+        script << "(declare-fun g" << i << " (Int) Int)\n"
+               << "(assert (forall ((x Int)) (>= (g" << i << " x) (+ x " << i << "))))\n";
+    for (bool unsat : { false, true }) {
+        for (unsigned threads : { 1, 4 }) {
+            cmd_context cmd(false, &m);
+            std::istringstream is(script.str() + (unsat ? "(assert (< (g7 3) 9))\n" : "(assert (> (g7 3) 9))\n"));
+            VERIFY(parse_smt2_commands(cmd, is));
+            params_ref p;
+            p.set_uint("mbqi.threads", threads);
+            ref<solver> slv = mk_smt2_solver(m, p, symbol::null);
+            for (expr* a : cmd.assertions())
+                slv->assert_expr(a);
+            VERIFY((unsat ? l_false : l_true) == slv->check_sat(0, nullptr));
+        }
+    }
+}
+
+void tst_mbqi_threads() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    tst_threads(m);
+}
@@ -160,7 +160,62 @@ static void tst_prev_power_2() {
     tst_prev_power_2((1ll << 60), 3, 58);
 }
 
+static int random_small(random_gen & r) {
+    switch (r(4)) {
+    case 0: return INT_MAX - static_cast<int>(r(3));
+    case 1: return INT_MIN + static_cast<int>(r(3));
+    case 2: return static_cast<int>(r(20)) - 10;
+    default: return static_cast<int>(r()) - static_cast<int>(r());
+    }
+}
+
+static int random_den(random_gen & r) {
+    int d = random_small(r);
+    return d == INT_MIN ? INT_MAX : std::max(1, std::abs(d));
+}
+
+// compare the fast paths for small numerators and denominators with
+// the general code, which is used once the operands are scaled by 2^70.
+static void tst_small_rat() {
+    unsynch_mpq_manager m;
+    random_gen r(0);
+    mpq a, b, c, d, k, ak, bk;
+    m.power(mpq(2), 70, k);
+    for (unsigned i = 0; i < 10000; ++i) {
+        int den1 = random_den(r);
+        int den2 = random_den(r);
+        m.set(a, random_small(r), den1);
+        m.set(b, random_small(r), den2);
+        ENSURE(m.is_small(a) && m.is_small(b));
+        m.mul(a, k, ak);
+        m.mul(b, k, bk);
+        ENSURE(!m.is_small(ak) || m.is_zero(a));
+
+        m.add(a, b, c);
+        m.mul(c, k, c);
+        m.add(ak, bk, d);
+        ENSURE(m.eq(c, d));
+
+        m.sub(a, b, c);
+        m.mul(c, k, c);
+        m.sub(ak, bk, d);
+        ENSURE(m.eq(c, d));
+
+        m.mul(a, b, c);
+        m.mul(c, k, c);
+        m.mul(c, k, c);
+        m.mul(ak, bk, d);
+        ENSURE(m.eq(c, d));
+
+        ENSURE(m.lt(a, b) == m.lt(ak, bk));
+        ENSURE(m.lt(b, a) == m.lt(bk, ak));
+    }
+    m.del(a); m.del(b); m.del(c); m.del(d);
+    m.del(k); m.del(ak); m.del(bk);
+}
+
 void tst_mpq() {
+    tst_small_rat();
     tst_prev_power_2();
     set_str_bug();
     bug2();
@@ -0,0 +1,64 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    profile.cpp
+
+Abstract:
+
+    Test the profiling timers and the trace export.
+
+--*/
+
+#include "util/profile.h"
+#include "util/debug.h"
+#include <sstream>
+#include <string>
+#include <thread>
+
+static profile::site s_outer("test.outer");
+static profile::site s_inner("test.inner");
+static profile::site s_count("test.count");
+
+static void work(unsigned n) {
+    profile::scope outer(s_outer);
+    for (unsigned i = 0; i < n; ++i) {
+        profile::scope inner(s_inner);
+        if (profile::enabled())
+            profile::count(s_count, 2);
+    }
+}
+
+void tst_profile() {
+    profile::reset();
+    work(10);
+    std::ostringstream before;
+    profile::display(before);
+    ENSURE(before.str().find("test.outer") == std::string::npos);
+
+    profile::enable("", 5);
+    work(10);
+    std::thread t([]() { work(3); });
+    t.join();
+    profile::disable();
+    work(10);
+
+    std::ostringstream summary;
+    profile::display(summary);
+    ENSURE(summary.str().find("(profile :site test.inner :calls 13 ") != std::string::npos);
+    ENSURE(summary.str().find(":count 26)") != std::string::npos);
+
+    std::ostringstream trace;
+    profile::write_trace(trace);
+    std::string json = trace.str();
+    ENSURE(json.find("{\"traceEvents\":[") == 0);
+    ENSURE(json.find("\"name\":\"test.outer\",\"cat\":\"z3\",\"ph\":\"X\"") != std::string::npos);
+    ENSURE(json.find("\"tid\":1") != std::string::npos);
+    // at most 5 events per thread
+    unsigned num_events = 0;
+    for (size_t pos = json.find("\"ph\":\"X\""); pos != std::string::npos; pos = json.find("\"ph\":\"X\"", pos + 1))
+        ++num_events;
+    ENSURE(num_events == 5 + 4);
+    profile::reset();
+}
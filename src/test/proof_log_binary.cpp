@@ -0,0 +1,123 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    proof_log_binary.cpp
+
+Abstract:
+
+    Write binary clause proof logs (solver.proof.log_binary) with the
+    SMT core and with the sat.euf core, and check them offline.
+    Records written after the tables of the writer are reset read back
+    to the same terms.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/proof_log_binary.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "sat/smt/euf_proof_checker.h"
+#include "smt/smt_solver.h"
+#include "solver/solver.h"
+#include "util/gparams.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+// the SMT core and the sat.euf core read the proof log parameters from the global parameters
+class scoped_gparam {
+    std::string m_name, m_old;
+public:
+    scoped_gparam(char const* name, char const* value): m_name(name), m_old(gparams::get_value(name)) {
+        gparams::set(name, value);
+    }
+    ~scoped_gparam() { gparams::set(m_name.c_str(), m_old.c_str()); }
+};
+
+static char const* g_script =
+    "(declare-fun f (Int) Int)\n(declare-const x Int)\n(declare-const y Int)\n"
+    "(assert (<= x y))\n(assert (<= y x))\n(assert (not (= (f x) (f y))))\n";
+
+static void solve_and_check(bool use_euf) {
+    char const* log_file = use_euf ? "proof_log_binary_euf.zproof" : "proof_log_binary_smt.zproof";
+    {
+        scoped_gparam log("solver.proof.log", log_file);
+        scoped_gparam binary("solver.proof.log_binary", "true");
+        scoped_gparam euf("sat.smt", use_euf ? "true" : "false");
+        ast_manager m;
+        reg_decl_plugins(m);
+        cmd_context cmd(false, &m);
+        std::istringstream is(g_script);
+        VERIFY(parse_smt2_commands(cmd, is));
+        ref<solver> s = use_euf ? mk_smt2_solver(m, params_ref(), symbol::null) : mk_smt_solver(m, params_ref(), symbol::null);
+        for (expr* a : cmd.assertions())
+            s->assert_expr(a);
+        ENSURE(s->check_sat(0, nullptr) == l_false);
+    }
+
+    std::ifstream in(log_file, std::ios::in | std::ios::binary);
+    ENSURE(in);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::remove(log_file);
+    // the log is not text
+    ENSURE(data.find("(assume") == std::string::npos && data.find("(infer") == std::string::npos);
+
+    // the log is checked in a fresh manager, as by the offline checker of the shell
+    ast_manager m;
+    reg_decl_plugins(m);
+    euf::smt_proof_checker checker(m, params_ref());
+    euf::smt_proof_checker::replay_stats st;
+    std::istringstream log(data);
+    checker.replay(log, st);
+    ENSURE(st.m_num_assumptions >= 3);
+    ENSURE(st.m_num_inferences > 0);
+}
+
+// the writer pins a bounded number of terms, terms are defined again after a reset.
+static void tst_reset() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    unsigned const max_defined = 8;
+    std::ostringstream out;
+    proof_log_binary_writer writer(m, out, max_defined);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    vector<expr_ref_vector> clauses;
+    for (unsigned i = 0; i < 50; ++i) {
+        expr_ref_vector c(m);
+        c.push_back(a.mk_le(x, a.mk_int(i)));
+        c.push_back(m.mk_not(a.mk_ge(x, a.mk_int(i % 7))));
+        app_ref hint(m.mk_app(symbol("rup"), 0, nullptr, m.mk_proof_sort()), m);
+        writer.log(i % 3 == 0 ? proof_log_record::assume : proof_log_record::infer, c.size(), c.data(), i % 3 == 0 ? nullptr : hint.get());
+        // the definitions of one record are added on top of the bound
+        ENSURE(writer.num_defined() < max_defined + 10);
+        clauses.push_back(c);
+    }
+
+    // read through a stream, terms of the same manager are read back to the same pointers
+    std::istringstream in(out.str());
+    proof_log_binary_reader reader(m, in);
+    proof_log_record r;
+    expr_ref_vector lits(m);
+    expr_ref hint(m);
+    unsigned i = 0;
+    while (reader.next(r, lits, hint)) {
+        ENSURE(i < clauses.size());
+        ENSURE(r == (i % 3 == 0 ? proof_log_record::assume : proof_log_record::infer));
+        ENSURE(lits == clauses[i]);
+        ENSURE(!hint == (i % 3 == 0));
+        ++i;
+    }
+    ENSURE(i == clauses.size());
+}
+
+void tst_proof_log_binary() {
+    tst_reset();
+    solve_and_check(false);
+    solve_and_check(true);
+}
@@ -0,0 +1,83 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    qi_cache.cpp
+
+Abstract:
+
+    Tests for the quantifier instance cache that survives pop.
+
+--*/
+
+#include "smt/smt_context.h"
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "util/statistics.h"
+#include <sstream>
+
+// the instance cache survives pop and re-asserts instances that keep coming back,
+// also in scopes that do not contain their trigger (f c).
+static void tst_replay(ast_manager& m) {
+    cmd_context cmd(false, &m);
+    std::istringstream is("(declare-fun f (Int) Int)\n(declare-const c Int)\n"
+                          "(assert (forall ((x Int)) (! (> (f x) x) :pattern ((f x)))))\n"
+                          "(assert (< (f c) c))\n(assert (> c 0))\n");
+    VERIFY(parse_smt2_commands(cmd, is));
+    smt_params ps;
+    ps.m_mbqi = false;
+    ps.m_qi_cache = true;
+    smt::context ctx(m, ps);
+    ctx.assert_expr(cmd.assertions().get(0));
+    for (unsigned i = 0; i < 4; ++i) {
+        for (bool unsat : { true, false }) {
+            ctx.push();
+            ctx.assert_expr(cmd.assertions().get(unsat ? 1 : 2));
+            // without MBQI the satisfiable case may be reported as unknown
+            lbool r = ctx.check();
+            VERIFY(unsat ? r == l_false : r != l_false);
+            ctx.pop(1);
+        }
+    }
+    statistics st;
+    ctx.collect_statistics(st);
+    VERIFY(st.get_uint("quant cache misses") == 1);
+    VERIFY(st.get_uint("quant cache hits") > 0);
+    VERIFY(st.get_uint("quant cache replays") > 0);
+}
+
+// the instance cache is bounded by qi.cache_max_size: distinct instances evict each other.
+static void tst_bounded(ast_manager& m) {
+    cmd_context cmd(false, &m);
+    std::ostringstream script;
+    script << "(declare-fun f (Int) Int)\n(assert (forall ((x Int)) (! (> (f x) x) :pattern ((f x)))))\n";
+    for (unsigned i = 0; i < 20; ++i)
+        script << "(declare-const c" << i << " Int)\n(assert (< (f c" << i << ") c" << i << "))\n";
+    std::istringstream is(script.str());
+    VERIFY(parse_smt2_commands(cmd, is));
+    smt_params ps;
+    ps.m_mbqi = false;
+    ps.m_qi_cache = true;
+    ps.m_qi_cache_max_size = 4;
+    smt::context ctx(m, ps);
+    ctx.assert_expr(cmd.assertions().get(0));
+    for (unsigned i = 1; i <= 20; ++i) {
+        ctx.push();
+        ctx.assert_expr(cmd.assertions().get(i));
+        VERIFY(ctx.check() == l_false);
+        ctx.pop(1);
+    }
+    statistics st;
+    ctx.collect_statistics(st);
+    VERIFY(st.get_uint("quant cache misses") == 20);
+    VERIFY(st.get_uint("quant cache evictions") >= 16);
+}
+
+void tst_qi_cache() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    tst_replay(m);
+    tst_bounded(m);
+}
@@ -0,0 +1,109 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    query_cache.cpp
+
+Abstract:
+
+    Tests for the query canonizer and the query cache solver.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "solver/query_cache_solver.h"
+#include "solver/solver.h"
+#include "smt/smt_solver.h"
+#include "model/model.h"
+#include "util/statistics.h"
+#include <filesystem>
+
+static std::string canonical_key(ast_manager& m, expr_ref_vector const& fmls) {
+    query_canonizer canon(m);
+    std::string key;
+    expr_ref_vector asms(m);
+    VERIFY(canon(fmls, asms, key));
+    return key;
+}
+
+static void tst_canonizer() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref x(m.mk_const("x", a.mk_int()), m);
+    expr_ref y(m.mk_const("y", a.mk_int()), m);
+    expr_ref u(m.mk_const("u", a.mk_int()), m);
+    expr_ref v(m.mk_const("v", a.mk_int()), m);
+    expr_ref_vector f1(m), f2(m), f3(m);
+    f1.push_back(a.mk_gt(a.mk_add(x, a.mk_mul(a.mk_int(2), y)), a.mk_int(3)));
+    f1.push_back(m.mk_eq(x, a.mk_int(1)));
+    // alpha-renamed, with commutative arguments and assertions permuted
+    f2.push_back(m.mk_eq(a.mk_int(1), u));
+    f2.push_back(a.mk_gt(a.mk_add(a.mk_mul(v, a.mk_int(2)), u), a.mk_int(3)));
+    // same shape, different constant
+    f3.push_back(a.mk_gt(a.mk_add(x, a.mk_mul(a.mk_int(2), y)), a.mk_int(4)));
+    f3.push_back(m.mk_eq(x, a.mk_int(1)));
+    ENSURE(canonical_key(m, f1) == canonical_key(m, f2));
+    ENSURE(canonical_key(m, f1) != canonical_key(m, f3));
+}
+
+// with late set, the cache file is set after the solver was created.
+static lbool check_cached(char const* file, bool late, char const* x_name, char const* y_name, unsigned& hits, rational& x_val) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    params_ref p;
+    p.set_sym("cache.file", symbol(file));
+    solver* s0 = mk_smt_solver(m, late ? params_ref() : p, symbol::null);
+    ref<solver> s = mk_query_cache_solver(s0);
+    if (late) {
+        ENSURE(s.get() == s0);
+        s->updt_params(p);
+        s = mk_query_cache_solver(s0);
+    }
+    else
+        s->updt_params(p);
+    ENSURE(s.get() != s0);
+    expr_ref x(m.mk_const(x_name, a.mk_int()), m);
+    expr_ref y(m.mk_const(y_name, a.mk_int()), m);
+    s->assert_expr(a.mk_gt(a.mk_add(x, y), a.mk_int(10)));
+    s->assert_expr(a.mk_lt(x, a.mk_int(3)));
+    s->assert_expr(a.mk_lt(y, a.mk_int(10)));
+    lbool r = s->check_sat();
+    if (r == l_true) {
+        model_ref mdl;
+        s->get_model(mdl);
+        ENSURE(mdl);
+        ENSURE(mdl->is_true(s->get_assertion(0)));
+        expr_ref val = (*mdl)(x);
+        VERIFY(a.is_numeral(val, x_val));
+    }
+    statistics st;
+    s->collect_statistics(st);
+    hits = st.get_uint("query-cache hits");
+    return r;
+}
+
+static void tst_cache_solver() {
+    std::string path = (std::filesystem::temp_directory_path() / "z3_query_cache_test.tmp").string();
+    char const* file = path.c_str();
+    std::filesystem::remove(path);
+    unsigned hits = 0;
+    rational x1, x2, x3;
+    ENSURE(l_true == check_cached(file, false, "x", "y", hits, x1));
+    ENSURE(hits == 0);
+    ENSURE(l_true == check_cached(file, false, "a", "b", hits, x2));
+    ENSURE(hits == 1);
+    ENSURE(x1 == x2);
+    ENSURE(l_true == check_cached(file, true, "c", "d", hits, x3));
+    ENSURE(hits == 1);
+    ENSURE(x1 == x3);
+    std::filesystem::remove(path);
+}
+
+void tst_query_cache() {
+    tst_canonizer();
+    tst_cache_solver();
+}
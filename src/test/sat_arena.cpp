@@ -0,0 +1,89 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_arena.cpp
+
+Abstract:
+
+    Test reuse of freed blocks in the clause arena.
+
+--*/
+
+#include "sat/sat_allocator.h"
+
+static void tst_split() {
+    sat_arena a("test");
+    // sizes are in bytes, the arena works in 8-byte slots
+    unsigned big = a.allocate(8 * 300);
+    unsigned guard = a.allocate(8 * 10);
+    a.deallocate(8 * 300, big);
+    // a smaller large object reuses the block, the remainder is kept
+    unsigned o1 = a.allocate(8 * 200);
+    ENSURE(o1 == big);
+    unsigned o2 = a.allocate(8 * 100);
+    ENSURE(o2 == big + 200);
+    ENSURE(a.get(o2) == a.get(o1) + 8 * 200);
+    // nothing is left of the block, the next object is bumped
+    unsigned o3 = a.allocate(8 * 150);
+    ENSURE(o3 > guard);
+    a.deallocate(8 * 200, o1);
+    a.deallocate(8 * 100, o2);
+    // the remainder below the large size classes goes to the exact size lists
+    unsigned o4 = a.allocate(8 * 130);
+    ENSURE(o4 == big);
+    unsigned o5 = a.allocate(8 * 70);
+    ENSURE(o5 == big + 130);
+    ENSURE(a.get_allocation_size() == 8 * (10 + 150 + 130 + 70));
+}
+
+static void tst_classes() {
+    sat_arena a("test");
+    unsigned_vector offs;
+    for (unsigned i = 0; i < 100; ++i)
+        offs.push_back(a.allocate(8 * 1000));
+    for (unsigned off : offs)
+        a.deallocate(8 * 1000, off);
+    // every request of at most 1000 slots is served from a freed block
+    unsigned top = a.allocate(8 * 1);
+    for (unsigned i = 0; i < 100; ++i) {
+        unsigned off = a.allocate(8 * (128 + 7 * i));
+        ENSURE(off < top);
+    }
+}
+
+// freed neighbours are merged once a page is full
+static void tst_coalesce() {
+    sat_arena a("test");
+    unsigned const page_slots = 1u << 17;
+    unsigned_vector offs;
+    for (unsigned i = 0; i < page_slots / 64; ++i)
+        offs.push_back(a.allocate(8 * 64));
+    for (unsigned off : offs)
+        a.deallocate(8 * 64, off);
+    // no free list holds a block of 1000 slots, the merged page does
+    unsigned off = a.allocate(8 * 1000);
+    ENSURE(off == offs[0]);
+    unsigned off2 = a.allocate(8 * 64);
+    ENSURE(off2 == off + 1000);
+}
+
+// offsets are recovered from addresses, also for objects on dedicated pages
+static void tst_offsets() {
+    sat_arena a("test");
+    unsigned_vector offs;
+    for (unsigned i = 0; i < 5000; ++i)
+        offs.push_back(a.allocate(8 * (3 + i % 200)));
+    offs.push_back(a.allocate(8 * ((1u << 17) + 5)));
+    offs.push_back(a.allocate(8 * 3));
+    for (unsigned off : offs)
+        ENSURE(a.get_offset(a.get(off)) == off);
+}
+
+void tst_sat_arena() {
+    tst_split();
+    tst_classes();
+    tst_coalesce();
+    tst_offsets();
+}
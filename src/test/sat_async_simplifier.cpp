@@ -0,0 +1,70 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_async_simplifier.cpp
+
+Abstract:
+
+    Tests for inprocessing on a helper thread (sat.inprocess.async).
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "util/statistics.h"
+#include "util/util.h"
+
+static lbool solve(vector<sat::literal_vector> const& clauses, unsigned num_vars, bool async, statistics& st) {
+    params_ref p;
+    p.set_bool("inprocess.async", async);
+    reslimit lim;
+    sat::solver s(p, lim);
+    for (unsigned i = 0; i < num_vars; ++i)
+        s.mk_var();
+    for (auto const& c : clauses)
+        s.mk_clause(c.size(), c.data());
+    lbool r = s.check();
+    if (r == l_true) {
+        for (auto const& c : clauses) {
+            bool sat = false;
+            for (sat::literal l : c)
+                sat |= s.get_model()[l.var()] == (l.sign() ? l_false : l_true);
+            ENSURE(sat);
+        }
+    }
+    s.collect_statistics(st);
+    return r;
+}
+
+void tst_sat_async_simplifier() {
+    // random 3-SAT near the threshold, both satisfiable and unsatisfiable instances,
+    // with and gates over the problem variables that variable elimination removes.
+    random_gen rand(7);
+    unsigned const num_vars = 150, num_gates = 20;
+    statistics st;
+    for (unsigned round = 0; round < 8; ++round) {
+        vector<sat::literal_vector> clauses;
+        for (unsigned i = 0; i < 640; ++i) {
+            sat::literal_vector c;
+            for (unsigned j = 0; j < 3; ++j)
+                c.push_back(sat::literal(rand(num_vars), rand(2) == 0));
+            clauses.push_back(c);
+        }
+        for (unsigned i = 0; i < num_gates; ++i) {
+            sat::literal g(num_vars + i, false), a(rand(num_vars), false), b(rand(num_vars), true);
+            sat::literal_vector c1, c2, c3;
+            c1.push_back(~g, a);
+            c2.push_back(~g, b);
+            c3.push_back(g, ~a, ~b);
+            clauses.push_back(c1, c2, c3);
+        }
+        statistics ignore;
+        lbool expected = solve(clauses, num_vars + num_gates, false, ignore);
+        ENSURE(expected != l_undef);
+        ENSURE(solve(clauses, num_vars + num_gates, true, st) == expected);
+    }
+    ENSURE(st.get_uint("sat async simplify rounds") > 0);
+    // variable elimination keeps running inline next to the helper thread
+    ENSURE(st.get_uint("sat elim bool vars res") + st.get_uint("sat elim bool vars bdd") > 0);
+}
@@ -0,0 +1,102 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_proof_trim.cpp
+
+Abstract:
+
+    Tests for trimming and checking clausal proofs.
+
+--*/
+
+#include "sat/sat_proof_trim.h"
+#include "sat/dimacs.h"
+#include <iostream>
+#include <sstream>
+
+static void read_proof(sat::proof_trim& trim, char const* text) {
+    std::istringstream in(text);
+    dimacs::drat_parser drat(in, std::cerr);
+    unsigned num_inputs = 0, num_lemmas = 0;
+    ENSURE(trim.read_drat(drat, num_inputs, num_lemmas));
+}
+
+// the segments of the threads start after deletions and after the unit lemma
+static void tst_parallel() {
+    char const* text =
+        "p cnf 4 5\n"
+        "i 1 2 0\n"
+        "i 1 -2 0\n"
+        "i -1 2 0\n"
+        "i -1 -2 0\n"
+        "i 3 4 0\n"
+        "d 3 4 0\n"
+        "1 3 4 0\n"
+        "1 0\n"
+        "d 1 2 0\n"
+        "d 1 -2 0\n"
+        "0\n";
+    params_ref p;
+    reslimit lim;
+    sat::proof_trim trim(p, lim);
+    read_proof(trim, text);
+    auto expected = trim.trim();
+    for (unsigned num_threads = 1; num_threads <= 6; ++num_threads) {
+        sat::proof_trim trim(p, lim);
+        read_proof(trim, text);
+        auto proof = trim.trim(num_threads);
+        ENSURE(proof.size() == expected.size());
+        for (unsigned i = 0; i < proof.size(); ++i)
+            ENSURE(proof[i].first == expected[i].first);
+        ENSURE(trim.check(proof) == 0);
+    }
+
+    // a lemma that does not follow is reported by check
+    sat::proof_trim trim2(p, lim);
+    read_proof(trim2, "p cnf 2 2\ni 1 2 0\ni -1 -2 0\n1 0\n-2 0\n0\n");
+    auto proof = trim2.trim(2);
+    ENSURE(trim2.check(proof) > 0);
+}
+
+void tst_sat_proof_trim() {
+    tst_parallel();
+
+    params_ref p;
+    reslimit lim;
+    sat::proof_trim trim(p, lim);
+    // the lemma 1 3 4 is not needed for the empty clause, and neither is the input 3 4
+    std::istringstream in(
+        "p cnf 4 5\n"
+        "i 1 2 0\n"
+        "i 1 -2 0\n"
+        "i -1 2 0\n"
+        "i -1 -2 0\n"
+        "i 3 4 0\n"
+        "1 3 4 0\n"
+        "1 0\n"
+        "0\n");
+    dimacs::drat_parser drat(in, std::cerr);
+    unsigned num_inputs = 0, num_lemmas = 0;
+    ENSURE(trim.read_drat(drat, num_inputs, num_lemmas));
+    ENSURE(num_inputs == 5 && num_lemmas == 3);
+
+    auto proof = trim.trim();
+    ENSURE(!proof.empty());
+    ENSURE(proof.back().first == sat::proof_trim::lemma_id_base + 2);
+    for (auto const& [id, deps] : proof)
+        ENSURE(id != sat::proof_trim::lemma_id_base && id != 5);
+    ENSURE(trim.check(proof) == 0);
+
+    // literals keep the numbering of the proof, hints refer to input clauses and earlier lemmas
+    std::ostringstream strm;
+    trim.display_lrat(strm, proof, num_inputs);
+    ENSURE(strm.str() == "6 1 0 2 1 0\n7 0 6 4 3 0\n");
+
+    // dropping the dependencies of a lemma makes it fail
+    for (auto& [id, deps] : proof)
+        if (id == sat::proof_trim::lemma_id_base + 1)
+            deps.reset();
+    ENSURE(trim.check(proof) == 1);
+}
@@ -0,0 +1,56 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_sim_sweep.cpp
+
+Abstract:
+
+    Tests for simulation based equivalence detection in the SAT solver.
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "sat/sat_sim_sweep.h"
+#include "util/statistics.h"
+
+// head == a & b
+static void mk_and(sat::solver& s, sat::literal head, sat::literal a, sat::literal b) {
+    s.mk_clause(~head, a);
+    s.mk_clause(~head, b);
+    s.mk_clause(head, ~a, ~b);
+}
+
+void tst_sat_sim_sweep() {
+    params_ref p;
+    reslimit lim;
+    sat::solver s(p, lim);
+    auto mk = [&]() { return sat::literal(s.mk_var(), false); };
+    sat::literal a = mk(), b = mk(), c = mk();
+    sat::literal x = mk(), y = mk(), w = mk(), z = mk(), u = mk(), k = mk();
+    mk_and(s, x, a, b);
+    mk_and(s, y, b, a);    // y == x
+    mk_and(s, w, b, c);
+    mk_and(s, z, a, w);    // z == a & b & c
+    mk_and(s, u, x, c);    // u == z
+    mk_and(s, k, x, ~b);   // k == false
+    s.mk_clause(a, c, ~u);
+
+    sat::sim_sweep sweep(s, 1000);
+    sweep();
+    statistics st;
+    sweep.collect_statistics(st);
+    ENSURE(st.get_uint("sat-sim.gates") >= 6);
+    ENSURE(st.get_uint("sat-sim.eqs") >= 2);
+    ENSURE(st.get_uint("sat-sim.units") >= 1);
+    ENSURE(s.value(k) == l_false);
+    ENSURE(s.check() == l_true);
+
+    auto val = [&](sat::literal l) { return s.get_model()[l.var()] == (l.sign() ? l_false : l_true); };
+    ENSURE(val(x) == (val(a) && val(b)));
+    ENSURE(val(y) == val(x));
+    ENSURE(val(u) == (val(a) && val(b) && val(c)));
+    ENSURE(val(z) == val(u));
+    ENSURE(!val(k));
+}
@@ -60,5 +60,19 @@ void tst_simple_parser() {
     TRACE(simple_parser, 
           tout << mk_pp(r, m) << "\n";
           tout << "val: " << eval(r, 2, vals) << "\n";);
+    // the compiled cost functions agree with the evaluator
+    char const * fs[] = { "(+ x (* y x) x)", "(ite (and (> x 3) (<= y 4)) 2 10)", "(ite (or (> x 3) (<= y 4)) 2 10)",
+                          "(- (/ x 2) y)", "(ite (implies (< x y) (= x 1)) (- 0 x) (* y 3))", "(ite (not (>= x y)) x y)",
+                          "(ite (xor (> x 1) (> y 1)) (+ x 1) (and (> y x) (or (= x 0) (< y 2))))" };
+    cost_evaluator::program prog;
+    for (char const * f : fs) {
+        VERIFY(p.parse_string(f, r));
+        eval.compile(r, prog);
+        for (float x : { 0.0f, 1.0f, 2.5f, 4.0f })
+            for (float y : { 0.0f, 1.0f, 4.0f, 7.0f }) {
+                float args[2] = { y, x };
+                VERIFY(eval(r, 2, args) == eval(prog, 2, args));
+            }
+    }
 }
 
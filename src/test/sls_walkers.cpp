@@ -0,0 +1,57 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sls_walkers.cpp
+
+Abstract:
+
+    Tests for the portfolio of SLS walkers next to the SMT engine.
+
+--*/
+
+#include "smt/smt_context.h"
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "util/statistics.h"
+#include <sstream>
+
+// several sls walkers run next to the SMT engine and receive its values on backtracking.
+static void tst_walkers(ast_manager& m) {
+    unsigned const n = 20;
+    std::ostringstream script;
+    for (unsigned i = 0; i < n; ++i)
+        script << "(declare-const q" << i << " Int)\n(assert (and (<= 0 q" << i << ") (< q" << i << " " << n << ")))\n";
+    for (unsigned i = 0; i < n; ++i)
+        for (unsigned j = i + 1; j < n; ++j)
+            script << "(assert (not (= q" << i << " q" << j << ")))\n"
+                   << "(assert (not (= (- q" << i << " q" << j << ") " << j - i << ")))\n"
+                   << "(assert (not (= (- q" << j << " q" << i << ") " << j - i << ")))\n";
+    cmd_context cmd(false, &m);
+    std::istringstream is(script.str());
+    VERIFY(parse_smt2_commands(cmd, is));
+    smt_params ps;
+    ps.m_sls_enable = true;
+    ps.m_sls_threads = 3;
+    smt::context ctx(m, ps);
+    ctx.set_logic(symbol("QF_LIA"));
+    for (expr* a : cmd.assertions())
+        ctx.assert_expr(a);
+    VERIFY(l_true == ctx.check());
+    model_ref mdl;
+    ctx.get_model(mdl);
+    VERIFY(mdl);
+    for (expr* a : cmd.assertions())
+        VERIFY(mdl->is_true(a));
+    statistics st;
+    ctx.collect_statistics(st);
+    VERIFY(st.get_uint("sls-num-walker-values") > 0);
+}
+
+void tst_sls_walkers() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    tst_walkers(m);
+}
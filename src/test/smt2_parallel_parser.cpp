@@ -0,0 +1,68 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    smt2_parallel_parser.cpp
+
+Abstract:
+
+    Tests for parsing runs of SMT-LIB2 assertions on several threads.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include <sstream>
+
+// parsing assertions on several threads yields the same assertions in the same order.
+static void tst_parallel_assertions(ast_manager& m) {
+    std::ostringstream script;
+    script << "(set-logic ALL)\n(declare-sort U 0)\n(declare-fun f (U Int) Int)\n(declare-const u U)\n"
+           << "(declare-const |x)| Int)\n(define-fun g ((x Int)) Int (+ x 1))\n; comment with a )\n#| block ) comment |#\n"
+           << "(define-sort I () Int)\n(declare-fun h (I) I)\n(define-const c I 3)\n";
+    for (unsigned i = 0; i < 3000; ++i) {
+        if (i == 1500)
+            script << "(declare-const z Int)\n";
+        script << "(assert (or (> (f u " << i << ") (g |x)|)) (= (str.len \")\"\"(\") " << i << ") (> (h c) " << i << ")";
+        if (i >= 1500)
+            script << " (< z " << i << ")";
+        script << "))\n";
+    }
+    cmd_context seq(false, &m), par(false, &m);
+    params_ref p;
+    p.set_uint("threads", 4);
+    std::istringstream is1(script.str()), is2(script.str());
+    VERIFY(parse_smt2_commands(seq, is1));
+    std::ostringstream verbose;
+    unsigned lvl = get_verbosity_level();
+    set_verbosity_level(2);
+    set_verbose_stream(verbose);
+    VERIFY(parse_smt2_commands(par, is2, false, p));
+    set_verbose_stream(std::cerr);
+    set_verbosity_level(lvl);
+    // both runs of 1500 assertions are split between two workers, also on a single core.
+    std::string log = verbose.str(), run = ":parallel-assertions 1500 :threads 2)";
+    VERIFY(log.find(run) != std::string::npos && log.find(run) != log.rfind(run));
+    VERIFY(seq.assertions().size() == 3000);
+    VERIFY(seq.assertions() == par.assertions());
+
+    // an error inside a run of assertions is reported by the main parser.
+    std::string bad = script.str();
+    bad.insert(bad.find("(assert (or (> (f u 2000)"), "(assert (> undefined 0))\n");
+    std::istringstream is3(bad);
+    cmd_context err(false, &m);
+    std::ostringstream out;
+    err.set_regular_stream(out);
+    err.set_diagnostic_stream(out);
+    VERIFY(!parse_smt2_commands(err, is3, false, p));
+    VERIFY(err.assertions() == seq.assertions());
+    VERIFY(out.str().find("line 2013") != std::string::npos);
+}
+
+void tst_smt2_parallel_parser() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    tst_parallel_assertions(m);
+}
@@ -0,0 +1,69 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    smt2_streaming.cpp
+
+Abstract:
+
+    Tests for the streaming mode of the SMT-LIB2 front end.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "solver/solver.h"
+#include <sstream>
+
+// streamed assertions go to the solver and are not retained by the context.
+static void tst_streamed_assertions(ast_manager& m) {
+    cmd_context cmd(false, &m);
+    cmd.set_solver_factory(mk_smt_strategic_solver_factory());
+    params_ref p;
+    p.set_bool("streaming", true);
+    std::istringstream is(
+        "(declare-const x Int)\n"
+        "(assert (> x 2))\n"
+        "(assert (< x 4))\n"
+        "(check-sat)\n"
+        "(push)\n"
+        "(assert (distinct x 3))\n"
+        "(check-sat)\n"
+        "(pop)\n"
+        "(check-sat)\n");
+    VERIFY(parse_smt2_commands(cmd, is, false, p));
+    VERIFY(cmd.streaming());
+    VERIFY(cmd.assertions().empty());
+    VERIFY(cmd.cs_state() == cmd_context::css_sat);
+}
+
+// tactics read the retained assertions, so they are refused after streaming
+// instead of answering for an empty assertion set.
+static void tst_refuse_after_streaming(ast_manager& m) {
+    cmd_context cmd(false, &m);
+    cmd.set_solver_factory(mk_smt_strategic_solver_factory());
+    std::ostringstream out;
+    cmd.set_regular_stream(out);
+    cmd.set_diagnostic_stream(out);
+    params_ref p;
+    p.set_bool("streaming", true);
+    std::istringstream is(
+        "(declare-const x Int)\n"
+        "(assert (> x 2))\n"
+        "(assert (< x 2))\n"
+        "(check-sat-using smt)\n"
+        "(apply simplify)\n");
+    VERIFY(!parse_smt2_commands(cmd, is, false, p));
+    VERIFY(out.str().find("streamed") != std::string::npos);
+    VERIFY(out.str().rfind("sat", 0) != 0 && out.str().find("\nsat") == std::string::npos);
+    VERIFY(cmd.cs_state() != cmd_context::css_sat);
+}
+
+void tst_smt2_streaming() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    tst_streamed_assertions(m);
+    tst_refuse_after_streaming(m);
+}
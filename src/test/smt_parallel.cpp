@@ -0,0 +1,75 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    smt_parallel.cpp
+
+Abstract:
+
+    Tests for the cube and conquer search of smt::parallel with work stealing.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "solver/solver.h"
+#include "smt/smt_solver.h"
+#include "model/model.h"
+#include "util/statistics.h"
+#include <thread>
+
+// pigeons pigeons into holes holes, each hole holds at most one pigeon.
+static void mk_pigeonhole(ast_manager& m, unsigned pigeons, unsigned holes, expr_ref_vector& fmls) {
+    vector<expr_ref_vector> in;
+    for (unsigned i = 0; i < pigeons; ++i) {
+        in.push_back(expr_ref_vector(m));
+        for (unsigned j = 0; j < holes; ++j)
+            in.back().push_back(m.mk_const(symbol(("p" + std::to_string(i) + "_" + std::to_string(j)).c_str()), m.mk_bool_sort()));
+        fmls.push_back(m.mk_or(in.back()));
+    }
+    for (unsigned j = 0; j < holes; ++j)
+        for (unsigned i = 0; i < pigeons; ++i)
+            for (unsigned k = i + 1; k < pigeons; ++k)
+                fmls.push_back(m.mk_not(m.mk_and(in[i].get(j), in[k].get(j))));
+}
+
+static lbool check(ast_manager& m, expr_ref_vector const& fmls, unsigned threads, unsigned& stolen) {
+    params_ref p;
+    p.set_uint("threads", threads);
+    p.set_bool("work_stealing", true);
+    ref<solver> s = mk_smt_solver(m, p, symbol("QF_UF"));
+    for (expr* f : fmls)
+        s->assert_expr(f);
+    lbool r = s->check_sat(0, nullptr);
+    if (r == l_true) {
+        model_ref mdl;
+        s->get_model(mdl);
+        for (expr* f : fmls)
+            VERIFY(mdl->is_true(f));
+    }
+    statistics st;
+    s->collect_statistics(st);
+    stolen = st.get_uint("parallel-stolen-cubes");
+    return r;
+}
+
+void tst_smt_parallel() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    unsigned stolen = 0;
+    // the solver uses at most one thread per core.
+    bool multi_core = std::thread::hardware_concurrency() >= 2;
+
+    expr_ref_vector unsat(m);
+    mk_pigeonhole(m, 9, 8, unsat);
+    VERIFY(l_false == check(m, unsat, 1, stolen));
+    VERIFY(stolen == 0);
+    VERIFY(l_false == check(m, unsat, 2, stolen));
+    VERIFY(!multi_core || stolen > 0);
+    VERIFY(l_false == check(m, unsat, 4, stolen));
+
+    expr_ref_vector sat(m);
+    mk_pigeonhole(m, 8, 8, sat);
+    VERIFY(l_true == check(m, sat, 2, stolen));
+    VERIFY(l_true == check(m, sat, 4, stolen));
+}
@@ -459,6 +459,26 @@ public:
         return nullptr;
     }
 
+    /**
+       \brief Return an element e such that eq(e) holds, where h is the hash code
+       of the elements that satisfy eq. It is used for lookups with a key whose
+       hash code is not the one computed by HashProc.
+    */
+    template<typename Eq>
+    T * find_core(unsigned h, Eq const & eq) const {
+        cell * c = m_table + (h & (m_slots - 1));
+        if (c->is_free())
+            return nullptr;
+        do {
+            if (eq(c->m_data))
+                return &(c->m_data);
+            CHS_CODE(const_cast<chashtable*>(this)->m_collisions++;);
+            c = c->m_next;
+        }
+        while (c != nullptr);
+        return nullptr;
+    }
+
     bool find(T const & d, T & r) {
         unsigned mask = m_slots - 1;
         unsigned h    = get_hash(d);
@@ -21,6 +21,7 @@ Notes:
 #include "util/gparams.h"
 #include "util/util.h"
 #include "util/memory_manager.h"
+#include "util/profile.h"
 
 void env_params::updt_params() {
     params_ref const& p = gparams::get_ref();
@@ -33,6 +34,11 @@ void env_params::updt_params() {
     unsigned mb = p.get_uint("memory_high_watermark_mb", 0);
     if (mb > 0)
         memory::set_high_watermark(megabytes_to_bytes(mb));    
+    bool prof = p.get_bool("profile", false);
+    if (prof && !profile::enabled())
+        profile::enable(p.get_str("profile_file", "z3_profile.json"), p.get_uint("profile_max_events", 1000000));
+    else if (!prof && profile::enabled())
+        profile::disable();
 }
 
 void env_params::collect_param_descrs(param_descrs & d) {
@@ -43,4 +49,7 @@ void env_params::collect_param_descrs(param_descrs & d) {
     d.insert("memory_max_alloc_count", CPK_UINT, "set hard upper limit for memory allocations, if 0 then there is no limit", "0");
     d.insert("memory_high_watermark", CPK_UINT, "set high watermark for memory consumption (in bytes), if 0 then there is no limit", "0");
     d.insert("memory_high_watermark_mb", CPK_UINT, "set high watermark for memory consumption (in megabytes), if 0 then there is no limit", "0");
+    d.insert("profile", CPK_BOOL, "record the time spent in hot paths; requires a build with Z3_ENABLE_PROFILING", "false");
+    d.insert("profile_file", CPK_STRING, "file that receives the profile in Chrome trace format when profiling stops", "z3_profile.json");
+    d.insert("profile_max_events", CPK_UINT, "maximal number of trace events recorded per thread; later events only update the totals", "1000000");
 }
@@ -20,6 +20,7 @@ Revision History:
 
 #include "util/mpz.h"
 #include "util/trace.h"
+#include <numeric>
 
 class mpq {
     mpz m_num;
@@ -72,6 +73,47 @@ class mpq_manager : public mpz_manager<SYNCH> {
         }
     }
 
+    /*
+      Fast paths for numbers whose numerator and denominator are small.
+      The numerators and denominators of small numbers fit in 32 bits, so
+      the cross products and their sums computed below fit in 64 bits and
+      cannot overflow. The result is normalized with a machine gcd.
+    */
+
+    static int64_t small_num(mpq const & a) { return a.m_num.value(); }
+
+    static int64_t small_den(mpq const & a) { return a.m_den.value(); }
+
+    /**
+       \brief c <- n/d for d > 0.
+    */
+    void set_small_rat(mpq & c, int64_t n, int64_t d) {
+        SASSERT(d > 0);
+        uint64_t g = std::gcd(n < 0 ? 0 - static_cast<uint64_t>(n) : static_cast<uint64_t>(n), static_cast<uint64_t>(d));
+        if (g > 1) {
+            n /= static_cast<int64_t>(g);
+            d /= static_cast<int64_t>(g);
+        }
+        mpz_manager<SYNCH>::set(c.m_num, n);
+        mpz_manager<SYNCH>::set(c.m_den, d);
+    }
+
+    void small_add(mpq const & a, mpq const & b, mpq & c) {
+        set_small_rat(c, small_num(a) * small_den(b) + small_num(b) * small_den(a), small_den(a) * small_den(b));
+    }
+
+    void small_sub(mpq const & a, mpq const & b, mpq & c) {
+        set_small_rat(c, small_num(a) * small_den(b) - small_num(b) * small_den(a), small_den(a) * small_den(b));
+    }
+
+    void small_mul(mpq const & a, mpq const & b, mpq & c) {
+        set_small_rat(c, small_num(a) * small_num(b), small_den(a) * small_den(b));
+    }
+
+    static bool small_lt(mpq const & a, mpq const & b) {
+        return small_num(a) * small_den(b) < small_num(b) * small_den(a);
+    }
+
     void rat_add(mpq const & a, mpq const & b, mpq & c);
 
     void rat_add(mpq const & a, mpz const & b, mpq & c) {
@@ -240,6 +282,9 @@ public:
             mpz_manager<SYNCH>::add(a.m_num, b.m_num, c.m_num);
             reset_denominator(c);
         }
+        else if (is_small(a) && is_small(b)) {
+            small_add(a, b, c);
+        }
         else {
             rat_add(a, b, c);
         }
@@ -272,6 +317,8 @@ public:
             mpz_manager<SYNCH>::sub(a.m_num, b.m_num, c.m_num);
             reset_denominator(c);
         }
+        else if (is_small(a) && is_small(b))
+            small_sub(a, b, c);
         else
             rat_sub(a, b, c);
         STRACE(mpq, tout << to_string(c) << "\n";);
@@ -298,6 +345,8 @@ public:
             mpz_manager<SYNCH>::mul(a.m_num, b.m_num, c.m_num);
             reset_denominator(c);
         }
+        else if (is_small(a) && is_small(b))
+            small_mul(a, b, c);
         else
             rat_mul(a, b, c);
         STRACE(mpq, tout << to_string(c) << "\n";);
@@ -576,6 +625,8 @@ public:
     bool lt(mpq const & a, mpq const & b) {
         if (is_int(a) && is_int(b))
             return lt(a.m_num, b.m_num);
+        else if (is_small(a) && is_small(b))
+            return small_lt(a, b);
         else
             return rat_lt(a, b);
     }
@@ -0,0 +1,246 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    profile.cpp
+
+Abstract:
+
+    Scoped timers and counters for hot paths.
+
+    Every thread records into its own buffer, so recording does not take
+    locks. The buffers are owned by a global list and survive the thread,
+    which lets the trace include worker threads that already finished.
+    Writing or resetting the data while other threads record is not
+    synchronized.
+
+--*/
+#include "util/profile.h"
+#include "util/mutex.h"
+#include "util/warning.h"
+#include "util/util.h"
+#include "util/trace.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace profile {
+
+    std::atomic<bool> g_enabled(false);
+
+    namespace {
+
+        struct totals {
+            uint64_t        m_calls = 0;
+            clock::duration m_time = clock::duration::zero();
+            uint64_t        m_count = 0;
+        };
+
+        struct event {
+            unsigned          m_site;
+            clock::time_point m_start;
+            clock::duration   m_duration;
+        };
+
+        struct thread_data {
+            unsigned            m_tid;
+            std::vector<totals> m_totals;
+            std::vector<event>  m_events;
+            thread_data(unsigned tid): m_tid(tid) {}
+
+            totals & get(unsigned site) {
+                if (site >= m_totals.size())
+                    m_totals.resize(site + 1);
+                return m_totals[site];
+            }
+        };
+
+        struct state;
+        void write_file(state & s);
+
+        struct state {
+            mutex                                     m_lock;
+            std::vector<char const *>                 m_site_names;
+            std::vector<std::unique_ptr<thread_data>> m_threads;
+            std::string                               m_file;
+            unsigned                                  m_max_events = 0;
+            clock::time_point                         m_origin;
+
+            ~state() {
+                if (enabled()) {
+                    g_enabled = false;
+                    write_file(*this);
+                }
+            }
+        };
+
+        state & get_state() {
+            static state s;
+            return s;
+        }
+
+        thread_local thread_data * t_data = nullptr;
+
+        thread_data & get_thread_data() {
+            if (!t_data) {
+                state & s = get_state();
+                lock_guard lock(s.m_lock);
+                s.m_threads.push_back(std::make_unique<thread_data>(static_cast<unsigned>(s.m_threads.size())));
+                t_data = s.m_threads.back().get();
+            }
+            return *t_data;
+        }
+
+        void display_name(std::ostream & out, char const * name) {
+            out << '"';
+            for (char const * c = name; *c; ++c) {
+                if (*c == '"' || *c == '\\')
+                    out << '\\';
+                out << *c;
+            }
+            out << '"';
+        }
+
+        double to_us(clock::duration d) {
+            return std::chrono::duration<double, std::micro>(d).count();
+        }
+
+        /**
+           \brief Totals summed over threads and over sites with the same name.
+        */
+        void collect_totals(state & s, std::vector<std::pair<std::string, totals>> & result) {
+            for (unsigned id = 0; id < s.m_site_names.size(); ++id) {
+                totals t;
+                for (auto const & td : s.m_threads) {
+                    if (id >= td->m_totals.size())
+                        continue;
+                    totals const & t1 = td->m_totals[id];
+                    t.m_calls += t1.m_calls;
+                    t.m_time  += t1.m_time;
+                    t.m_count += t1.m_count;
+                }
+                if (t.m_calls == 0 && t.m_count == 0)
+                    continue;
+                auto it = std::find_if(result.begin(), result.end(), [&](auto const & e) { return e.first == s.m_site_names[id]; });
+                if (it == result.end())
+                    result.push_back({ std::string(s.m_site_names[id]), t });
+                else {
+                    it->second.m_calls += t.m_calls;
+                    it->second.m_time  += t.m_time;
+                    it->second.m_count += t.m_count;
+                }
+            }
+            std::sort(result.begin(), result.end(), [](auto const & a, auto const & b) { return a.second.m_time > b.second.m_time; });
+        }
+
+        void write_trace(state & s, std::ostream & out) {
+            lock_guard lock(s.m_lock);
+            out << std::fixed << std::setprecision(3);
+            out << "{\"traceEvents\":[\n";
+            out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"z3\"}}";
+            clock::time_point last = s.m_origin;
+            for (auto const & td : s.m_threads) {
+                for (event const & e : td->m_events) {
+                    out << ",\n{\"name\":";
+                    display_name(out, s.m_site_names[e.m_site]);
+                    out << ",\"cat\":\"z3\",\"ph\":\"X\",\"pid\":1,\"tid\":" << td->m_tid
+                        << ",\"ts\":" << to_us(e.m_start - s.m_origin) << ",\"dur\":" << to_us(e.m_duration) << "}";
+                    last = std::max(last, e.m_start + e.m_duration);
+                }
+            }
+            std::vector<std::pair<std::string, totals>> ts;
+            collect_totals(s, ts);
+            for (auto const & [name, t] : ts) {
+                out << ",\n{\"name\":";
+                display_name(out, name.c_str());
+                out << ",\"cat\":\"z3.totals\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":" << to_us(last - s.m_origin)
+                    << ",\"args\":{\"calls\":" << t.m_calls << ",\"time_ms\":" << to_us(t.m_time) / 1000.0
+                    << ",\"count\":" << t.m_count << "}}";
+            }
+            out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        }
+
+        void write_file(state & s) {
+            if (s.m_file.empty())
+                return;
+            std::ofstream out(s.m_file);
+            if (!out) {
+                warning_msg("could not open profile file '%s'", s.m_file.c_str());
+                return;
+            }
+            write_trace(s, out);
+        }
+    }
+
+    site::site(char const * name): m_name(name) {
+        state & s = get_state();
+        lock_guard lock(s.m_lock);
+        m_id = static_cast<unsigned>(s.m_site_names.size());
+        s.m_site_names.push_back(name);
+    }
+
+    void record(site const & s, clock::time_point start, clock::time_point stop) {
+        thread_data & td = get_thread_data();
+        totals & t = td.get(s.id());
+        t.m_calls++;
+        t.m_time += stop - start;
+        if (td.m_events.size() < get_state().m_max_events)
+            td.m_events.push_back({ s.id(), start, stop - start });
+    }
+
+    void count(site const & s, uint64_t n) {
+        get_thread_data().get(s.id()).m_count += n;
+    }
+
+    void enable(char const * file, unsigned max_events) {
+#ifndef _PROFILE
+        warning_msg("profiling probes are not compiled in; configure with -DZ3_ENABLE_PROFILING=ON");
+#endif
+        state & s = get_state();
+        s.m_file = file;
+        s.m_max_events = max_events;
+        if (!enabled())
+            s.m_origin = clock::now();
+        g_enabled = true;
+    }
+
+    void disable() {
+        if (!enabled())
+            return;
+        g_enabled = false;
+        IF_VERBOSE(1, display(verbose_stream()));
+        write_file(get_state());
+    }
+
+    void reset() {
+        state & s = get_state();
+        lock_guard lock(s.m_lock);
+        for (auto & td : s.m_threads) {
+            td->m_totals.clear();
+            td->m_events.clear();
+        }
+        s.m_origin = clock::now();
+    }
+
+    void write_trace(std::ostream & out) {
+        write_trace(get_state(), out);
+    }
+
+    void display(std::ostream & out) {
+        state & s = get_state();
+        lock_guard lock(s.m_lock);
+        std::vector<std::pair<std::string, totals>> ts;
+        collect_totals(s, ts);
+        for (auto const & [name, t] : ts) {
+            out << "(profile :site " << name << " :calls " << t.m_calls
+                << " :time " << std::fixed << std::setprecision(3) << to_us(t.m_time) / 1000000.0;
+            if (t.m_count > 0)
+                out << " :count " << t.m_count;
+            out << ")\n";
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    profile.h
+
+Abstract:
+
+    Scoped timers and counters for hot paths.
+
+    PROFILE_SCOPE(name) measures the time spent in the enclosing scope and
+    PROFILE_COUNT(name, n) adds n to a counter. Both are compiled in only
+    when _PROFILE is defined (CMake option Z3_ENABLE_PROFILING), and they
+    only record data after profiling was enabled with the global parameter
+    profile=true. A disabled probe costs one load and one branch.
+
+    Totals are kept per thread and site. The first profile_max_events
+    timed scopes of each thread are also recorded as trace events.
+    The data is written to profile_file in the Chrome trace event format
+    when profiling is disabled or the process exits. The file can be
+    loaded in chrome://tracing, Perfetto or speedscope.
+
+--*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace profile {
+
+    typedef std::chrono::steady_clock clock;
+
+    extern std::atomic<bool> g_enabled;
+
+    inline bool enabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+    /**
+       \brief Start recording. The trace is written to file when profiling
+       is disabled or the process exits. Each thread records at most
+       max_events trace events; later events only update the totals.
+    */
+    void enable(char const * file, unsigned max_events);
+
+    /**
+       \brief Stop recording and write the trace.
+    */
+    void disable();
+
+    /**
+       \brief Write the trace collected so far to out.
+    */
+    void write_trace(std::ostream & out);
+
+    /**
+       \brief Display the totals per site.
+    */
+    void display(std::ostream & out);
+
+    /**
+       \brief Discard all collected data.
+    */
+    void reset();
+
+    /**
+       \brief A static location in the code that is timed or counted.
+    */
+    class site {
+        char const * m_name;
+        unsigned     m_id;
+    public:
+        site(char const * name);
+        char const * name() const { return m_name; }
+        unsigned id() const { return m_id; }
+    };
+
+    void record(site const & s, clock::time_point start, clock::time_point stop);
+    void count(site const & s, uint64_t n);
+
+    class scope {
+        site const *      m_site;
+        clock::time_point m_start;
+    public:
+        scope(site const & s): m_site(enabled() ? &s : nullptr) {
+            if (m_site)
+                m_start = clock::now();
+        }
+        ~scope() {
+            if (m_site)
+                record(*m_site, m_start, clock::now());
+        }
+    };
+}
+
+#ifdef _PROFILE
+#define PROFILE_SCOPE(NAME)                                     \
+    static profile::site _profile_site_(NAME);                  \
+    profile::scope _profile_scope_(_profile_site_)
+
+#define PROFILE_COUNT(NAME, N)                                  \
+    {                                                           \
+        static profile::site _profile_site_(NAME);              \
+        if (profile::enabled())                                 \
+            profile::count(_profile_site_, N);                  \
+    } ((void) 0)
+#else
+#define PROFILE_SCOPE(NAME) ((void) 0)
+#define PROFILE_COUNT(NAME, N) ((void) 0)
+#endif
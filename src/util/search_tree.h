@@ -516,6 +516,15 @@ namespace search_tree {
             return best.n;
         }
 
+        // Activate a specific node, for example one taken from a worker-local queue.
+        // Returns false if the node has meanwhile been closed or activated.
+        bool activate(node<Config>* n) {
+            if (!n || n->get_status() != status::open)
+                return false;
+            n->mark_new_activation();
+            return true;
+        }
+
         node<Config>* activate_root() {
             if (m_root->get_status() == status::closed)
                 return nullptr;
@@ -22,6 +22,7 @@ Notes:
 #include "util/buffer.h"
 #include "util/smt2_util.h"
 #include<iomanip>
+#include<cstring>
 
 void statistics::update(char const * key, unsigned inc) {
     if (inc != 0)
@@ -216,6 +217,14 @@ unsigned statistics::get_uint_value(unsigned idx) const {
     return m_stats[idx].second;
 }
 
+unsigned statistics::get_uint(char const * key) const {
+    unsigned r = 0;
+    for (auto const& kv : m_stats)
+        if (strcmp(kv.first, key) == 0)
+            r += kv.second;
+    return r;
+}
+
 double statistics::get_double_value(unsigned idx) const {
     SASSERT(idx < size());
     SASSERT(!is_uint(idx));
@@ -40,6 +40,8 @@ public:
     char const * get_key(unsigned idx) const;
     unsigned get_uint_value(unsigned idx) const;
     double get_double_value(unsigned idx) const;
+    // sum of the unsigned entries stored under key, 0 if there are none.
+    unsigned get_uint(char const * key) const;
 };
 
 inline std::ostream& operator<<(std::ostream& out, statistics const& st) { return st.display(out); }